@@ -665,6 +665,20 @@ BENCHMARK_F(setup_delayed_rlnc_throughput2325, FullDelayedRLNC, Prime2325, 5)
    run_benchmark();
 }
 
+//------------------------------------------------------------------
+// Shallow FullM4RIRLNC
+//------------------------------------------------------------------
+
+typedef throughput_benchmark<
+   kodo::shallow_full_rlnc_encoder<fifi::binary>,
+   kodo::shallow_full_m4ri_rlnc_decoder<fifi::binary> >
+   setup_m4ri_rlnc_throughput;
+
+BENCHMARK_F(setup_m4ri_rlnc_throughput, FullM4RIRLNC, Binary, 5)
+{
+   run_benchmark();
+}
+
 //------------------------------------------------------------------
 // Shallow SparseFullRLNC
 //------------------------------------------------------------------
@@ -9,14 +9,15 @@
 
 #include <boost/shared_ptr.hpp>
 
-#include <sak/aligned_allocator.hpp>
 #include <sak/is_aligned.hpp>
 
+#include "coder_arena.hpp"
+
 namespace kodo
 {
     /// @brief Helper layer for layers that require a buffer for storing
-    ///        symbol coefficients. The storage is uninitialized. The
-    ///        buffer is guaranteed to be aligned (on a 16 byte boundary).
+    ///        symbol coefficients. The buffer is guaranteed to be
+    ///        aligned (on a coder_arena::vector_alignment byte boundary).
     template<class SuperCoder>
     class aligned_coefficients_buffer : public SuperCoder
     {
@@ -31,24 +32,35 @@ namespace kodo
 
     public:
 
+        /// Constructor
+        aligned_coefficients_buffer()
+            : m_coefficients(0)
+        { }
+
+        /// @copydoc layer::layout(Factory&,coder_arena&)
+        template<class Factory>
+        void layout(Factory &the_factory, coder_arena &arena)
+        {
+            SuperCoder::layout(the_factory, arena);
+
+            m_coefficients = arena.allocate<uint8_t>(
+                the_factory.max_coefficient_vector_size(),
+                coder_arena::vector_alignment);
+        }
+
         /// @copydoc layer::construct(Factory&)
         template<class Factory>
         void construct(Factory &the_factory)
         {
             SuperCoder::construct(the_factory);
-            m_coefficients.resize(the_factory.max_coefficient_vector_size());
+
+            assert(m_coefficients != 0);
         }
 
     protected:
 
-        /// The storage type
-        typedef std::vector<uint8_t, sak::aligned_allocator<uint8_t> >
-            aligned_vector;
-
         /// Temp symbol id (with aligned memory)
-        aligned_vector m_coefficients;
+        uint8_t* m_coefficients;
 
     };
 }
-
-
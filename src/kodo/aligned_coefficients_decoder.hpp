@@ -42,11 +42,34 @@ namespace kodo
                 uint32_t coefficients_size = Super::coefficient_vector_size();
 
                 auto src = sak::storage(coefficients, coefficients_size);
-                auto dest = sak::storage(m_coefficients);
+                auto dest = sak::storage(m_coefficients, coefficients_size);
 
                 sak::copy_storage(dest, src);
 
-                Super::decode_symbol(symbol_data, &m_coefficients[0]);
+                Super::decode_symbol(symbol_data, m_coefficients);
+            }
+            else
+            {
+                Super::decode_symbol(symbol_data, coefficients);
+            }
+        }
+
+        /// @copydoc layer::decode_symbol(const uint8_t*,uint8_t*)
+        void decode_symbol(const uint8_t *symbol_data, uint8_t *coefficients)
+        {
+            assert(symbol_data != 0);
+            assert(coefficients != 0);
+
+            if(sak::is_aligned(coefficients) == false)
+            {
+                uint32_t coefficients_size = Super::coefficient_vector_size();
+
+                auto src = sak::storage(coefficients, coefficients_size);
+                auto dest = sak::storage(m_coefficients, coefficients_size);
+
+                sak::copy_storage(dest, src);
+
+                Super::decode_symbol(symbol_data, m_coefficients);
             }
             else
             {
@@ -0,0 +1,299 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+
+#include <boost/optional.hpp>
+
+#include <fifi/fifi_utils.hpp>
+#include <fifi/is_binary.hpp>
+
+namespace kodo
+{
+
+    /// @ingroup decoder_layers
+    /// @brief Linear block decoder operating on augmented rows, where
+    ///        every row operation is a single finite field operation
+    ///        covering both the coefficients and the symbol.
+    ///
+    /// The layer requires the augmented_storage layer. An incoming
+    /// coded symbol is copied into the spare row of the storage where
+    /// it is eliminated, and once a pivot is found the spare row is
+    /// exchanged with the row at the pivot position, which avoids
+    /// copying the symbol into the storage.
+    ///
+    /// The layer should be placed on top of the
+    /// forward_linear_block_decoder or backward_linear_block_decoder
+    /// layers which provide the symbol status bookkeeping.
+    template<class SuperCoder>
+    class augmented_linear_block_decoder : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::field_type
+        typedef typename SuperCoder::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename field_type::value_type value_type;
+
+        /// Access the direction policy used by the underlying decoder
+        typedef typename SuperCoder::direction_policy direction_policy;
+
+    public:
+
+        /// @copydoc layer::decode_symbol(uint8_t*,uint8_t*)
+        void decode_symbol(uint8_t *symbol_data, uint8_t *coefficients)
+        {
+            assert(symbol_data != 0);
+            assert(coefficients != 0);
+
+            value_type *row = SuperCoder::spare_row();
+            uint8_t *row_data = reinterpret_cast<uint8_t*>(row);
+
+            std::copy_n(coefficients, SuperCoder::coefficient_vector_size(),
+                        row_data);
+
+            std::copy_n(symbol_data, SuperCoder::symbol_size(),
+                        row_data + SuperCoder::augmented_symbol_offset());
+
+            decode_row(row);
+
+            SuperCoder::update_symbol_status();
+        }
+
+        /// @copydoc layer::decode_symbol(uint8_t*,uint32_t)
+        void decode_symbol(uint8_t *symbol_data, uint32_t symbol_index)
+        {
+            assert(symbol_index < SuperCoder::symbols());
+            assert(symbol_data != 0);
+
+            if(SuperCoder::is_symbol_decoded(symbol_index))
+                return;
+
+            if(SuperCoder::is_symbol_seen(symbol_index))
+            {
+                swap_decode(symbol_data, symbol_index);
+            }
+            else
+            {
+                store_uncoded_row(symbol_data, symbol_index);
+
+                backward_substitute(
+                    SuperCoder::augmented_row(symbol_index), symbol_index);
+
+                m_maximum_pivot =
+                    direction_policy::max(symbol_index, m_maximum_pivot);
+            }
+
+            SuperCoder::update_symbol_status();
+        }
+
+    protected:
+
+        // Fetch the variables needed
+        using SuperCoder::m_maximum_pivot;
+
+    protected:
+
+        /// Eliminates the spare row and stores it if a pivot is found
+        /// @param row The spare row containing the coded symbol
+        void decode_row(value_type *row)
+        {
+            assert(row == SuperCoder::spare_row());
+
+            auto pivot_index = forward_substitute_to_pivot(row);
+
+            if(!pivot_index)
+                return;
+
+            if(!fifi::is_binary<field_type>::value)
+            {
+                value_type coefficient =
+                    SuperCoder::coefficient_value(row, *pivot_index);
+
+                assert(coefficient > 0);
+
+                SuperCoder::multiply(row, SuperCoder::invert(coefficient),
+                                     SuperCoder::augmented_row_length());
+            }
+
+            forward_substitute_from_pivot(row, *pivot_index);
+
+            backward_substitute(row, *pivot_index);
+
+            assert(SuperCoder::is_symbol_missing(*pivot_index));
+
+            // Storing the row is a pointer exchange
+            SuperCoder::swap_spare_row(*pivot_index);
+            SuperCoder::set_symbol_seen(*pivot_index);
+
+            m_maximum_pivot =
+                direction_policy::max(*pivot_index, m_maximum_pivot);
+        }
+
+        /// Handles an uncoded symbol arriving at a position where a
+        /// coded symbol is stored. The coded symbol is reduced with the
+        /// uncoded symbol and decoded again to find a new position.
+        /// @param symbol_data The uncoded symbol
+        /// @param pivot_index The index of the uncoded symbol
+        void swap_decode(const uint8_t *symbol_data, uint32_t pivot_index)
+        {
+            assert(SuperCoder::is_symbol_seen(pivot_index));
+
+            SuperCoder::set_symbol_missing(pivot_index);
+
+            // Move the coded symbol into the spare row
+            SuperCoder::swap_spare_row(pivot_index);
+
+            value_type *row = SuperCoder::spare_row();
+
+            assert(SuperCoder::coefficient_value(row, pivot_index) == 1);
+            SuperCoder::set_coefficient_value(row, pivot_index, 0U);
+
+            value_type *row_symbol = reinterpret_cast<value_type*>(
+                reinterpret_cast<uint8_t*>(row) +
+                SuperCoder::augmented_symbol_offset());
+
+            SuperCoder::subtract(row_symbol,
+                reinterpret_cast<const value_type*>(symbol_data),
+                SuperCoder::symbol_length());
+
+            // The uncoded symbol must be stored before the coded symbol
+            // is decoded, since the spare row may end up in its position
+            store_uncoded_row(symbol_data, pivot_index);
+
+            decode_row(row);
+        }
+
+        /// Stores an uncoded symbol in its row
+        /// @param symbol_data The uncoded symbol
+        /// @param pivot_index The index of the uncoded symbol
+        void store_uncoded_row(const uint8_t *symbol_data,
+                               uint32_t pivot_index)
+        {
+            assert(SuperCoder::is_symbol_missing(pivot_index));
+
+            value_type *vector =
+                SuperCoder::coefficient_vector_values(pivot_index);
+
+            std::fill_n(vector, SuperCoder::coefficient_vector_length(), 0);
+            SuperCoder::set_coefficient_value(vector, pivot_index, 1U);
+
+            std::copy_n(symbol_data, SuperCoder::symbol_size(),
+                        SuperCoder::symbol(pivot_index));
+
+            SuperCoder::set_symbol_decoded(pivot_index);
+        }
+
+        /// @copydoc bidirectional_linear_block_decoder::
+        ///          forward_substitute_to_pivot(value_type*,value_type*)
+        boost::optional<uint32_t> forward_substitute_to_pivot(value_type *row)
+        {
+            uint32_t start = direction_policy::min(0, SuperCoder::symbols()-1);
+            uint32_t end = direction_policy::max(0, SuperCoder::symbols()-1);
+
+            direction_policy p(start, end);
+
+            for(p.skip_zero_coefficients(*this, row); !p.at_end();
+                p.advance(), p.skip_zero_coefficients(*this, row))
+            {
+                uint32_t i = p.index();
+
+                value_type value = SuperCoder::coefficient_value(row, i);
+                assert(value);
+
+                if(!SuperCoder::is_symbol_pivot(i))
+                    return boost::optional<uint32_t>(i);
+
+                subtract_row(row, SuperCoder::augmented_row(i), value);
+            }
+
+            return boost::none;
+        }
+
+        /// @copydoc bidirectional_linear_block_decoder::
+        ///          forward_substitute_from_pivot(value_type*,value_type*,
+        ///                                        uint32_t)
+        void forward_substitute_from_pivot(value_type *row,
+                                           uint32_t pivot_index)
+        {
+            uint32_t end = direction_policy::max(0, SuperCoder::symbols()-1);
+
+            direction_policy p(pivot_index, end);
+
+            // Jump past the pivot_index position
+            p.advance();
+
+            for(p.skip_zero_coefficients(*this, row); !p.at_end();
+                p.advance(), p.skip_zero_coefficients(*this, row))
+            {
+                uint32_t i = p.index();
+
+                value_type value = SuperCoder::coefficient_value(row, i);
+                assert(value);
+
+                if(!SuperCoder::is_symbol_pivot(i))
+                    continue;
+
+                subtract_row(row, SuperCoder::augmented_row(i), value);
+            }
+        }
+
+        /// @copydoc bidirectional_linear_block_decoder::
+        ///          backward_substitute(const value_type*,
+        ///                              const value_type*,uint32_t)
+        void backward_substitute(const value_type *row, uint32_t pivot_index)
+        {
+            uint32_t from = direction_policy::min(0, SuperCoder::symbols()-1);
+            uint32_t to = m_maximum_pivot;
+
+            for(direction_policy p(from, to); !p.at_end(); p.advance())
+            {
+                uint32_t i = p.index();
+
+                if(i == pivot_index)
+                    continue;
+
+                if(!SuperCoder::is_symbol_seen(i))
+                    continue;
+
+                value_type *row_i = SuperCoder::augmented_row(i);
+
+                value_type value =
+                    SuperCoder::coefficient_value(row_i, pivot_index);
+
+                if(!value)
+                    continue;
+
+                subtract_row(row_i, row, value);
+            }
+        }
+
+        /// Subtracts a scaled row from another row using a single finite
+        /// field operation
+        /// @param dest The row to subtract from
+        /// @param src The row to subtract
+        /// @param value The value the source row is multiplied with
+        void subtract_row(value_type *dest, const value_type *src,
+                          value_type value)
+        {
+            if(fifi::is_binary<field_type>::value)
+            {
+                SuperCoder::subtract(
+                    dest, src, SuperCoder::augmented_row_length());
+            }
+            else
+            {
+                SuperCoder::multiply_subtract(
+                    dest, src, value, SuperCoder::augmented_row_length());
+            }
+        }
+
+    };
+
+}
@@ -0,0 +1,396 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+
+#include <sak/storage.hpp>
+
+#include <fifi/fifi_utils.hpp>
+
+#include "coder_arena.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup symbol_storage_layers
+    /// @ingroup coefficient_storage_layers
+    /// @brief Deep storage of both the coefficient vectors and the
+    ///        symbols, where every row is laid out as
+    ///        [coefficients | padding | symbol] in one buffer of the
+    ///        coder arena.
+    ///
+    /// The layer replaces both the coefficient_storage and the
+    /// deep_symbol_storage layers. Since the coefficients and the
+    /// symbol of a row are contiguous in memory, a row operation in
+    /// the decoder can be performed as a single finite field operation
+    /// covering both, see the augmented_linear_block_decoder.
+    ///
+    /// The rows are accessed through an indirection table, and one
+    /// additional spare row is allocated which decoders may use as
+    /// scratch space for an incoming symbol. A row can be exchanged
+    /// with the spare row without copying. As a consequence the
+    /// pointers returned by symbol() and coefficient_vector_data()
+    /// are only valid until the next call to swap_spare_row().
+    ///
+    /// The padding between the coefficients and the symbol is kept
+    /// zero, so that any finite field operation on a full row leaves
+    /// it unchanged.
+    template<class SuperCoder>
+    class augmented_storage : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::value_type
+        typedef typename SuperCoder::value_type value_type;
+
+    public:
+
+        /// Constructor
+        augmented_storage()
+            : m_data(0),
+              m_data_size(0),
+              m_rows(0),
+              m_spare(0),
+              m_max_rows(0),
+              m_symbol_offset(0),
+              m_row_size(0),
+              m_symbols_count(0),
+              m_symbols(0)
+        { }
+
+        /// @copydoc layer::layout(Factory&,coder_arena&)
+        template<class Factory>
+        void layout(Factory& the_factory, coder_arena& arena)
+        {
+            SuperCoder::layout(the_factory, arena);
+
+            assert(the_factory.max_coefficient_vectors() ==
+                   the_factory.max_symbols());
+
+            m_symbol_offset = static_cast<uint32_t>(coder_arena::align_size(
+                the_factory.max_coefficient_vector_size()));
+
+            m_row_size = m_symbol_offset +
+                static_cast<uint32_t>(coder_arena::align_size(
+                    the_factory.max_symbol_size()));
+
+            m_max_rows = the_factory.max_symbols();
+
+            // One additional row is the spare row
+            m_data_size = (m_max_rows + 1) * m_row_size;
+
+            m_data = arena.allocate<uint8_t>(
+                m_data_size, coder_arena::vector_alignment);
+
+            m_rows = arena.allocate<uint8_t*>(m_max_rows);
+            m_symbols = arena.allocate<bool>(m_max_rows);
+        }
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory& the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            assert(m_data != 0);
+            assert(m_rows != 0);
+            assert(m_symbols != 0);
+        }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory& the_factory)
+        {
+            SuperCoder::initialize(the_factory);
+
+            std::fill_n(m_data, m_data_size, 0);
+            std::fill_n(m_symbols, m_max_rows, false);
+
+            for(uint32_t i = 0; i < m_max_rows; ++i)
+            {
+                m_rows[i] = m_data + i * m_row_size;
+            }
+
+            m_spare = m_data + m_max_rows * m_row_size;
+
+            m_symbols_count = 0;
+        }
+
+        //------------------------------------------------------------------
+        // AUGMENTED ROW API
+        //------------------------------------------------------------------
+
+        /// @param index The index of the row
+        /// @return The row starting with the coefficient vector
+        value_type* augmented_row(uint32_t index)
+        {
+            assert(index < SuperCoder::symbols());
+            return reinterpret_cast<value_type*>(m_rows[index]);
+        }
+
+        /// @return The spare row which may be used as scratch space
+        value_type* spare_row()
+        {
+            return reinterpret_cast<value_type*>(m_spare);
+        }
+
+        /// Exchanges a row with the spare row, i.e. the content of the
+        /// spare row becomes the content of the row at the index and
+        /// vice versa.
+        /// @param index The index of the row
+        void swap_spare_row(uint32_t index)
+        {
+            assert(index < SuperCoder::symbols());
+            std::swap(m_rows[index], m_spare);
+        }
+
+        /// @return The number of value_type elements of a row which
+        ///         covers both the coefficients and the symbol
+        uint32_t augmented_row_length() const
+        {
+            return fifi::size_to_length<typename SuperCoder::field_type>(
+                m_symbol_offset + SuperCoder::symbol_size());
+        }
+
+        /// @return The offset in bytes of the symbol within a row
+        uint32_t augmented_symbol_offset() const
+        {
+            return m_symbol_offset;
+        }
+
+        //------------------------------------------------------------------
+        // COEFFICIENT STORAGE API
+        //------------------------------------------------------------------
+
+        /// @copydoc layer::coefficient_vector_data(uint32_t)
+        uint8_t* coefficient_vector_data(uint32_t index)
+        {
+            assert(index < SuperCoder::symbols());
+            return m_rows[index];
+        }
+
+        /// @copydoc layer::coefficient_vector_data(uint32_t) const
+        const uint8_t* coefficient_vector_data(uint32_t index) const
+        {
+            assert(index < SuperCoder::symbols());
+            return m_rows[index];
+        }
+
+        /// @copydoc layer::coefficient_vector_values(uint32_t)
+        value_type* coefficient_vector_values(uint32_t index)
+        {
+            return reinterpret_cast<value_type*>(
+                coefficient_vector_data(index));
+        }
+
+        /// @copydoc layer::coefficient_vector_values(uint32_t) const
+        const value_type* coefficient_vector_values(uint32_t index) const
+        {
+            return reinterpret_cast<const value_type*>(
+                coefficient_vector_data(index));
+        }
+
+        /// @copydoc layer::set_coefficient_vector_data(
+        ///              uint32_t,const sak::const_storage&)
+        void set_coefficient_vector_data(uint32_t index,
+                                         const sak::const_storage &storage)
+        {
+            assert(storage.m_size == SuperCoder::coefficient_vector_size());
+            assert(storage.m_data != 0);
+
+            auto dest = sak::storage(
+                coefficient_vector_data(index),
+                SuperCoder::coefficient_vector_size());
+
+            sak::copy_storage(dest, storage);
+        }
+
+        //------------------------------------------------------------------
+        // SYMBOL STORAGE API
+        //------------------------------------------------------------------
+
+        /// @copydoc layer::symbol(uint32_t)
+        uint8_t* symbol(uint32_t index)
+        {
+            assert(index < SuperCoder::symbols());
+            return m_rows[index] + m_symbol_offset;
+        }
+
+        /// @copydoc layer::symbol(uint32_t) const
+        const uint8_t* symbol(uint32_t index) const
+        {
+            assert(index < SuperCoder::symbols());
+            return m_rows[index] + m_symbol_offset;
+        }
+
+        /// @copydoc layer::symbol_value(uint32_t)
+        value_type* symbol_value(uint32_t index)
+        {
+            return reinterpret_cast<value_type*>(symbol(index));
+        }
+
+        /// @copydoc layer::symbol_value(uint32_t) const
+        const value_type* symbol_value(uint32_t index) const
+        {
+            return reinterpret_cast<const value_type*>(symbol(index));
+        }
+
+        /// @copydoc layer::set_symbols(const sak::const_storage&)
+        void set_symbols(const sak::const_storage &symbol_storage)
+        {
+            assert(symbol_storage.m_size > 0);
+            assert(symbol_storage.m_data != 0);
+            assert(symbol_storage.m_size <=
+                   SuperCoder::symbols() * SuperCoder::symbol_size());
+
+            auto symbols = sak::split_storage(
+                symbol_storage, SuperCoder::symbol_size());
+
+            for(uint32_t i = 0; i < symbols.size(); ++i)
+            {
+                sak::copy_storage(
+                    sak::storage(symbol(i), SuperCoder::symbol_size()),
+                    symbols[i]);
+            }
+
+            // As for the deep_symbol_storage this specifies all symbols
+            m_symbols_count = SuperCoder::symbols();
+            std::fill_n(m_symbols, SuperCoder::symbols(), true);
+        }
+
+        /// @copydoc layer::set_symbol(uint32_t, const sak::const_storage&)
+        void set_symbol(uint32_t index, const sak::const_storage &src)
+        {
+            assert(src.m_data != 0);
+            assert(src.m_size <= SuperCoder::symbol_size());
+            assert(src.m_size > 0);
+            assert(index < SuperCoder::symbols());
+
+            sak::copy_storage(
+                sak::storage(symbol(index), SuperCoder::symbol_size()), src);
+
+            if(m_symbols[index] == false)
+            {
+                ++m_symbols_count;
+                m_symbols[index] = true;
+            }
+        }
+
+        /// @copydoc layer::copy_symbols(const sak::mutable_storage&)
+        void copy_symbols(const sak::mutable_storage &dest_storage) const
+        {
+            assert(dest_storage.m_size > 0);
+            assert(dest_storage.m_data != 0);
+
+            auto symbols = sak::split_storage(
+                dest_storage, SuperCoder::symbol_size());
+
+            uint32_t count = std::min<uint32_t>(
+                symbols.size(), SuperCoder::symbols());
+
+            for(uint32_t i = 0; i < count; ++i)
+            {
+                copy_symbol(i, symbols[i]);
+            }
+        }
+
+        /// @copydoc layer::copy_symbol(uint32_t,
+        ///                             const sak::mutable_storage&)
+        void copy_symbol(uint32_t index,
+                         const sak::mutable_storage &dest) const
+        {
+            assert(dest.m_size > 0);
+            assert(dest.m_data != 0);
+
+            uint32_t data_to_copy =
+                std::min(dest.m_size, SuperCoder::symbol_size());
+
+            sak::copy_storage(dest, sak::storage(symbol(index), data_to_copy));
+        }
+
+        /// @copydoc layer::copy_into_symbols(const sak::const_storage&)
+        void copy_into_symbols(const sak::const_storage &src)
+        {
+            set_symbols(src);
+        }
+
+        /// @copydoc layer::copy_into_symbol(uint32_t,
+        ///              const sak::const_storage&)
+        void copy_into_symbol(uint32_t index, const sak::const_storage &src)
+        {
+            set_symbol(index, src);
+        }
+
+        /// @copydoc layer::symbols_available() const
+        uint32_t symbols_available() const
+        {
+            return SuperCoder::symbols();
+        }
+
+        /// @copydoc layer::symbols_initialized() const
+        uint32_t symbols_initialized() const
+        {
+            return m_symbols_count;
+        }
+
+        /// @copydoc layer::is_symbols_available() const
+        bool is_symbols_available() const
+        {
+            return true;
+        }
+
+        /// @copydoc layer::is_symbols_initialized() const
+        bool is_symbols_initialized() const
+        {
+            return m_symbols_count == SuperCoder::symbols();
+        }
+
+        /// @copydoc layer::is_symbol_available(uint32_t) const
+        bool is_symbol_available(uint32_t /*symbol_index*/) const
+        {
+            return true;
+        }
+
+        /// @copydoc layer::is_symbol_initialized(uint32_t) const
+        bool is_symbol_initialized(uint32_t symbol_index) const
+        {
+            assert(symbol_index < SuperCoder::symbols());
+            return m_symbols[symbol_index];
+        }
+
+    private:
+
+        /// The buffer holding all rows including the spare row
+        uint8_t* m_data;
+
+        /// The size in bytes of the buffer
+        uint32_t m_data_size;
+
+        /// The rows of the coding matrix
+        uint8_t** m_rows;
+
+        /// The spare row
+        uint8_t* m_spare;
+
+        /// The number of rows, not counting the spare row
+        uint32_t m_max_rows;
+
+        /// The offset of the symbol within a row
+        uint32_t m_symbol_offset;
+
+        /// The size in bytes of a row
+        uint32_t m_row_size;
+
+        /// Symbols count
+        uint32_t m_symbols_count;
+
+        /// Tracks which symbols have been set
+        bool* m_symbols;
+
+    };
+}
@@ -0,0 +1,359 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include <fifi/fifi_utils.hpp>
+#include <fifi/is_binary.hpp>
+
+#include "symbol_batch_buffer.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup decoder_layers
+    /// @brief Linear block decoder which eliminates a batch of encoded
+    ///        symbols at once.
+    ///
+    /// The bidirectional_linear_block_decoder performs a full forward
+    /// and backward pass over the stored symbols for every encoded
+    /// symbol it receives. When symbols arrive in bursts (e.g. when
+    /// reading several datagrams with a single system call) this
+    /// layer allows the whole burst to be reduced as one block: every
+    /// stored symbol is subtracted from all the symbols in the batch
+    /// before moving on to the next stored symbol, the batch is then
+    /// reduced internally, and finally the new pivots are substituted
+    /// back into the stored symbols, again in a single pass.
+    ///
+    /// Batches can either be passed directly to decode_symbols() or be
+    /// collected from the ordinary decode_symbol() calls between a
+    /// begin_batch() and end_batch() pair, which is what the
+    /// payload_decoder::decode(uint8_t**,uint32_t) function does.
+    /// Uncoded symbols are always decoded immediately.
+    ///
+    /// The layer relies on the stored coding matrix being kept in
+    /// reduced echelon form and can therefore not be combined with the
+    /// linear_block_decoder_delayed layer. It should be placed on top
+    /// of the forward_linear_block_decoder or
+    /// backward_linear_block_decoder layers.
+    template<class SuperCoder>
+    class batch_linear_block_decoder
+        : public symbol_batch_buffer<SuperCoder>
+    {
+    public:
+
+        /// Type of SuperCoder with the injected symbol_batch_buffer
+        typedef symbol_batch_buffer<SuperCoder> Super;
+
+        /// @copydoc layer::field_type
+        typedef typename Super::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename field_type::value_type value_type;
+
+        /// Access the direction policy used by the underlying decoder
+        typedef typename Super::direction_policy direction_policy;
+
+        /// Pull up the decode_symbol() functions
+        using Super::decode_symbol;
+
+    public:
+
+        /// When a batch has been started the encoded symbol is buffered
+        /// until end_batch() is called, otherwise it is decoded
+        /// immediately.
+        ///
+        /// @copydoc layer::decode_symbol(uint8_t*,uint8_t*)
+        void decode_symbol(uint8_t *symbol_data, uint8_t *coefficients)
+        {
+            assert(symbol_data != 0);
+            assert(coefficients != 0);
+
+            if(!Super::is_batch_active())
+            {
+                Super::decode_symbol(symbol_data, coefficients);
+                return;
+            }
+
+            Super::buffer_symbol(symbol_data, coefficients);
+        }
+
+        /// Decodes all encoded symbols buffered since begin_batch() was
+        /// called and stops the buffering.
+        void end_batch()
+        {
+            Super::flush_batch([this](uint8_t **symbol_data,
+                                      uint8_t **coefficients,
+                                      uint32_t count)
+                {
+                    this->decode_symbols(symbol_data, coefficients, count);
+                });
+        }
+
+        /// Decodes a number of encoded symbols as a single block. Both
+        /// the symbol data and the coefficient buffers are modified
+        /// in place.
+        /// @param symbol_data Array of pointers to the encoded symbols
+        /// @param coefficients Array of pointers to the coding
+        ///        coefficients of the encoded symbols
+        /// @param count The number of encoded symbols in the batch
+        void decode_symbols(uint8_t **symbol_data, uint8_t **coefficients,
+                            uint32_t count)
+        {
+            assert(symbol_data != 0);
+            assert(coefficients != 0);
+
+            if(Super::is_complete())
+                return;
+
+            m_pivots.clear();
+            m_pivot_symbols.clear();
+            m_pivot_coefficients.clear();
+
+            // Remove the existing pivots from the batch, we pass over
+            // each stored symbol once and reduce the whole batch with it
+            substitute_stored_into_batch(symbol_data, coefficients, count);
+
+            // Reduce the batch among itself and find the new pivots
+            for(uint32_t j = 0; j < count; ++j)
+            {
+                assert(symbol_data[j] != 0);
+                assert(coefficients[j] != 0);
+
+                value_type *symbol =
+                    reinterpret_cast<value_type*>(symbol_data[j]);
+
+                value_type *vector =
+                    reinterpret_cast<value_type*>(coefficients[j]);
+
+                reduce_batch_symbol(symbol, vector);
+            }
+
+            if(m_pivots.empty())
+                return;
+
+            // Remove the new pivots from the stored symbols, once again
+            // in a single pass over the stored symbols
+            substitute_batch_into_stored();
+
+            for(uint32_t j = 0; j < m_pivots.size(); ++j)
+            {
+                Super::store_coded_symbol(
+                    m_pivot_symbols[j], m_pivot_coefficients[j],
+                    m_pivots[j]);
+
+                m_maximum_pivot =
+                    direction_policy::max(m_pivots[j], m_maximum_pivot);
+            }
+
+            Super::update_symbol_status();
+        }
+
+    protected:
+
+        // Fetch the variables needed
+        using Super::m_maximum_pivot;
+
+    protected:
+
+        /// Subtracts the stored symbols from all symbols in the batch.
+        /// Since the stored symbols are fully reduced the order in which
+        /// they are applied does not matter.
+        /// @param symbol_data Array of pointers to the encoded symbols
+        /// @param coefficients Array of pointers to the coding
+        ///        coefficients of the encoded symbols
+        /// @param count The number of encoded symbols in the batch
+        void substitute_stored_into_batch(uint8_t **symbol_data,
+                                          uint8_t **coefficients,
+                                          uint32_t count)
+        {
+            if(Super::rank() == 0)
+                return;
+
+            uint32_t start = direction_policy::min(0, Super::symbols()-1);
+            uint32_t end = m_maximum_pivot;
+
+            for(direction_policy p(start, end); !p.at_end(); p.advance())
+            {
+                uint32_t i = p.index();
+
+                if(!Super::is_symbol_pivot(i))
+                    continue;
+
+                value_type *vector_i =
+                    Super::coefficient_vector_values(i);
+
+                value_type *symbol_i =
+                    Super::symbol_value(i);
+
+                for(uint32_t j = 0; j < count; ++j)
+                {
+                    value_type *vector =
+                        reinterpret_cast<value_type*>(coefficients[j]);
+
+                    value_type value =
+                        Super::coefficient_value(vector, i);
+
+                    if(!value)
+                        continue;
+
+                    value_type *symbol =
+                        reinterpret_cast<value_type*>(symbol_data[j]);
+
+                    subtract_symbol(symbol, vector, symbol_i, vector_i, value);
+                }
+            }
+        }
+
+        /// Reduces an encoded symbol with the pivots already found in
+        /// the batch. If the symbol is innovative it is normalized and
+        /// substituted back into the previous pivots of the batch.
+        /// @param symbol_data The data of the encoded symbol
+        /// @param symbol_id The coding coefficients of the encoded symbol
+        void reduce_batch_symbol(value_type *symbol_data,
+                                 value_type *symbol_id)
+        {
+            for(uint32_t j = 0; j < m_pivots.size(); ++j)
+            {
+                value_type value =
+                    Super::coefficient_value(symbol_id, m_pivots[j]);
+
+                if(!value)
+                    continue;
+
+                subtract_symbol(symbol_data, symbol_id,
+                                m_pivot_symbols[j], m_pivot_coefficients[j],
+                                value);
+            }
+
+            // All known pivot positions are now zero so the first
+            // non-zero coefficient is the new pivot
+            boost::optional<uint32_t> pivot_index;
+
+            uint32_t start = direction_policy::min(0, Super::symbols()-1);
+            uint32_t end = direction_policy::max(0, Super::symbols()-1);
+
+            direction_policy p(start, end);
+            p.skip_zero_coefficients(*this, symbol_id);
+
+            if(!p.at_end())
+                pivot_index = p.index();
+
+            if(!pivot_index)
+                return;
+
+            assert(!Super::is_symbol_pivot(*pivot_index));
+
+            if(!fifi::is_binary<field_type>::value)
+            {
+                Super::normalize(symbol_data, symbol_id, *pivot_index);
+            }
+
+            for(uint32_t j = 0; j < m_pivots.size(); ++j)
+            {
+                value_type value = Super::coefficient_value(
+                    m_pivot_coefficients[j], *pivot_index);
+
+                if(!value)
+                    continue;
+
+                subtract_symbol(m_pivot_symbols[j], m_pivot_coefficients[j],
+                                symbol_data, symbol_id, value);
+            }
+
+            m_pivots.push_back(*pivot_index);
+            m_pivot_symbols.push_back(symbol_data);
+            m_pivot_coefficients.push_back(symbol_id);
+        }
+
+        /// Subtracts the pivots found in the batch from the stored
+        /// coded symbols.
+        void substitute_batch_into_stored()
+        {
+            if(Super::rank() == 0)
+                return;
+
+            uint32_t start = direction_policy::min(0, Super::symbols()-1);
+            uint32_t end = m_maximum_pivot;
+
+            for(direction_policy p(start, end); !p.at_end(); p.advance())
+            {
+                uint32_t i = p.index();
+
+                // Decoded symbols have no non-zero elements outside
+                // their pivot position
+                if(!Super::is_symbol_seen(i))
+                    continue;
+
+                value_type *vector_i =
+                    Super::coefficient_vector_values(i);
+
+                value_type *symbol_i =
+                    Super::symbol_value(i);
+
+                for(uint32_t j = 0; j < m_pivots.size(); ++j)
+                {
+                    value_type value =
+                        Super::coefficient_value(vector_i, m_pivots[j]);
+
+                    if(!value)
+                        continue;
+
+                    subtract_symbol(symbol_i, vector_i,
+                                    m_pivot_symbols[j],
+                                    m_pivot_coefficients[j], value);
+                }
+            }
+        }
+
+        /// Subtracts a scaled source symbol and its coefficients from
+        /// the destination symbol and coefficients.
+        /// @param dest_data The data of the destination symbol
+        /// @param dest_id The coefficients of the destination symbol
+        /// @param src_data The data of the source symbol
+        /// @param src_id The coefficients of the source symbol
+        /// @param value The coefficient the source is multiplied with
+        void subtract_symbol(value_type *dest_data, value_type *dest_id,
+                             const value_type *src_data,
+                             const value_type *src_id,
+                             value_type value)
+        {
+            if(fifi::is_binary<field_type>::value)
+            {
+                Super::subtract(dest_id, src_id,
+                    Super::coefficient_vector_length());
+
+                Super::subtract(dest_data, src_data,
+                    Super::symbol_length());
+            }
+            else
+            {
+                Super::multiply_subtract(dest_id, src_id, value,
+                    Super::coefficient_vector_length());
+
+                Super::multiply_subtract(dest_data, src_data, value,
+                    Super::symbol_length());
+            }
+        }
+
+    protected:
+
+        /// The pivot positions found in the current batch
+        std::vector<uint32_t> m_pivots;
+
+        /// The symbol data belonging to each pivot in the current batch
+        std::vector<value_type*> m_pivot_symbols;
+
+        /// The coefficients belonging to each pivot in the current batch
+        std::vector<value_type*> m_pivot_coefficients;
+
+    };
+
+}
@@ -0,0 +1,227 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+#include <fifi/fifi_utils.hpp>
+
+#include "coder_arena.hpp"
+#include "symbol_batch_buffer.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup encoder_layers
+    /// @brief Linear block encoder which produces a batch of encoded
+    ///        symbols in a single pass over the source symbols.
+    ///
+    /// The linear_block_encoder reads every source symbol selected by
+    /// the coefficients for every encoded symbol it produces, so for
+    /// blocks larger than the cache the whole block is streamed from
+    /// memory once per encoded symbol. This layer computes a batch of
+    /// encoded symbols as a matrix product, one tile of the symbols at
+    /// a time. The tile size is chosen such that the tiles of all
+    /// source symbols fit in the cache, which means that every source
+    /// tile is loaded from memory once per batch and then reused for
+    /// all the encoded symbols.
+    ///
+    /// Batches can either be passed directly to encode_symbols() or be
+    /// collected from the ordinary encode_symbol() calls between a
+    /// begin_batch() and end_batch() pair, which is what the
+    /// payload_encoder::encode(uint8_t**,uint32_t*,uint32_t) function
+    /// does. Uncoded symbols are always copied immediately.
+    ///
+    /// The encoded symbols are accumulated into the symbol data, which
+    /// therefore must be zero initialized. The layer should be placed
+    /// below the zero_symbol_encoder and on top of the
+    /// linear_block_encoder.
+    template<class SuperCoder>
+    class batch_linear_block_encoder
+        : public symbol_batch_buffer<SuperCoder>
+    {
+    public:
+
+        /// Type of SuperCoder with the injected symbol_batch_buffer
+        typedef symbol_batch_buffer<SuperCoder> Super;
+
+        /// @copydoc layer::field_type
+        typedef typename Super::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename Super::value_type value_type;
+
+        /// Pull up the encode_symbol() functions
+        using Super::encode_symbol;
+
+        /// The amount of source symbol data in bytes processed per tile
+        static const uint32_t cache_size = 262144;
+
+        /// The minimum size of a tile in bytes
+        static const uint32_t minimum_tile_size = 256;
+
+    public:
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory& the_factory)
+        {
+            Super::construct(the_factory);
+
+            m_sources.reserve(the_factory.max_symbols());
+        }
+
+        /// When a batch has been started the encoded symbol is buffered
+        /// until end_batch() is called, otherwise it is encoded
+        /// immediately.
+        ///
+        /// @copydoc layer::encode_symbol(uint8_t*,uint8_t*)
+        void encode_symbol(uint8_t *symbol_data, uint8_t *coefficients)
+        {
+            assert(symbol_data != 0);
+            assert(coefficients != 0);
+
+            if(!Super::is_batch_active())
+            {
+                Super::encode_symbol(symbol_data, coefficients);
+                return;
+            }
+
+            Super::buffer_symbol(symbol_data, coefficients);
+        }
+
+        /// Encodes all symbols buffered since begin_batch() was called
+        /// and stops the buffering.
+        void end_batch()
+        {
+            Super::flush_batch([this](uint8_t **symbol_data,
+                                      uint8_t **coefficients,
+                                      uint32_t count)
+                {
+                    this->encode_symbols(symbol_data, coefficients, count);
+                });
+        }
+
+        /// Encodes a number of symbols as a single matrix product. The
+        /// encoded symbols are added to the symbol data, which should
+        /// therefore be zero initialized.
+        /// @param symbol_data Array of pointers to the destination
+        ///        buffers of the encoded symbols
+        /// @param coefficients Array of pointers to the coding
+        ///        coefficients of the encoded symbols
+        /// @param count The number of encoded symbols in the batch
+        void encode_symbols(uint8_t **symbol_data, uint8_t **coefficients,
+                            uint32_t count)
+        {
+            assert(symbol_data != 0);
+            assert(coefficients != 0);
+
+            // Collect the non-zero coefficients of every encoded symbol
+            // once, since they are used for every tile
+            m_indices.clear();
+            m_values.clear();
+            m_offsets.resize(count + 1);
+
+            for(uint32_t j = 0; j < count; ++j)
+            {
+                assert(coefficients[j] != 0);
+
+                const value_type *c =
+                    reinterpret_cast<const value_type*>(coefficients[j]);
+
+                m_offsets[j] = m_indices.size();
+
+                for(uint32_t i = 0; i < Super::symbols(); ++i)
+                {
+                    value_type value = Super::coefficient_value(c, i);
+
+                    if(!value)
+                        continue;
+
+                    // Did you forget to set the data on the encoder?
+                    assert(Super::symbol_value(i) != 0);
+
+                    assert(Super::is_symbol_pivot(i));
+
+                    m_indices.push_back(i);
+                    m_values.push_back(value);
+                }
+            }
+
+            m_offsets[count] = m_indices.size();
+
+            uint32_t symbol_length = Super::symbol_length();
+            uint32_t tile_length = fifi::size_to_length<field_type>(
+                tile_size(Super::symbols()));
+
+            for(uint32_t offset = 0; offset < symbol_length;
+                offset += tile_length)
+            {
+                uint32_t length = std::min(tile_length,
+                                           symbol_length - offset);
+
+                for(uint32_t j = 0; j < count; ++j)
+                {
+                    uint32_t first = m_offsets[j];
+                    uint32_t sources = m_offsets[j + 1] - first;
+
+                    if(sources == 0)
+                        continue;
+
+                    m_sources.resize(sources);
+
+                    for(uint32_t k = 0; k < sources; ++k)
+                    {
+                        m_sources[k] =
+                            Super::symbol_value(m_indices[first + k])
+                            + offset;
+                    }
+
+                    value_type *dest =
+                        reinterpret_cast<value_type*>(symbol_data[j]);
+
+                    Super::multiply_add_many(dest + offset,
+                        &m_sources[0], &m_values[first], sources, length);
+                }
+            }
+        }
+
+    protected:
+
+        /// @param symbols The number of source symbols
+        /// @return The size of a tile in bytes such that the tiles of
+        ///         all source symbols fit in the cache
+        static uint32_t tile_size(uint32_t symbols)
+        {
+            assert(symbols > 0);
+
+            uint32_t size = std::max(minimum_tile_size, cache_size / symbols);
+
+            // Keep the tiles aligned, the minimum tile size is a
+            // multiple of the alignment
+            return size & ~(coder_arena::vector_alignment - 1);
+        }
+
+    protected:
+
+        /// The indices of the source symbols combined in the batch
+        std::vector<uint32_t> m_indices;
+
+        /// The coefficients of the source symbols combined in the batch
+        std::vector<value_type> m_values;
+
+        /// The position in m_indices and m_values of the first source
+        /// symbol of every encoded symbol
+        std::vector<uint32_t> m_offsets;
+
+        /// The source symbol tiles combined in an encoded symbol tile
+        std::vector<const value_type*> m_sources;
+
+    };
+
+}
@@ -6,6 +6,8 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
+#include <algorithm>
 
 #include <boost/shared_ptr.hpp>
 #include <boost/noncopyable.hpp>
@@ -49,6 +51,10 @@ namespace kodo
         /// the coding coefficients
         typedef DirectionPolicy direction_policy;
 
+        /// The size in bytes of the tiles processed by the fused copy
+        /// and subtraction in subtract_pending_symbols()
+        static const uint32_t fused_tile_size = 4096;
+
     public:
 
         /// Constructor
@@ -61,6 +67,10 @@ namespace kodo
         void construct(Factory &the_factory)
         {
             SuperCoder::construct(the_factory);
+
+            m_pending_symbols.reserve(the_factory.max_symbols());
+            m_pending_coefficients.reserve(the_factory.max_symbols());
+            m_pending_tiles.reserve(the_factory.max_symbols());
         }
 
         /// @copydoc layer::initialize(Factory&)
@@ -281,7 +291,8 @@ namespace kodo
         }
 
         /// Iterates the encoding vector and subtracts existing symbols
-        /// until a pivot element is found.
+        /// until a pivot element is found. If no pivot is found the
+        /// symbol data is left untouched.
         /// @param symbol_data the data of the encoded symbol
         /// @param symbol_id the data constituting the encoding vector
         /// @return the pivot index if found.
@@ -292,35 +303,59 @@ namespace kodo
             assert(symbol_id != 0);
             assert(symbol_data != 0);
 
+            auto pivot_index =
+                forward_substitute_coefficients_to_pivot(symbol_id);
+
+            // A symbol without a pivot is not innovative and is dropped
+            // by the caller, so its data need not be updated
+            if(!pivot_index)
+                discard_pending_symbols();
+            else
+                subtract_pending_symbols(symbol_data);
+
+            return pivot_index;
+        }
+
+        /// Iterates the encoding vector and subtracts existing coefficient
+        /// vectors until a pivot element is found. The matching
+        /// subtractions of the symbol data are only recorded and must
+        /// be performed with subtract_pending_symbols() or dropped with
+        /// discard_pending_symbols().
+        /// @param symbol_id the data constituting the encoding vector
+        /// @return the pivot index if found.
+        boost::optional<uint32_t> forward_substitute_coefficients_to_pivot(
+            value_type *symbol_id)
+        {
+            assert(symbol_id != 0);
+
             uint32_t start = direction_policy::min(0, SuperCoder::symbols()-1);
             uint32_t end = direction_policy::max(0, SuperCoder::symbols()-1);
 
-            for(direction_policy p(start, end); !p.at_end(); p.advance())
+            direction_policy p(start, end);
+
+            // The zero coefficients are skipped using word scans
+            for(p.skip_zero_coefficients(*this, symbol_id); !p.at_end();
+                p.advance(), p.skip_zero_coefficients(*this, symbol_id))
             {
                 uint32_t i = p.index();
 
                 value_type current_coefficient =
                     SuperCoder::coefficient_value(symbol_id, i);
 
-                if(!current_coefficient)
-                    continue;
+                assert(current_coefficient);
 
                 if(!is_symbol_pivot(i))
+                {
                     return boost::optional<uint32_t>( i );
+                }
 
                 value_type *vector_i =
                     SuperCoder::coefficient_vector_values( i );
 
-                value_type *symbol_i =
-                    SuperCoder::symbol_value( i );
-
                 if(fifi::is_binary<field_type>::value)
                 {
                     SuperCoder::subtract(symbol_id, vector_i,
                         SuperCoder::coefficient_vector_length());
-
-                    SuperCoder::subtract(symbol_data, symbol_i,
-                        SuperCoder::symbol_length());
                 }
                 else
                 {
@@ -328,11 +363,11 @@ namespace kodo
                         symbol_id, vector_i,
                         current_coefficient,
                         SuperCoder::coefficient_vector_length());
-
-                    SuperCoder::multiply_subtract(symbol_data, symbol_i,
-                        current_coefficient, SuperCoder::symbol_length());
                 }
 
+                // The symbol data is only needed once the pivot is
+                // found, so the subtraction is deferred
+                defer_subtract_symbol(i, current_coefficient);
             }
 
             return boost::none;
@@ -370,19 +405,16 @@ namespace kodo
             // Jump past the pivot_index position
             p.advance();
 
-            for(; !p.at_end(); p.advance())
+            for(p.skip_zero_coefficients(*this, symbol_id); !p.at_end();
+                p.advance(), p.skip_zero_coefficients(*this, symbol_id))
             {
                 uint32_t i = p.index();
 
-                // Do we have a non-zero value here?
+                // We only visit the non-zero values
                 value_type value =
                     SuperCoder::coefficient_value(symbol_id, i);
 
-                if( !value )
-                {
-                    // The coefficient is zero
-                    continue;
-                }
+                assert(value);
 
                 if( !is_symbol_pivot(i) )
                 {
@@ -393,30 +425,23 @@ namespace kodo
                 value_type *vector_i =
                     SuperCoder::coefficient_vector_values(i);
 
-                value_type *symbol_i =
-                    SuperCoder::symbol_value(i);
-
                 if(fifi::is_binary<field_type>::value)
                 {
                     SuperCoder::subtract(
                         symbol_id, vector_i,
                         SuperCoder::coefficient_vector_length());
-
-                    SuperCoder::subtract(
-                        symbol_data, symbol_i,
-                        SuperCoder::symbol_length());
                 }
                 else
                 {
                     SuperCoder::multiply_subtract(
                         symbol_id, vector_i, value,
                         SuperCoder::coefficient_vector_length());
-
-                    SuperCoder::multiply_subtract(
-                        symbol_data, symbol_i, value,
-                        SuperCoder::symbol_length());
                 }
+
+                defer_subtract_symbol(i, value);
             }
+
+            subtract_pending_symbols(symbol_data);
         }
 
         /// Backward substitute the found symbol into the
@@ -500,6 +525,91 @@ namespace kodo
             }
         }
 
+        /// Records that a stored symbol multiplied with a coefficient
+        /// must be subtracted from the symbol being decoded. The
+        /// subtraction is performed by subtract_pending_symbols().
+        /// @param index The index of the stored symbol
+        /// @param coefficient The coefficient the symbol is multiplied with
+        void defer_subtract_symbol(uint32_t index, value_type coefficient)
+        {
+            m_pending_symbols.push_back(SuperCoder::symbol_value(index));
+            m_pending_coefficients.push_back(coefficient);
+        }
+
+        /// Subtracts all deferred symbols from the symbol data in a
+        /// single pass using multiply_subtract_many()
+        /// @param symbol_data The data of the symbol being decoded
+        void subtract_pending_symbols(value_type *symbol_data)
+        {
+            assert(symbol_data != 0);
+
+            if(m_pending_symbols.empty())
+                return;
+
+            SuperCoder::multiply_subtract_many(symbol_data,
+                &m_pending_symbols[0], &m_pending_coefficients[0],
+                m_pending_symbols.size(), SuperCoder::symbol_length());
+
+            m_pending_symbols.clear();
+            m_pending_coefficients.clear();
+        }
+
+        /// Writes the source symbol minus all deferred symbols to the
+        /// destination symbol. The copy is fused with the subtraction,
+        /// one tile at a time, so every tile of the destination is
+        /// written once and stays in the cache while the deferred
+        /// symbols are subtracted from it.
+        /// @param symbol_dest The destination of the result, may not
+        ///        be one of the deferred symbols
+        /// @param symbol_src The data of the symbol being decoded
+        void subtract_pending_symbols(value_type *symbol_dest,
+                                      const value_type *symbol_src)
+        {
+            assert(symbol_dest != 0);
+            assert(symbol_src != 0);
+
+            uint32_t symbol_length = SuperCoder::symbol_length();
+
+            if(m_pending_symbols.empty())
+            {
+                std::copy_n(symbol_src, symbol_length, symbol_dest);
+                return;
+            }
+
+            uint32_t tile_length =
+                fifi::size_to_length<field_type>(fused_tile_size);
+
+            m_pending_tiles.resize(m_pending_symbols.size());
+
+            for(uint32_t offset = 0; offset < symbol_length;
+                offset += tile_length)
+            {
+                uint32_t length =
+                    std::min(tile_length, symbol_length - offset);
+
+                std::copy_n(symbol_src + offset, length,
+                            symbol_dest + offset);
+
+                for(uint32_t i = 0; i < m_pending_symbols.size(); ++i)
+                    m_pending_tiles[i] = m_pending_symbols[i] + offset;
+
+                SuperCoder::multiply_subtract_many(symbol_dest + offset,
+                    &m_pending_tiles[0], &m_pending_coefficients[0],
+                    m_pending_tiles.size(), length);
+            }
+
+            m_pending_symbols.clear();
+            m_pending_coefficients.clear();
+        }
+
+        /// Drops the deferred symbols without touching any symbol data,
+        /// e.g. because the symbol being decoded was not innovative
+        void discard_pending_symbols()
+        {
+            m_pending_symbols.clear();
+            m_pending_coefficients.clear();
+        }
+
         /// Store an encoded symbol and encoding vector with the specified
         /// pivot found.
         /// @param symbol_data buffer containing the encoding symbol
@@ -519,6 +629,31 @@ namespace kodo
             assert(symbol_coefficients != 0);
             assert(symbol_data != 0);
 
+            store_coded_coefficients(symbol_coefficients, pivot_index);
+
+            // Copy it into the symbol storage
+            sak::const_storage src =
+                sak::storage(symbol_data, SuperCoder::symbol_size());
+
+            SuperCoder::copy_into_symbol(pivot_index, src);
+        }
+
+        /// Stores the encoding vector of an encoded symbol with the
+        /// specified pivot found and marks the symbol seen. The symbol
+        /// data must already be in the symbol storage or be stored by
+        /// the caller.
+        /// @param symbol_coefficients buffer containing the symbol
+        ///        coefficients
+        /// @param pivot_index the pivot index
+        void store_coded_coefficients(const value_type *symbol_coefficients,
+                                      uint32_t pivot_index)
+        {
+            assert(!SuperCoder::is_symbol_seen(pivot_index));
+            assert(!SuperCoder::is_symbol_decoded(pivot_index));
+            assert(SuperCoder::is_symbol_missing(pivot_index));
+
+            assert(symbol_coefficients != 0);
+
             auto coefficient_storage =
                 sak::storage(symbol_coefficients,
                              SuperCoder::coefficient_vector_size());
@@ -528,12 +663,6 @@ namespace kodo
 
             // Mark this symbol seen
             SuperCoder::set_symbol_seen(pivot_index);
-
-            // Copy it into the symbol storage
-            sak::const_storage src =
-                sak::storage(symbol_data, SuperCoder::symbol_size());
-
-            SuperCoder::copy_into_symbol(pivot_index, src);
         }
 
         /// Stores an uncoded or fully decoded symbol
@@ -572,6 +701,16 @@ namespace kodo
 
     protected:
 
+        /// The stored symbols waiting to be subtracted from the symbol
+        /// being decoded
+        std::vector<const value_type*> m_pending_symbols;
+
+        /// The coefficients of the pending symbols
+        std::vector<value_type> m_pending_coefficients;
+
+        /// The current tile of every pending symbol
+        std::vector<const value_type*> m_pending_tiles;
+
         /// Stores the current maximum pivot index
         uint32_t m_maximum_pivot;
 
@@ -0,0 +1,170 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+#include <algorithm>
+
+#include <fifi/fifi_utils.hpp>
+
+#include "coder_arena.hpp"
+#include "rfc5052_partitioning_scheme.hpp"
+#include "last_level_cache_size.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup block_partitioning_implementation
+    /// @brief Block partitioning scheme which keeps the working set of
+    ///        a block inside the last level cache.
+    ///
+    /// Decoding a block touches the symbol data, symbols * symbol_size
+    /// bytes, and the coding coefficients, one coefficient vector per
+    /// symbol. When this working set does not fit in the cache the
+    /// decoding throughput drops sharply. The scheme therefore chooses
+    /// the number of symbols per block and the symbol size, within the
+    /// given maxima, so that the working set fits in the cache while
+    /// the coefficient vector sent with a symbol stays below the target
+    /// overhead relative to the symbol size. The largest number of
+    /// symbols satisfying both is preferred, and the largest symbol size
+    /// for it. The object is then partitioned as described in RFC5052.
+    ///
+    /// The chosen layout depends on the cache size, and encoders and
+    /// decoders must use the same layout. The cache size is therefore
+    /// never detected implicitly: the constructor without a cache size
+    /// uses the fixed default_cache_size(). To tune the layout for the
+    /// local machine, pass e.g. last_level_cache_size() explicitly and
+    /// communicate it to the decoder, which then builds the same
+    /// partitioning and hands it to the object_decoder.
+    ///
+    /// @tparam Field The finite field used, which determines the size
+    ///         of the coefficient vectors
+    template<class Field>
+    class cache_aware_partitioning_scheme : public rfc5052_partitioning_scheme
+    {
+    public:
+
+        /// The finite field used
+        typedef Field field_type;
+
+        /// The default maximum size of a coefficient vector relative to
+        /// the symbol size
+        static double default_max_overhead()
+        {
+            return 0.05;
+        }
+
+        /// The cache size in bytes used when none is given
+        static uint32_t default_cache_size()
+        {
+            return default_last_level_cache_size;
+        }
+
+    public:
+
+        /// Create an uninitialized partitioning scheme
+        cache_aware_partitioning_scheme()
+        { }
+
+        /// Constructor using the default cache size and overhead, so the
+        /// layout is the same on all machines
+        /// @param max_symbols the maximum number of symbols in a block
+        /// @param max_symbol_size the maximum size in bytes of a symbol
+        /// @param object_size the size in bytes of the whole object
+        cache_aware_partitioning_scheme(uint32_t max_symbols,
+                                        uint32_t max_symbol_size,
+                                        uint64_t object_size)
+        {
+            partition(max_symbols, max_symbol_size, object_size,
+                      default_cache_size(), default_max_overhead());
+        }
+
+        /// Constructor
+        /// @param max_symbols the maximum number of symbols in a block
+        /// @param max_symbol_size the maximum size in bytes of a symbol
+        /// @param object_size the size in bytes of the whole object
+        /// @param cache_size the size in bytes of the cache the working
+        ///        set of a block should fit in
+        /// @param max_overhead the maximum size of a coefficient vector
+        ///        relative to the symbol size, e.g. 0.05 for 5 percent
+        cache_aware_partitioning_scheme(uint32_t max_symbols,
+                                        uint32_t max_symbol_size,
+                                        uint64_t object_size,
+                                        uint32_t cache_size,
+                                        double max_overhead)
+        {
+            partition(max_symbols, max_symbol_size, object_size,
+                      cache_size, max_overhead);
+        }
+
+        /// @param symbols The number of symbols in a block
+        /// @param symbol_size The size in bytes of a symbol
+        /// @return The number of bytes touched when decoding the block
+        static uint64_t working_set(uint32_t symbols, uint32_t symbol_size)
+        {
+            uint64_t coefficients_size =
+                fifi::elements_to_size<field_type>(symbols);
+
+            return uint64_t(symbols) * symbol_size +
+                symbols * coefficients_size;
+        }
+
+    private:
+
+        /// Chooses the block layout and partitions the object
+        void partition(uint32_t max_symbols, uint32_t max_symbol_size,
+                       uint64_t object_size, uint32_t cache_size,
+                       double max_overhead)
+        {
+            assert(max_symbols > 0);
+            assert(max_symbol_size > 0);
+            assert(cache_size > 0);
+            assert(max_overhead > 0.0);
+
+            uint32_t symbols = 1;
+            uint32_t symbol_size = std::min(max_symbol_size, cache_size);
+
+            for(uint32_t k = max_symbols; k > 0; --k)
+            {
+                uint32_t coefficients_size =
+                    fifi::elements_to_size<field_type>(k);
+
+                uint64_t coefficients_total =
+                    uint64_t(k) * coefficients_size;
+
+                if(coefficients_total >= cache_size)
+                    continue;
+
+                uint32_t size = std::min<uint64_t>(
+                    max_symbol_size, (cache_size - coefficients_total) / k);
+
+                // Keep the symbols a multiple of the vector alignment
+                // used by the finite field implementations
+                if(size > coder_arena::vector_alignment)
+                    size -= size % coder_arena::vector_alignment;
+
+                if(size == 0)
+                    continue;
+
+                if(coefficients_size > max_overhead * size)
+                    continue;
+
+                symbols = k;
+                symbol_size = size;
+                break;
+            }
+
+            assert(symbols <= max_symbols);
+            assert(symbol_size <= max_symbol_size);
+
+            rfc5052_partitioning_scheme::operator=(
+                rfc5052_partitioning_scheme(symbols, symbol_size,
+                                            object_size));
+        }
+    };
+
+}
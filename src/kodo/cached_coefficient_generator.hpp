@@ -0,0 +1,223 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+#include <sak/aligned_allocator.hpp>
+
+#include "coder_arena.hpp"
+#include "coefficient_vector_cache.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup coefficient_generator_layers
+    /// @brief Caches the coefficient vectors generated from a seed in
+    ///        a table shared by all coders built by the same factory.
+    ///
+    /// The seed_symbol_id_reader and seed_symbol_id_writer seed the
+    /// generator and generate a full coefficient vector for every
+    /// symbol. Since the seeds are the symbol counts of the encoder,
+    /// all coders of the same flows generate the same vectors over and
+    /// over. With this layer the vector generated right after seeding
+    /// is looked up in the cache of the factory and copied instead of
+    /// generated.
+    ///
+    /// The cache is disabled until a capacity is set with
+    /// factory::set_coefficient_cache_size(). The layer should be
+    /// placed between the symbol id layer and the generator layer.
+    template<class SuperCoder>
+    class cached_coefficient_generator : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::seed_type
+        typedef typename SuperCoder::seed_type seed_type;
+
+        /// Pointer to the cache
+        typedef boost::shared_ptr<coefficient_vector_cache> cache_pointer;
+
+    public:
+
+        /// @ingroup factory_layers
+        /// The factory layer associated with this coder. The cache is
+        /// owned by the factory and shared with all coders
+        class factory : public SuperCoder::factory
+        {
+        public:
+
+            /// @copydoc layer::factory::factory(uint32_t,uint32_t)
+            factory(uint32_t max_symbols, uint32_t max_symbol_size) :
+                SuperCoder::factory(max_symbols, max_symbol_size),
+                m_cache(boost::make_shared<coefficient_vector_cache>(0))
+            { }
+
+            /// Replaces the cache used by coders built after this call
+            /// @param vectors The maximum number of coefficient vectors
+            ///        stored, zero disables the cache
+            void set_coefficient_cache_size(uint32_t vectors)
+            {
+                m_cache = boost::make_shared<coefficient_vector_cache>(
+                    vectors);
+            }
+
+            /// @return The maximum number of coefficient vectors stored
+            uint32_t coefficient_cache_size() const
+            {
+                return m_cache->capacity();
+            }
+
+            /// @return The cache shared by the coders
+            const cache_pointer& coefficient_cache() const
+            {
+                return m_cache;
+            }
+
+        private:
+
+            /// The cache
+            cache_pointer m_cache;
+        };
+
+    public:
+
+        /// Constructor
+        cached_coefficient_generator()
+            : m_seed(0),
+              m_seed_pending(false),
+              m_generator_behind(false)
+        { }
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory& the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            m_scratch.resize(the_factory.max_coefficient_vector_size());
+        }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory& the_factory)
+        {
+            SuperCoder::initialize(the_factory);
+
+            m_cache = the_factory.coefficient_cache();
+            m_seed_pending = false;
+            m_generator_behind = false;
+        }
+
+        /// The generator is only seeded once we know that the vector
+        /// is not in the cache
+        /// @copydoc layer::seed(seed_type)
+        void seed(seed_type seed_value)
+        {
+            if(m_cache->capacity() == 0)
+            {
+                SuperCoder::seed(seed_value);
+                return;
+            }
+
+            m_seed = seed_value;
+            m_seed_pending = true;
+            m_generator_behind = false;
+        }
+
+        /// @copydoc layer::generate(uint8_t*)
+        void generate(uint8_t *coefficients)
+        {
+            assert(coefficients != 0);
+
+            if(!m_seed_pending)
+            {
+                catch_up();
+                SuperCoder::generate(coefficients);
+                return;
+            }
+
+            m_seed_pending = false;
+
+            uint32_t symbols = SuperCoder::symbols();
+            uint32_t size = SuperCoder::coefficient_vector_size();
+
+            if(m_cache->find(symbols, m_seed, coefficients, size))
+            {
+                // The generator was never seeded, it is only brought up
+                // to date if another vector is requested before the
+                // next seed
+                m_generator_behind = true;
+                return;
+            }
+
+            SuperCoder::seed(m_seed);
+            SuperCoder::generate(coefficients);
+
+            m_cache->insert(symbols, m_seed, coefficients, size);
+        }
+
+        /// @copydoc layer::generate_partial(uint8_t*)
+        void generate_partial(uint8_t *coefficients)
+        {
+            assert(coefficients != 0);
+
+            // Partial vectors depend on the state of the coder and are
+            // not cached
+            if(m_seed_pending)
+            {
+                SuperCoder::seed(m_seed);
+                m_seed_pending = false;
+            }
+
+            catch_up();
+            SuperCoder::generate_partial(coefficients);
+        }
+
+    protected:
+
+        /// Brings the generator into the state it would have had if the
+        /// cached vector had been generated
+        void catch_up()
+        {
+            if(!m_generator_behind)
+                return;
+
+            SuperCoder::seed(m_seed);
+            SuperCoder::generate(&m_scratch[0]);
+
+            m_generator_behind = false;
+        }
+
+    protected:
+
+        /// The storage type
+        typedef std::vector<uint8_t, sak::aligned_allocator<
+            uint8_t, coder_arena::vector_alignment> > aligned_vector;
+
+        /// The cache shared with the other coders of the factory
+        cache_pointer m_cache;
+
+        /// The seed of the next vector
+        seed_type m_seed;
+
+        /// True if the generator has not been seeded with m_seed
+        bool m_seed_pending;
+
+        /// True if the vector generated from m_seed was taken from the
+        /// cache and the generator state was not advanced
+        bool m_generator_behind;
+
+        /// Buffer for vectors generated while catching up
+        aligned_vector m_scratch;
+
+    };
+
+}
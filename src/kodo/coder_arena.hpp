@@ -0,0 +1,206 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include <boost/noncopyable.hpp>
+
+namespace kodo
+{
+
+    /// @brief Lays out the buffers of a coder in one contiguous block
+    ///        of memory.
+    ///
+    /// The arena is used in two passes. In the first pass it has no
+    /// memory and only sums up the sizes of the requested buffers,
+    /// including the padding needed to align them, allocate() returns
+    /// null pointers. In the second pass it is created on a block of at
+    /// least size() bytes and the same sequence of requests returns the
+    /// sub-spans of that block.
+    ///
+    /// The block must be aligned to max_alignment bytes. The memory
+    /// handed out is zero initialized by the coder_arena_storage, so
+    /// only trivial types should be allocated from the arena.
+    class coder_arena
+    {
+    public:
+
+        /// The largest alignment in bytes a buffer may request, one
+        /// cache line
+        static const uint32_t max_alignment = 64;
+
+        /// The alignment in bytes of symbol and coefficient buffers,
+        /// chosen to match the widest SIMD registers used by the finite
+        /// field implementations
+        static const uint32_t vector_alignment = 32;
+
+    public:
+
+        /// Creates an arena measuring the requested buffers
+        coder_arena()
+            : m_data(0),
+              m_capacity(0),
+              m_size(0)
+        { }
+
+        /// Creates an arena handing out buffers from a block of memory
+        /// @param data The block, aligned to max_alignment bytes
+        /// @param capacity The size of the block in bytes
+        coder_arena(uint8_t *data, uint64_t capacity)
+            : m_data(data),
+              m_capacity(capacity),
+              m_size(0)
+        {
+            assert(m_data != 0);
+            assert(reinterpret_cast<uintptr_t>(m_data) % max_alignment == 0);
+        }
+
+        /// Requests a buffer
+        /// @param count The number of elements in the buffer
+        /// @param alignment The alignment in bytes of the buffer, a power
+        ///        of two not larger than max_alignment
+        /// @return The buffer or a null pointer while measuring
+        template<class T>
+        T* allocate(uint32_t count,
+                    uint32_t alignment = std::alignment_of<T>::value)
+        {
+            static_assert(std::is_trivially_destructible<T>::value,
+                          "The arena never runs destructors");
+
+            assert(alignment <= max_alignment);
+
+            m_size = align_size(m_size, alignment);
+
+            T *buffer = 0;
+
+            if(m_data != 0)
+            {
+                buffer = reinterpret_cast<T*>(m_data + m_size);
+            }
+
+            m_size += uint64_t(count) * sizeof(T);
+
+            assert(m_data == 0 || m_size <= m_capacity);
+            return buffer;
+        }
+
+        /// Rounds a size up to a multiple of an alignment, e.g. to keep
+        /// every buffer in an array of symbols or coefficient vectors
+        /// aligned
+        /// @param size The size in bytes
+        /// @param alignment The alignment in bytes, a power of two
+        /// @return The aligned size in bytes
+        static uint64_t align_size(uint64_t size,
+                                   uint32_t alignment = vector_alignment)
+        {
+            assert(alignment > 0);
+            assert((alignment & (alignment - 1)) == 0);
+
+            return (size + alignment - 1) & ~uint64_t(alignment - 1);
+        }
+
+        /// @return True if the arena only measures the requests
+        bool is_measuring() const
+        {
+            return m_data == 0;
+        }
+
+        /// @return The number of bytes requested so far
+        uint64_t size() const
+        {
+            return m_size;
+        }
+
+    private:
+
+        /// The block buffers are handed out from, null while measuring
+        uint8_t *m_data;
+
+        /// The size of the block in bytes
+        uint64_t m_capacity;
+
+        /// The number of bytes handed out so far
+        uint64_t m_size;
+    };
+
+    /// @brief Owns the single allocation backing a coder_arena.
+    ///
+    /// allocate() runs the given layout function twice, first on a
+    /// measuring arena and then on an arena over a block of exactly the
+    /// measured size, so every buffer requested by the layout function
+    /// ends up in the same allocation.
+    class coder_arena_storage : boost::noncopyable
+    {
+    public:
+
+        /// Creates an empty storage
+        coder_arena_storage()
+            : m_size(0)
+        { }
+
+        /// Allocates the block and lays out the buffers in it. The
+        /// layout function is called with a coder_arena& and must
+        /// request the same buffers on both calls.
+        /// @param layout The function requesting the buffers
+        template<class Layout>
+        void allocate(const Layout &layout)
+        {
+            assert(!m_block);
+
+            coder_arena measure;
+            layout(measure);
+
+            m_size = measure.size();
+
+            if(m_size == 0)
+                return;
+
+            assert(m_size <= std::numeric_limits<std::size_t>::max() -
+                   coder_arena::max_alignment);
+
+            // Allocate room for aligning the start of the block
+            std::size_t block_size = static_cast<std::size_t>(m_size) +
+                coder_arena::max_alignment;
+
+            m_block.reset(new uint8_t[block_size]);
+            std::memset(m_block.get(), 0, block_size);
+
+            uintptr_t address = reinterpret_cast<uintptr_t>(m_block.get());
+
+            uint32_t offset = (coder_arena::max_alignment -
+                (address % coder_arena::max_alignment)) %
+                coder_arena::max_alignment;
+
+            coder_arena place(m_block.get() + offset, m_size);
+            layout(place);
+
+            assert(place.size() == m_size);
+        }
+
+        /// @return The number of bytes of memory allocated, including
+        ///         the room for aligning the block
+        uint64_t memory_footprint() const
+        {
+            return m_block ? m_size + coder_arena::max_alignment : 0;
+        }
+
+    private:
+
+        /// The allocated block
+        std::unique_ptr<uint8_t[]> m_block;
+
+        /// The number of bytes laid out in the block
+        uint64_t m_size;
+    };
+
+}
@@ -6,15 +6,23 @@
 #pragma once
 
 #include <cstdint>
+
 #include <fifi/fifi_utils.hpp>
 #include <sak/storage.hpp>
 
+#include "coder_arena.hpp"
+
 namespace kodo
 {
 
     /// @ingroup coefficient_storage_layers
     /// @brief Provides storage and access to the coding coefficients
     ///        used during encoding and decoding.
+    ///
+    /// All coefficient vectors are stored in one buffer of the coder
+    /// arena. Every vector starts on a vector_alignment byte boundary,
+    /// i.e. the distance between two vectors is the maximum coefficient
+    /// vector size rounded up to the alignment.
     template<class SuperCoder>
     class coefficient_storage : public SuperCoder
     {
@@ -26,36 +34,57 @@ namespace kodo
         /// @copydoc layer::value_type
         typedef typename field_type::value_type value_type;
 
+        /// The alignment in bytes of every coefficient vector, chosen to
+        /// match the widest SIMD registers used by the finite field
+        /// implementations
+        static const uint32_t vector_alignment =
+            coder_arena::vector_alignment;
+
     public:
 
+        /// Constructor
+        coefficient_storage()
+            : m_coefficients(0),
+              m_vector_stride(0)
+        { }
+
+        /// @copydoc layer::layout(Factory&,coder_arena&)
+        template<class Factory>
+        void layout(Factory &the_factory, coder_arena &arena)
+        {
+            SuperCoder::layout(the_factory, arena);
+
+            m_vector_stride = static_cast<uint32_t>(coder_arena::align_size(
+                the_factory.max_coefficient_vector_size(), vector_alignment));
+
+            uint32_t matrix_size =
+                the_factory.max_coefficient_vectors() * m_vector_stride;
+
+            m_coefficients =
+                arena.allocate<uint8_t>(matrix_size, vector_alignment);
+        }
+
         /// @copydoc layer::construct(Factory&)
         template<class Factory>
         void construct(Factory &the_factory)
         {
             SuperCoder::construct(the_factory);
 
-            m_coefficients_storage.resize(
-                the_factory.max_coefficient_vectors());
-
-            for(auto& storage : m_coefficients_storage)
-            {
-                storage.resize(the_factory.max_coefficient_vector_size());
-            }
-
+            assert(m_coefficients != 0);
         }
 
         /// @copydoc layer::coefficient_vector_data(uint32_t)
         uint8_t* coefficient_vector_data(uint32_t index)
         {
             assert(index < SuperCoder::symbols());
-            return &(m_coefficients_storage[index])[0];
+            return m_coefficients + (index * m_vector_stride);
         }
 
         /// @copydoc layer::coefficient_vector_data(uint32_t) const
         const uint8_t* coefficient_vector_data(uint32_t index) const
         {
             assert(index < SuperCoder::symbols());
-            return &(m_coefficients_storage[index])[0];
+            return m_coefficients + (index * m_vector_stride);
         }
 
         /// @copydoc layer::coefficient_vector_value(uint32_t)
@@ -89,13 +118,11 @@ namespace kodo
 
     private:
 
-        /// Stores the encoding vectors, we do a vector of vectors
-        /// to maximize chances of proper alignment of individual
-        /// coefficient vectors. This is needed when using SSE etc.
-        /// instructions for fast computations with the coefficients
-        std::vector< std::vector<uint8_t> > m_coefficients_storage;
+        /// The start of the coefficient vectors
+        uint8_t* m_coefficients;
+
+        /// The distance in bytes between two coefficient vectors
+        uint32_t m_vector_stride;
 
     };
 }
-
-
@@ -6,6 +6,9 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+
+#include <boost/optional.hpp>
 
 #include <fifi/fifi_utils.hpp>
 
@@ -44,6 +47,106 @@ namespace kodo
             fifi::set_value<field_type>(coefficients, index, value);
         }
 
+        /// @copydoc layer::first_nonzero_coefficient(const value_type*,
+        ///              uint32_t, uint32_t) const
+        boost::optional<uint32_t> first_nonzero_coefficient(
+            const value_type* coefficients, uint32_t first,
+            uint32_t last) const
+        {
+            assert(coefficients != 0);
+            assert(first <= last);
+
+            const uint32_t word_elements = elements_per_word();
+
+            uint32_t i = first;
+            uint32_t end = last + 1;
+
+            // Inspect single elements until we reach a word boundary
+            for(; i < end && (i % word_elements) != 0; ++i)
+            {
+                if(coefficient_value(coefficients, i))
+                    return boost::optional<uint32_t>(i);
+            }
+
+            // Skip the words where all elements are zero
+            for(; i + word_elements <= end; i += word_elements)
+            {
+                if(coefficient_word(coefficients, i / word_elements) != 0)
+                    break;
+            }
+
+            // Locate the element in the non-zero word or in the tail
+            for(; i < end; ++i)
+            {
+                if(coefficient_value(coefficients, i))
+                    return boost::optional<uint32_t>(i);
+            }
+
+            return boost::none;
+        }
+
+        /// @copydoc layer::last_nonzero_coefficient(const value_type*,
+        ///              uint32_t, uint32_t) const
+        boost::optional<uint32_t> last_nonzero_coefficient(
+            const value_type* coefficients, uint32_t first,
+            uint32_t last) const
+        {
+            assert(coefficients != 0);
+            assert(first <= last);
+
+            const uint32_t word_elements = elements_per_word();
+
+            // The elements not yet inspected are [first:end)
+            uint32_t end = last + 1;
+
+            for(; end > first && (end % word_elements) != 0; --end)
+            {
+                if(coefficient_value(coefficients, end - 1))
+                    return boost::optional<uint32_t>(end - 1);
+            }
+
+            for(; end >= first + word_elements; end -= word_elements)
+            {
+                if(coefficient_word(coefficients, end / word_elements - 1) != 0)
+                    break;
+            }
+
+            for(; end > first; --end)
+            {
+                if(coefficient_value(coefficients, end - 1))
+                    return boost::optional<uint32_t>(end - 1);
+            }
+
+            return boost::none;
+        }
+
+    private:
+
+        /// @return The number of field elements stored in a 64 bit word
+        static uint32_t elements_per_word()
+        {
+            return fifi::size_to_elements<field_type>(sizeof(uint64_t));
+        }
+
+        /// @param coefficients The coefficients array
+        /// @param word The index of the 64 bit word in the array
+        /// @return The word, where only a comparison with zero is
+        ///         meaningful since the byte order is not defined
+        static uint64_t coefficient_word(const value_type* coefficients,
+                                         uint32_t word)
+        {
+            const uint8_t* data =
+                reinterpret_cast<const uint8_t*>(coefficients);
+
+            // The coefficient vectors are not guaranteed to be aligned
+            // to 8 bytes (e.g. when read from a payload) so we copy
+            uint64_t value;
+            std::memcpy(&value, data + word * sizeof(uint64_t),
+                        sizeof(uint64_t));
+
+            return value;
+        }
+
     };
 
 }
@@ -0,0 +1,245 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include <sak/aligned_allocator.hpp>
+
+#include "coder_arena.hpp"
+
+namespace kodo
+{
+
+    /// @brief Bounded table of generated coefficient vectors, keyed by
+    ///        the number of symbols and the seed used to generate them.
+    ///
+    /// The table may be shared between coders used from different
+    /// threads. It is split into shards selected by the key, each with
+    /// its own mutex and its own share of the capacity, so coders
+    /// looking up different seeds rarely contend for the same lock.
+    /// When a shard is full its oldest vector is evicted.
+    class coefficient_vector_cache : boost::noncopyable
+    {
+    public:
+
+        /// The storage type of a coefficient vector
+        typedef std::vector<uint8_t, sak::aligned_allocator<
+            uint8_t, coder_arena::vector_alignment> > aligned_vector;
+
+        /// The maximum number of shards
+        static const uint32_t max_shards = 16;
+
+    public:
+
+        /// Constructor
+        /// @param capacity The maximum number of vectors stored
+        coefficient_vector_cache(uint32_t capacity)
+            : m_capacity(capacity),
+              m_shard_count(1)
+        {
+            // Use as many shards as possible while giving every shard
+            // room for at least one vector
+            while(m_shard_count < max_shards &&
+                  2 * m_shard_count <= m_capacity)
+            {
+                m_shard_count *= 2;
+            }
+
+            m_shards.reset(new shard[m_shard_count]);
+
+            for(uint32_t i = 0; i < m_shard_count; ++i)
+            {
+                m_shards[i].m_capacity = m_capacity / m_shard_count +
+                    (i < m_capacity % m_shard_count ? 1 : 0);
+            }
+        }
+
+        /// Copies a stored coefficient vector. The vector is copied
+        /// since the decoders eliminate the coefficients in place.
+        /// @param symbols The number of symbols
+        /// @param seed The seed used to generate the vector
+        /// @param coefficients The destination buffer
+        /// @param size The size of the vector in bytes
+        /// @return true if the vector was found
+        bool find(uint32_t symbols, uint64_t seed, uint8_t *coefficients,
+                  uint32_t size) const
+        {
+            assert(coefficients != 0);
+
+            if(m_capacity == 0)
+                return false;
+
+            key_type key = make_key(symbols, seed);
+            shard& s = shard_of(key);
+
+            std::lock_guard<std::mutex> lock(s.m_mutex);
+
+            auto it = s.m_vectors.find(key);
+
+            if(it == s.m_vectors.end())
+                return false;
+
+            assert(it->second.size() == size);
+            std::copy_n(it->second.begin(), size, coefficients);
+
+            return true;
+        }
+
+        /// Stores a copy of a coefficient vector
+        /// @param symbols The number of symbols
+        /// @param seed The seed used to generate the vector
+        /// @param coefficients The coefficient vector
+        /// @param size The size of the vector in bytes
+        void insert(uint32_t symbols, uint64_t seed,
+                    const uint8_t *coefficients, uint32_t size)
+        {
+            assert(coefficients != 0);
+
+            if(m_capacity == 0)
+                return;
+
+            key_type key = make_key(symbols, seed);
+            shard& s = shard_of(key);
+
+            // Copy the vector before taking the lock, so the lock is
+            // only held while the shard is updated
+            aligned_vector vector(coefficients, coefficients + size);
+
+            std::lock_guard<std::mutex> lock(s.m_mutex);
+
+            // Another coder may have inserted the vector meanwhile
+            if(s.m_vectors.count(key))
+                return;
+
+            if(s.m_order.size() == s.m_capacity)
+            {
+                s.m_vectors.erase(s.m_order.front());
+                s.m_order.pop_front();
+            }
+
+            s.m_vectors[key].swap(vector);
+            s.m_order.push_back(key);
+        }
+
+        /// @return The maximum number of vectors stored
+        uint32_t capacity() const
+        {
+            return m_capacity;
+        }
+
+        /// @return The number of vectors currently stored
+        uint32_t size() const
+        {
+            uint32_t vectors = 0;
+
+            for(uint32_t i = 0; i < m_shard_count; ++i)
+            {
+                std::lock_guard<std::mutex> lock(m_shards[i].m_mutex);
+                vectors += static_cast<uint32_t>(m_shards[i].m_vectors.size());
+            }
+
+            return vectors;
+        }
+
+    private:
+
+        /// The key of a coefficient vector, the seed is combined with
+        /// the number of symbols such that equal seeds used for blocks
+        /// of different sizes do not collide
+        struct key_type
+        {
+            /// The number of symbols
+            uint32_t m_symbols;
+
+            /// The seed
+            uint64_t m_seed;
+
+            /// @return true if the keys are equal
+            bool operator==(const key_type& other) const
+            {
+                return m_symbols == other.m_symbols &&
+                    m_seed == other.m_seed;
+            }
+        };
+
+        /// Hashes a key, consecutive seeds are spread over the shards
+        struct key_hash
+        {
+            /// @return The hash of the key
+            std::size_t operator()(const key_type& key) const
+            {
+                uint64_t h = key.m_seed ^
+                    (uint64_t(key.m_symbols) * 0x9e3779b97f4a7c15ULL);
+
+                return static_cast<std::size_t>(h ^ (h >> 32));
+            }
+        };
+
+        /// A part of the table protected by its own mutex
+        struct shard
+        {
+            /// Constructor
+            shard()
+                : m_capacity(0)
+            { }
+
+            /// The maximum number of vectors stored in the shard
+            uint32_t m_capacity;
+
+            /// Protects the shard
+            std::mutex m_mutex;
+
+            /// The stored vectors
+            std::unordered_map<key_type, aligned_vector, key_hash>
+                m_vectors;
+
+            /// The keys in insertion order, used for eviction
+            std::deque<key_type> m_order;
+        };
+
+    private:
+
+        /// @return The key of a vector
+        static key_type make_key(uint32_t symbols, uint64_t seed)
+        {
+            key_type key;
+            key.m_symbols = symbols;
+            key.m_seed = seed;
+            return key;
+        }
+
+        /// @return The shard storing the key
+        shard& shard_of(const key_type& key) const
+        {
+            // The shard count is a power of two
+            std::size_t index = key_hash()(key) & (m_shard_count - 1);
+            return m_shards[index];
+        }
+
+    private:
+
+        /// The maximum number of vectors stored
+        uint32_t m_capacity;
+
+        /// The number of shards, a power of two
+        uint32_t m_shard_count;
+
+        /// The shards
+        std::unique_ptr<shard[]> m_shards;
+
+    };
+
+}
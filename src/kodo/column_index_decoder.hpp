@@ -0,0 +1,313 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/optional.hpp>
+
+#include <fifi/fifi_utils.hpp>
+#include <fifi/is_binary.hpp>
+
+namespace kodo
+{
+
+    /// @ingroup decoder_layers
+    /// @brief Linear block decoder which keeps an index of the stored
+    ///        symbols having non-zero coefficients in every column.
+    ///
+    /// The bidirectional_linear_block_decoder visits every stored
+    /// symbol during backward substitution to check whether it has a
+    /// non-zero coefficient at the new pivot position. For sparse
+    /// codes most of these coefficients are zero. This layer
+    /// maintains, for every column of the coding matrix, a bitset of
+    /// the stored symbols which may have a non-zero coefficient in
+    /// that column, so backward substitution only visits those.
+    ///
+    /// The index is a superset: bits are set when a symbol is stored
+    /// and when backward substitution may introduce new non-zero
+    /// coefficients (fill-in), a column is cleared when it becomes a
+    /// pivot column.
+    ///
+    /// The layer should be placed on top of the
+    /// forward_linear_block_decoder or backward_linear_block_decoder
+    /// layers and cannot be combined with the
+    /// linear_block_decoder_delayed layer.
+    template<class SuperCoder>
+    class column_index_decoder : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::field_type
+        typedef typename SuperCoder::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename field_type::value_type value_type;
+
+        /// Access the direction policy used by the underlying decoder
+        typedef typename SuperCoder::direction_policy direction_policy;
+
+        /// The bitset used to index the stored symbols of a column
+        typedef boost::dynamic_bitset<uint64_t> column_type;
+
+    public:
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory &the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            m_columns.resize(the_factory.max_symbols());
+            m_nonzero_columns.reserve(the_factory.max_symbols());
+        }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory& the_factory)
+        {
+            SuperCoder::initialize(the_factory);
+
+            for(auto& column : m_columns)
+            {
+                column.resize(the_factory.symbols());
+                column.reset();
+            }
+        }
+
+        /// @copydoc layer::decode_symbol(uint8_t*,uint8_t*)
+        void decode_symbol(uint8_t *symbol_data, uint8_t *coefficients)
+        {
+            assert(symbol_data != 0);
+            assert(coefficients != 0);
+
+            value_type *symbol =
+                reinterpret_cast<value_type*>(symbol_data);
+
+            value_type *symbol_id =
+                reinterpret_cast<value_type*>(coefficients);
+
+            decode_coefficients(symbol, symbol_id);
+
+            SuperCoder::update_symbol_status();
+        }
+
+        /// @copydoc layer::decode_symbol(uint8_t*,uint32_t)
+        void decode_symbol(uint8_t *symbol_data, uint32_t symbol_index)
+        {
+            assert(symbol_index < SuperCoder::symbols());
+            assert(symbol_data != 0);
+
+            if(SuperCoder::is_symbol_decoded(symbol_index))
+                return;
+
+            const value_type *symbol =
+                reinterpret_cast<const value_type*>(symbol_data);
+
+            if(SuperCoder::is_symbol_seen(symbol_index))
+            {
+                swap_decode(symbol, symbol_index);
+            }
+            else
+            {
+                SuperCoder::store_uncoded_symbol(symbol, symbol_index);
+
+                value_type *coefficients =
+                    SuperCoder::coefficient_vector_values(symbol_index);
+
+                backward_substitute(symbol, coefficients, symbol_index);
+
+                m_maximum_pivot =
+                    direction_policy::max(symbol_index, m_maximum_pivot);
+            }
+
+            SuperCoder::update_symbol_status();
+        }
+
+        /// @param column The column of the coding matrix
+        /// @return The stored symbols which may have a non-zero
+        ///         coefficient in the column
+        const column_type& column_index(uint32_t column) const
+        {
+            assert(column < SuperCoder::symbols());
+            return m_columns[column];
+        }
+
+    protected:
+
+        // Fetch the variables needed
+        using SuperCoder::m_maximum_pivot;
+
+    protected:
+
+        /// @copydoc bidirectional_linear_block_decoder::decode_coefficients(
+        ///              value_type*,value_type*)
+        void decode_coefficients(value_type *symbol_data,
+                                 value_type *symbol_coefficients)
+        {
+            assert(symbol_data != 0);
+            assert(symbol_coefficients != 0);
+
+            auto pivot_index = SuperCoder::forward_substitute_to_pivot(
+                symbol_data, symbol_coefficients);
+
+            if(!pivot_index)
+                return;
+
+            if(!fifi::is_binary<field_type>::value)
+            {
+                SuperCoder::normalize(
+                    symbol_data, symbol_coefficients, *pivot_index);
+            }
+
+            SuperCoder::forward_substitute_from_pivot(
+                symbol_data, symbol_coefficients, *pivot_index);
+
+            backward_substitute(
+                symbol_data, symbol_coefficients, *pivot_index);
+
+            SuperCoder::store_coded_symbol(
+                symbol_data, symbol_coefficients, *pivot_index);
+
+            // The stored symbol has non-zero coefficients in the same
+            // columns as the new symbol
+            for(uint32_t column : m_nonzero_columns)
+            {
+                m_columns[column].set(*pivot_index);
+            }
+
+            m_maximum_pivot =
+                direction_policy::max(*pivot_index, m_maximum_pivot);
+        }
+
+        /// @copydoc bidirectional_linear_block_decoder::swap_decode(
+        ///              const value_type*,uint32_t)
+        void swap_decode(const value_type *symbol_data, uint32_t pivot_index)
+        {
+            assert(SuperCoder::is_symbol_seen(pivot_index));
+
+            SuperCoder::set_symbol_missing(pivot_index);
+
+            value_type *symbol_i = SuperCoder::symbol_value(pivot_index);
+
+            value_type *vector_i =
+                SuperCoder::coefficient_vector_values(pivot_index);
+
+            assert(SuperCoder::coefficient_value(vector_i, pivot_index) == 1);
+
+            // Subtract the new pivot symbol
+            SuperCoder::set_coefficient_value(vector_i, pivot_index, 0U);
+
+            SuperCoder::subtract(symbol_i, symbol_data,
+                                 SuperCoder::symbol_length());
+
+            // Find a new position for the coded symbol
+            decode_coefficients(symbol_i, vector_i);
+
+            std::fill_n(vector_i, SuperCoder::coefficient_vector_length(), 0);
+
+            SuperCoder::store_uncoded_symbol(symbol_data, pivot_index);
+        }
+
+        /// Backward substitutes the new symbol into the stored symbols
+        /// which have a non-zero coefficient at the pivot position
+        /// according to the column index.
+        /// @copydoc bidirectional_linear_block_decoder::backward_substitute(
+        ///              const value_type*,const value_type*,uint32_t)
+        void backward_substitute(const value_type *symbol_data,
+                                 const value_type *symbol_id,
+                                 uint32_t pivot_index)
+        {
+            assert(symbol_id != 0);
+            assert(symbol_data != 0);
+            assert(pivot_index < SuperCoder::symbols());
+
+            // Find the columns where the new symbol is non-zero, these
+            // are the columns where fill-in can occur
+            m_nonzero_columns.clear();
+
+            uint32_t last = SuperCoder::symbols() - 1;
+
+            for(auto i = SuperCoder::first_nonzero_coefficient(
+                    symbol_id, 0, last); i;)
+            {
+                m_nonzero_columns.push_back(*i);
+
+                if(*i == last)
+                    break;
+
+                i = SuperCoder::first_nonzero_coefficient(
+                    symbol_id, *i + 1, last);
+            }
+
+            column_type &rows = m_columns[pivot_index];
+
+            for(auto i = rows.find_first(); i != column_type::npos;
+                i = rows.find_next(i))
+            {
+                if(i == pivot_index)
+                    continue;
+
+                // The index may contain symbols which have since been
+                // decoded
+                if(!SuperCoder::is_symbol_seen(i))
+                    continue;
+
+                value_type *vector_i =
+                    SuperCoder::coefficient_vector_values(i);
+
+                value_type value =
+                    SuperCoder::coefficient_value(vector_i, pivot_index);
+
+                if(!value)
+                    continue;
+
+                value_type *symbol_i = SuperCoder::symbol_value(i);
+
+                if(fifi::is_binary<field_type>::value)
+                {
+                    SuperCoder::subtract(vector_i, symbol_id,
+                        SuperCoder::coefficient_vector_length());
+
+                    SuperCoder::subtract(symbol_i, symbol_data,
+                        SuperCoder::symbol_length());
+                }
+                else
+                {
+                    SuperCoder::multiply_subtract(vector_i, symbol_id, value,
+                        SuperCoder::coefficient_vector_length());
+
+                    SuperCoder::multiply_subtract(symbol_i, symbol_data, value,
+                        SuperCoder::symbol_length());
+                }
+            }
+
+            // Every symbol we may have modified can now be non-zero
+            // where the new symbol is non-zero
+            for(uint32_t column : m_nonzero_columns)
+            {
+                if(column != pivot_index)
+                    m_columns[column] |= rows;
+            }
+
+            // No stored symbol except the new one is non-zero in the
+            // pivot column
+            rows.reset();
+        }
+
+    protected:
+
+        /// The stored symbols which may be non-zero in every column
+        std::vector<column_type> m_columns;
+
+        /// The non-zero columns of the symbol being decoded
+        std::vector<uint32_t> m_nonzero_columns;
+
+    };
+
+}
@@ -0,0 +1,434 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+#include <atomic>
+#include <functional>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/weak_ptr.hpp>
+
+namespace kodo
+{
+
+    /// @brief Thread-safe pool of recycled resources.
+    ///
+    /// Has the same interface as the sak::resource_pool, but
+    /// allocate() may be called, and the returned resources released,
+    /// from any number of threads concurrently.
+    ///
+    /// Every thread keeps a small magazine of free resources per pool,
+    /// so a thread releasing and allocating resources does not touch
+    /// any shared state. When a magazine runs empty or full, resources
+    /// are moved from or to a global free list, which is a lock-free
+    /// stack. The entries of the stack are indices into the resource
+    /// storage tagged with a counter, which rules out the ABA problem
+    /// without requiring a double-width compare-and-swap.
+    ///
+    /// Resources in the magazine of a thread are returned to the global
+    /// free list when the thread exits. The pool is kept alive until
+    /// all resources allocated from it have been released.
+    template<class Value>
+    class concurrent_resource_pool
+    {
+    public:
+
+        /// Pointer to a resource
+        typedef boost::shared_ptr<Value> value_ptr;
+
+        /// The function used to create new resources
+        typedef std::function<value_ptr()> allocator_function;
+
+    public:
+
+        /// Create a new pool
+        /// @param allocator The function used to create new resources
+        concurrent_resource_pool(allocator_function allocator)
+            : m_pool(boost::make_shared<impl>(allocator))
+        {
+            m_pool->m_self = m_pool;
+        }
+
+        /// @return A resource, which is returned to the pool once all
+        ///         copies of the pointer have been released
+        value_ptr allocate()
+        {
+            uint32_t index = m_pool->pop();
+
+            if(index == invalid_index)
+                index = m_pool->new_node();
+
+            node &n = m_pool->node_at(index);
+
+            if(n.m_value)
+            {
+                --m_pool->m_unused;
+            }
+            else
+            {
+                n.m_value = m_pool->m_allocator();
+                ++m_pool->m_total;
+            }
+
+            return value_ptr(n.m_value.get(), deleter(m_pool, index));
+        }
+
+        /// @return The number of resources created by the pool
+        uint32_t total_resources() const
+        {
+            return m_pool->m_total;
+        }
+
+        /// @return The number of resources waiting to be reused
+        uint32_t unused_resources() const
+        {
+            return m_pool->m_unused;
+        }
+
+        /// @return The number of resources in use
+        uint32_t used_resources() const
+        {
+            return total_resources() - unused_resources();
+        }
+
+        /// Destroys the unused resources in the global free list.
+        /// Resources cached by the threads are kept.
+        void free_unused()
+        {
+            m_pool->free_unused();
+        }
+
+    private:
+
+        /// Marks the end of a list of nodes
+        static const uint32_t invalid_index = 0xffffffffU;
+
+        /// The number of free resources a thread may cache per pool
+        static const uint32_t magazine_size = 16;
+
+        /// The number of pools a thread caches resources for
+        static const uint32_t magazine_count = 8;
+
+        /// The number of nodes allocated at a time
+        static const uint32_t chunk_size = 256;
+
+        /// The maximum number of chunks
+        static const uint32_t max_chunks = 1024;
+
+        /// Holds a resource and links it into the global free list
+        struct node
+        {
+            /// The resource, empty if it has not been created or has
+            /// been freed
+            value_ptr m_value;
+
+            /// The next node in the global free list
+            std::atomic<uint32_t> m_next;
+        };
+
+        /// The shared state of the pool
+        struct impl : boost::noncopyable
+        {
+            impl(allocator_function allocator)
+                : m_allocator(allocator),
+                  m_id(next_id()),
+                  m_head(pack(0, invalid_index)),
+                  m_nodes(0),
+                  m_total(0),
+                  m_unused(0)
+            {
+                for(auto& chunk : m_chunks)
+                    chunk = 0;
+            }
+
+            ~impl()
+            {
+                for(auto& chunk : m_chunks)
+                    delete[] chunk.load();
+            }
+
+            /// @return A node not used by anybody else
+            uint32_t new_node()
+            {
+                uint32_t index = m_nodes++;
+                uint32_t chunk = index / chunk_size;
+
+                assert(chunk < max_chunks);
+
+                if(m_chunks[chunk].load(std::memory_order_acquire) == 0)
+                {
+                    node *nodes = new node[chunk_size];
+                    node *expected = 0;
+
+                    // Another thread may have allocated the chunk
+                    if(!m_chunks[chunk].compare_exchange_strong(
+                           expected, nodes, std::memory_order_acq_rel))
+                    {
+                        delete[] nodes;
+                    }
+                }
+
+                return index;
+            }
+
+            /// @param index The index of a node
+            /// @return The node
+            node &node_at(uint32_t index)
+            {
+                node *nodes =
+                    m_chunks[index / chunk_size].load(
+                        std::memory_order_acquire);
+
+                assert(nodes != 0);
+                return nodes[index % chunk_size];
+            }
+
+            /// Returns a node to the pool, first to the magazine of the
+            /// calling thread
+            void push(uint32_t index)
+            {
+                magazine &local = local_magazine();
+
+                if(local.m_size == magazine_size)
+                {
+                    // Hand half of the magazine to the other threads
+                    while(local.m_size > magazine_size / 2)
+                        push_global(local.m_indices[--local.m_size]);
+                }
+
+                local.m_indices[local.m_size++] = index;
+            }
+
+            /// @return A free node, first from the magazine of the
+            ///         calling thread, or invalid_index if there is none
+            uint32_t pop()
+            {
+                magazine &local = local_magazine();
+
+                if(local.m_size > 0)
+                    return local.m_indices[--local.m_size];
+
+                return pop_global();
+            }
+
+            /// Pushes a node on the global free list
+            void push_global(uint32_t index)
+            {
+                node &n = node_at(index);
+                uint64_t head = m_head.load(std::memory_order_relaxed);
+
+                do
+                {
+                    n.m_next.store(index_of(head), std::memory_order_relaxed);
+                }
+                while(!m_head.compare_exchange_weak(
+                          head, pack(tag_of(head) + 1, index),
+                          std::memory_order_release,
+                          std::memory_order_relaxed));
+            }
+
+            /// @return A node popped from the global free list or
+            ///         invalid_index if it is empty
+            uint32_t pop_global()
+            {
+                uint64_t head = m_head.load(std::memory_order_acquire);
+
+                while(index_of(head) != invalid_index)
+                {
+                    uint32_t next = node_at(index_of(head)).m_next.load(
+                        std::memory_order_relaxed);
+
+                    // The tag changes with every update of the head, so
+                    // the exchange fails if the node has been popped in
+                    // the meantime, even if it was pushed again
+                    if(m_head.compare_exchange_weak(
+                           head, pack(tag_of(head) + 1, next),
+                           std::memory_order_acquire,
+                           std::memory_order_acquire))
+                    {
+                        return index_of(head);
+                    }
+                }
+
+                return invalid_index;
+            }
+
+            /// Destroys the resources in the global free list
+            void free_unused()
+            {
+                uint64_t head = m_head.load(std::memory_order_acquire);
+
+                while(!m_head.compare_exchange_weak(
+                          head, pack(tag_of(head) + 1, invalid_index),
+                          std::memory_order_acquire,
+                          std::memory_order_acquire))
+                { }
+
+                // The detached nodes are owned by this thread, they are
+                // pushed back empty so they can hold new resources
+                uint32_t index = index_of(head);
+
+                while(index != invalid_index)
+                {
+                    node &n = node_at(index);
+                    uint32_t next = n.m_next.load(std::memory_order_relaxed);
+
+                    if(n.m_value)
+                    {
+                        n.m_value.reset();
+                        --m_total;
+                        --m_unused;
+                    }
+
+                    push_global(index);
+                    index = next;
+                }
+            }
+
+            /// A cache of free nodes of one pool kept by a thread
+            struct magazine : boost::noncopyable
+            {
+                magazine()
+                    : m_id(0),
+                      m_size(0)
+                { }
+
+                /// Returns the cached nodes when the thread exits
+                ~magazine()
+                {
+                    flush();
+                }
+
+                /// Returns the cached nodes to the global free list of
+                /// the pool if it still exists
+                void flush()
+                {
+                    if(auto pool = m_pool.lock())
+                    {
+                        while(m_size > 0)
+                            pool->push_global(m_indices[--m_size]);
+                    }
+
+                    m_size = 0;
+                }
+
+                /// The pool the nodes belong to
+                boost::weak_ptr<impl> m_pool;
+
+                /// The id of the pool, zero if unused
+                uint64_t m_id;
+
+                /// The number of cached nodes
+                uint32_t m_size;
+
+                /// The cached nodes
+                uint32_t m_indices[magazine_size];
+            };
+
+            /// @return The magazine of the calling thread for this pool
+            magazine &local_magazine()
+            {
+                static thread_local magazine magazines[magazine_count];
+
+                magazine &local = magazines[m_id % magazine_count];
+
+                if(local.m_id != m_id)
+                {
+                    // The slot was used by another pool, it gets its
+                    // nodes back before the slot is taken over
+                    local.flush();
+                    local.m_pool = m_self;
+                    local.m_id = m_id;
+                }
+
+                return local;
+            }
+
+            /// @return A new id, ids are never reused so a magazine of
+            ///         a destroyed pool is never mistaken for another
+            static uint64_t next_id()
+            {
+                static std::atomic<uint64_t> id(0);
+                return ++id;
+            }
+
+            static uint64_t pack(uint32_t tag, uint32_t index)
+            {
+                return (uint64_t(tag) << 32) | index;
+            }
+
+            static uint32_t tag_of(uint64_t head)
+            {
+                return static_cast<uint32_t>(head >> 32);
+            }
+
+            static uint32_t index_of(uint64_t head)
+            {
+                return static_cast<uint32_t>(head);
+            }
+
+            /// The function used to create new resources
+            allocator_function m_allocator;
+
+            /// Weak reference handed to the magazines
+            boost::weak_ptr<impl> m_self;
+
+            /// The unique id of the pool
+            uint64_t m_id;
+
+            /// The tag and index of the first node in the global free
+            /// list
+            std::atomic<uint64_t> m_head;
+
+            /// The chunks of nodes
+            std::atomic<node*> m_chunks[max_chunks];
+
+            /// The number of nodes handed out by new_node()
+            std::atomic<uint32_t> m_nodes;
+
+            /// The number of resources created
+            std::atomic<uint32_t> m_total;
+
+            /// The number of resources waiting to be reused
+            std::atomic<uint32_t> m_unused;
+        };
+
+        /// Returns a resource to the pool when released by the user
+        struct deleter
+        {
+            deleter(const boost::shared_ptr<impl> &pool, uint32_t index)
+                : m_pool(pool),
+                  m_index(index)
+            { }
+
+            void operator()(Value*)
+            {
+                assert(m_pool);
+
+                ++m_pool->m_unused;
+                m_pool->push(m_index);
+
+                m_pool.reset();
+            }
+
+            /// The pool, kept alive while the resource is in use
+            boost::shared_ptr<impl> m_pool;
+
+            /// The node holding the resource
+            uint32_t m_index;
+        };
+
+    private:
+
+        /// The shared state
+        boost::shared_ptr<impl> m_pool;
+    };
+
+}
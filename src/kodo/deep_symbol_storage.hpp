@@ -6,11 +6,14 @@
 #pragma once
 
 #include <cstdint>
+#include <algorithm>
 #include <vector>
 
 #include <fifi/fifi_utils.hpp>
 #include <sak/storage.hpp>
 
+#include "coder_arena.hpp"
+
 namespace kodo
 {
 
@@ -31,23 +34,39 @@ namespace kodo
 
     public:
 
-        /// @copydoc layer::construct(Factory&)
+        /// Constructor
+        deep_symbol_storage()
+            : m_data(0),
+              m_data_size(0),
+              m_symbols_count(0),
+              m_symbols(0)
+        { }
+
+        /// @copydoc layer::layout(Factory&,coder_arena&)
         template<class Factory>
-        void construct(Factory& the_factory)
+        void layout(Factory& the_factory, coder_arena& arena)
         {
-            SuperCoder::construct(the_factory);
+            SuperCoder::layout(the_factory, arena);
 
-            uint32_t max_data_needed =
+            m_data_size =
                 the_factory.max_symbols() * the_factory.max_symbol_size();
 
-            assert(max_data_needed > 0);
+            assert(m_data_size > 0);
 
-            // Construct should only be called once so
-            // m_data.size() should be zero
-            assert(m_data.size() == 0);
-            m_data.resize(max_data_needed, 0);
+            m_data = arena.allocate<uint8_t>(
+                m_data_size, coder_arena::vector_alignment);
 
-            m_symbols.resize(the_factory.max_symbols(), false);
+            m_symbols = arena.allocate<bool>(the_factory.max_symbols());
+        }
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory& the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            assert(m_data != 0);
+            assert(m_symbols != 0);
         }
 
         /// @copydoc layer::initialize(Factory&)
@@ -59,8 +78,8 @@ namespace kodo
             /// @todo This should not be necessary - we should not
             ///       use data which has not been initialized yet
             ///       anyway
-            std::fill(m_data.begin(), m_data.end(), 0);
-            std::fill(m_symbols.begin(), m_symbols.end(), false);
+            std::fill_n(m_data, m_data_size, 0);
+            std::fill_n(m_symbols, the_factory.max_symbols(), false);
 
             m_symbols_count = 0;
         }
@@ -69,7 +88,7 @@ namespace kodo
         uint8_t* symbol(uint32_t index)
         {
             assert(index < SuperCoder::symbols());
-            return &m_data[index * SuperCoder::symbol_size()];
+            return m_data + (index * SuperCoder::symbol_size());
         }
 
         /// @copydoc layer::symbol_value(uint32_t)
@@ -82,7 +101,7 @@ namespace kodo
         const uint8_t* symbol(uint32_t index) const
         {
             assert(index < SuperCoder::symbols());
-            return &m_data[index * SuperCoder::symbol_size()];
+            return m_data + (index * SuperCoder::symbol_size());
         }
 
         /// @copydoc layer::symbol_value(uint32_t) const
@@ -94,11 +113,23 @@ namespace kodo
         /// @copydoc layer::swap_symbols(std::vector<uint8_t> &)
         void swap_symbols(std::vector<uint8_t> &symbols)
         {
-            assert(m_data.size() == symbols.size());
-            m_data.swap(symbols);
+            assert(m_data_size == symbols.size());
+
+            // The symbols live in the coder arena, so the contents are
+            // exchanged instead of the buffers
+            std::swap_ranges(symbols.begin(), symbols.end(), m_data);
 
             m_symbols_count = SuperCoder::symbols();
-            std::fill(m_symbols.begin(), m_symbols.end(), true);
+            std::fill_n(m_symbols, SuperCoder::symbols(), true);
+        }
+
+        /// @copydoc layer::set_symbols_in_place()
+        sak::mutable_storage set_symbols_in_place()
+        {
+            m_symbols_count = SuperCoder::symbols();
+            std::fill_n(m_symbols, SuperCoder::symbols(), true);
+
+            return sak::storage(m_data, SuperCoder::block_size());
         }
 
         /// @copydoc layer::set_symbols(const sak::const_storage&)
@@ -110,13 +141,13 @@ namespace kodo
                    SuperCoder::symbols() * SuperCoder::symbol_size());
 
             // Use the copy function
-            copy_storage(sak::storage(m_data), symbol_storage);
+            copy_storage(sak::storage(m_data, m_data_size), symbol_storage);
 
             // This will specify all symbols, also in the case
             // of partial data. If this is not desired then the
             // symbols need to be set individually.
             m_symbols_count = SuperCoder::symbols();
-            std::fill(m_symbols.begin(), m_symbols.end(), true);
+            std::fill_n(m_symbols, SuperCoder::symbols(), true);
         }
 
         /// @copydoc layer::set_symbol(uint32_t, const sak::const_storage&)
@@ -132,7 +163,8 @@ namespace kodo
 
             assert(index < SuperCoder::symbols());
 
-            sak::mutable_storage dest_data = sak::storage(m_data);
+            sak::mutable_storage dest_data =
+                sak::storage(m_data, m_data_size);
 
             uint32_t offset = index * SuperCoder::symbol_size();
             dest_data += offset;
@@ -161,7 +193,7 @@ namespace kodo
 
             /// Wrap our buffer in a storage object
             sak::const_storage src_storage =
-                sak::storage(&m_data[0], data_to_copy);
+                sak::storage(m_data, data_to_copy);
 
             /// Use the copy_storage() function to copy the data
             sak::copy_storage(dest_storage, src_storage);
@@ -242,16 +274,16 @@ namespace kodo
     private:
 
         /// Storage for the symbol data
-        std::vector<uint8_t> m_data;
+        uint8_t* m_data;
+
+        /// The size in bytes of the symbol data storage
+        uint32_t m_data_size;
 
         /// Symbols count
         uint32_t m_symbols_count;
 
         /// Tracks which symbols have been set
-        std::vector<bool> m_symbols;
+        bool* m_symbols;
 
     };
 }
-
-
-
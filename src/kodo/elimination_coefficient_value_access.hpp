@@ -7,6 +7,8 @@
 
 #include <cstdint>
 
+#include <boost/optional.hpp>
+
 #include "coefficient_value_access.hpp"
 
 namespace kodo
@@ -75,6 +77,42 @@ namespace kodo
             SuperCoder::set_coefficient_value(coefficients, index, value);
         }
 
+        /// @copydoc coefficient_value_access::first_nonzero_coefficient(
+        ///             const value_type*, uint32_t, uint32_t) const
+        boost::optional<uint32_t> first_nonzero_coefficient(
+            const value_type* coefficients, uint32_t first,
+            uint32_t last) const
+        {
+            assert(last < SuperCoder::symbols());
+            uint32_t offset = SuperCoder::elimination_offset();
+
+            auto index = SuperCoder::first_nonzero_coefficient(
+                coefficients, first + offset, last + offset);
+
+            if(!index)
+                return boost::none;
+
+            return boost::optional<uint32_t>(*index - offset);
+        }
+
+        /// @copydoc coefficient_value_access::last_nonzero_coefficient(
+        ///             const value_type*, uint32_t, uint32_t) const
+        boost::optional<uint32_t> last_nonzero_coefficient(
+            const value_type* coefficients, uint32_t first,
+            uint32_t last) const
+        {
+            assert(last < SuperCoder::symbols());
+            uint32_t offset = SuperCoder::elimination_offset();
+
+            auto index = SuperCoder::last_nonzero_coefficient(
+                coefficients, first + offset, last + offset);
+
+            if(!index)
+                return boost::none;
+
+            return boost::optional<uint32_t>(*index - offset);
+        }
+
     };
 
 }
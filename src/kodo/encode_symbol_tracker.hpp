@@ -15,6 +15,11 @@ namespace kodo
     template<class SuperCoder>
     class encode_symbol_tracker : public SuperCoder
     {
+    public:
+
+        /// @copydoc layer::value_type
+        typedef typename SuperCoder::value_type value_type;
+
     public:
 
         /// Constructor
@@ -44,6 +49,15 @@ namespace kodo
             ++m_counter;
         }
 
+        /// @copydoc layer::encode_nonzero(uint8_t*, const uint32_t*,
+        ///                               const value_type*, uint32_t)
+        void encode_nonzero(uint8_t *symbol_data, const uint32_t *indices,
+                            const value_type *values, uint32_t count)
+        {
+            SuperCoder::encode_nonzero(symbol_data, indices, values, count);
+            ++m_counter;
+        }
+
         /// @return the symbol encoded counter
         uint32_t encode_symbol_count() const
         {
@@ -62,10 +62,10 @@ namespace kodo
             (void) symbols;
         }
 
-        /// @copydoc layer::swap_symbols(std::vector<uint8_t>&)
-        void swap_symbols(std::vector<uint8_t> &symbols)
+        /// @copydoc layer::set_symbols_in_place()
+        sak::mutable_storage set_symbols_in_place()
         {
-            (void) symbols;
+            return sak::mutable_storage();
         }
 
     };
@@ -0,0 +1,140 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+
+#include <fifi/fifi_utils.hpp>
+
+#include "xoshiro256_star_star.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup coefficient_generator_layers
+    /// @brief Generates an uniform random coefficient (from the chosen
+    /// Finite Field) for every symbol using the xoshiro256** generator.
+    ///
+    /// The uniform_generator draws one value from the mt19937 per
+    /// coefficient byte and has to initialize the full mt19937 state
+    /// whenever it is seeded, which with the seed_symbol_id_reader
+    /// happens for every received symbol. This layer fills the
+    /// coefficient vector 8 bytes at a time and is seeded with a few
+    /// arithmetic operations. The 64 bit values are written least
+    /// significant byte first, so the coefficients generated from a
+    /// seed do not depend on the byte order of the host.
+    ///
+    /// The generated coefficients differ from those of the
+    /// uniform_generator, so the encoder and decoder must both use
+    /// this layer. Stacks which must stay compatible with existing
+    /// peers should keep using the uniform_generator.
+    template<class SuperCoder>
+    class fast_uniform_generator : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::value_type
+        typedef typename SuperCoder::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename SuperCoder::value_type value_type;
+
+        /// The random generator used
+        typedef xoshiro256_star_star generator_type;
+
+        /// @copydoc layer::seed_type
+        ///
+        /// The seed type is kept at 32 bit to match the size of the
+        /// seed written by the seed_symbol_id_writer for the
+        /// uniform_generator.
+        typedef uint32_t seed_type;
+
+    public:
+
+        /// @copydoc layer::generate(uint8_t*)
+        void generate(uint8_t *coefficients)
+        {
+            assert(coefficients != 0);
+
+            uint32_t size = SuperCoder::coefficient_vector_size();
+            uint32_t i = 0;
+
+            for(; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+            {
+                write_little_endian(coefficients + i, m_random_generator(),
+                                    sizeof(uint64_t));
+            }
+
+            if(i < size)
+            {
+                write_little_endian(coefficients + i, m_random_generator(),
+                                    size - i);
+            }
+        }
+
+        /// @copydoc layer::generate(uint8_t*)
+        void generate_partial(uint8_t *coefficients)
+        {
+            assert(coefficients != 0);
+
+            // Since we will not set all coefficients we should ensure
+            // that the non specified ones are zero
+            std::fill_n(coefficients, SuperCoder::coefficient_vector_size(), 0);
+
+            value_type *c = reinterpret_cast<value_type*>(coefficients);
+
+            uint32_t symbols = SuperCoder::symbols();
+
+            // The 64 random bits make the bias of the modulo negligible
+            uint64_t range = uint64_t(field_type::max_value) -
+                uint64_t(field_type::min_value) + 1;
+
+            for(uint32_t i = 0; i < symbols; ++i)
+            {
+                if(!SuperCoder::can_generate(i))
+                {
+                    continue;
+                }
+
+                value_type coefficient = static_cast<value_type>(
+                    field_type::min_value + m_random_generator() % range);
+
+                fifi::set_value<field_type>(c, i, coefficient);
+            }
+        }
+
+        /// @copydoc layer::seed(seed_type)
+        void seed(seed_type seed_value)
+        {
+            m_random_generator.seed(seed_value);
+        }
+
+    private:
+
+        /// Writes the lowest bytes of a value, least significant byte
+        /// first
+        /// @param buffer The destination buffer
+        /// @param value The value to write
+        /// @param bytes The number of bytes to write
+        static void write_little_endian(uint8_t *buffer, uint64_t value,
+                                        uint32_t bytes)
+        {
+            assert(bytes <= sizeof(uint64_t));
+
+            for(uint32_t k = 0; k < bytes; ++k)
+            {
+                buffer[k] = static_cast<uint8_t>(value >> (8 * k));
+            }
+        }
+
+    private:
+
+        /// The random generator
+        generator_type m_random_generator;
+
+    };
+}
@@ -0,0 +1,124 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+#include <sak/storage.hpp>
+
+#include "object_decoder.hpp"
+#include "mapped_file.hpp"
+#include "has_shallow_symbol_storage.hpp"
+#include "rfc5052_partitioning_scheme.hpp"
+
+namespace kodo
+{
+
+    /// @brief A file decoder creates a number of decoders which decode
+    ///        directly into a file.
+    ///
+    /// The file decoder is the counterpart of the file_encoder. The
+    /// destination file is created with the size of the object and
+    /// mapped read-write, and every decoder uses the part of the
+    /// mapping covering its block as symbol storage. The decoded
+    /// symbols are therefore written straight into the page cache and
+    /// the object never has to be held in memory by the application.
+    /// Once a block has been decoded, release() drops its pages from
+    /// the process, so the memory used is bounded by the blocks being
+    /// decoded rather than by the file size.
+    ///
+    /// The decoders must use mutable shallow storage, e.g. the
+    /// shallow_full_rlnc_decoder. The mapping covers the last block
+    /// completely, the file is truncated to the object size when the
+    /// file decoder is destroyed. The decoders may not be used after
+    /// that. Only available on POSIX platforms.
+    template
+    <
+        class DecoderType,
+        class BlockPartitioning = rfc5052_partitioning_scheme
+    >
+    class file_decoder : public object_decoder<DecoderType, BlockPartitioning>
+    {
+    public:
+
+        static_assert(has_mutable_shallow_symbol_storage<DecoderType>::value,
+                      "The file decoder only works with decoders using "
+                      "mutable shallow storage");
+
+        /// The object decoder type
+        typedef object_decoder<DecoderType, BlockPartitioning> Super;
+
+        /// The type of factory used to build decoders
+        typedef typename Super::factory factory;
+
+        /// Pointer to a decoder
+        typedef typename Super::pointer pointer;
+
+    public:
+
+        /// Constructs a new file decoder
+        /// @param factory The decoder factory to use
+        /// @param filename The file to create
+        /// @param object_size The size in bytes of the object to be decoded
+        file_decoder(factory &decoder_factory, const std::string &filename,
+                     uint64_t object_size)
+            : Super(decoder_factory, object_size)
+        {
+            uint32_t last_block = m_partitioning.blocks() - 1;
+
+            uint64_t mapping_size =
+                m_partitioning.byte_offset(last_block) +
+                m_partitioning.block_size(last_block);
+
+            m_file = boost::make_shared<mapped_file>(
+                filename, object_size, mapping_size);
+        }
+
+        /// Builds a specific decoder, which decodes into the file
+        /// @param decoder_id Specifies the decoder to build
+        /// @return The initialized decoder
+        pointer build(uint32_t decoder_id)
+        {
+            pointer decoder = Super::build(decoder_id);
+
+            uint64_t offset = m_partitioning.byte_offset(decoder_id);
+            uint32_t block_size = m_partitioning.block_size(decoder_id);
+
+            assert(block_size == decoder->block_size());
+
+            decoder->set_symbols(sak::storage(
+                m_file->mutable_data() + offset, block_size));
+
+            return decoder;
+        }
+
+        /// Drops the pages of a block from the process. The decoded
+        /// data stays in the page cache and is written to the file by
+        /// the kernel. The decoder of the block may still be used, in
+        /// which case the pages are loaded again.
+        /// @param decoder_id Specifies the block to release
+        void release(uint32_t decoder_id)
+        {
+            assert(decoder_id < m_partitioning.blocks());
+
+            m_file->dont_need(m_partitioning.byte_offset(decoder_id),
+                              m_partitioning.block_size(decoder_id));
+        }
+
+    protected:
+
+        /// Access the block partitioning scheme
+        using Super::m_partitioning;
+
+        /// The destination file
+        boost::shared_ptr<mapped_file> m_file;
+    };
+
+}
@@ -7,6 +7,12 @@
 
 #include <fstream>
 #include <cassert>
+#include <string>
+
+#include <sak/storage.hpp>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
 
 #include "has_deep_symbol_storage.hpp"
 
@@ -40,10 +46,11 @@ namespace kodo
 
         /// Construct a new file reader
         /// @param filename of the file to use
-        /// @param data_size the number of bytes needed by the temporary
-        ///        memory buffer to be used with encoder->swap_symbols()
+        /// @param data_size the maximum number of bytes read into an
+        ///        encoder
         file_reader(const std::string &filename,
                     uint32_t data_size)
+            : m_data_size(data_size)
         {
             m_file = boost::make_shared<std::ifstream>();
             m_file->open(filename, std::ios::binary);
@@ -61,15 +68,13 @@ namespace kodo
             auto position = m_file->tellg();
             assert(position >= 0);
 
-            m_file_size = static_cast<uint32_t>(position);
+            m_file_size = static_cast<uint64_t>(position);
             assert(m_file_size > 0);
-            assert(data_size > 0);
-
-            m_data.resize(data_size);
+            assert(m_data_size > 0);
         }
 
         /// @return the size in bytes of the file
-        uint32_t size() const
+        uint64_t size() const
         {
             return m_file_size;
         }
@@ -78,7 +83,7 @@ namespace kodo
         /// @param encoder to be initialized
         /// @param offset in bytes into the storage object
         /// @param size the number of bytes to use
-        void read(pointer &encoder, uint32_t offset, uint32_t size)
+        void read(pointer &encoder, uint64_t offset, uint32_t size)
         {
             assert(encoder);
             assert(offset < m_file_size);
@@ -86,22 +91,21 @@ namespace kodo
             assert(m_file);
             assert(m_file->is_open());
 
-            auto data_size = m_data.size();
-            assert(size <= data_size);
+            assert(size <= m_data_size);
 
-            uint32_t remaining_bytes = m_file_size - offset;
+            uint64_t remaining_bytes = m_file_size - offset;
             assert(size <= remaining_bytes);
 
-            m_file->seekg(offset, std::ios::beg);
+            m_file->seekg(static_cast<std::streamoff>(offset), std::ios::beg);
             assert(m_file);
 
-            m_file->read(reinterpret_cast<char*>(&m_data[0]), size);
-            assert(size == static_cast<uint32_t>(m_file->gcount()));
-
-            encoder->swap_symbols(m_data);
+            // Read straight into the symbol storage of the encoder,
+            // this avoids any additional copies of the data
+            sak::mutable_storage symbols = encoder->set_symbols_in_place();
+            assert(size <= symbols.m_size);
 
-            // Check that the swapped vector has the same size
-            assert(m_data.size() == data_size);
+            m_file->read(reinterpret_cast<char*>(symbols.m_data), size);
+            assert(size == static_cast<uint32_t>(m_file->gcount()));
 
             // We require that encoders includes the has_bytes_used
             // layer to support partially filled encoders
@@ -114,12 +118,10 @@ namespace kodo
         boost::shared_ptr<std::ifstream> m_file;
 
         /// The size of the file in bytes
-        uint32_t m_file_size;
+        uint64_t m_file_size;
 
-        /// Intermediate buffer used for reading from the file and
-        /// swapping into the encoders - avoid any additional copies of
-        /// the data.
-        std::vector<uint8_t> m_data;
+        /// The maximum number of bytes read into an encoder
+        uint32_t m_data_size;
 
     };
 
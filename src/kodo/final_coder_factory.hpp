@@ -10,6 +10,8 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 
+#include "coder_arena.hpp"
+
 namespace kodo
 {
 
@@ -70,12 +72,26 @@ namespace kodo
 
     public:
 
+        /// Lays out the buffers of all layers in a single allocation.
+        /// This runs before the construct() functions of the layers
+        /// above, which find their buffers already in place.
         /// @copydoc layer::construct(Factory&)
         template<class Factory>
         void construct(Factory &the_factory)
         {
-            /// This is the final factory layer so we do nothing
+            FinalType *coder = static_cast<FinalType*>(this);
+
+            m_arena.allocate([&](coder_arena &arena)
+                { coder->layout(the_factory, arena); });
+        }
+
+        /// @copydoc layer::layout(Factory&,coder_arena&)
+        template<class Factory>
+        void layout(Factory &the_factory, coder_arena &arena)
+        {
+            // This is the final layer so we do nothing
             (void) the_factory;
+            (void) arena;
         }
 
         /// @copydoc layer::initialize(Factory&)
@@ -86,6 +102,12 @@ namespace kodo
             (void) the_factory;
         }
 
+        /// @copydoc layer::memory_footprint() const
+        uint64_t memory_footprint() const
+        {
+            return sizeof(FinalType) + m_arena.memory_footprint();
+        }
+
     protected:
 
         /// Constructor
@@ -104,7 +126,10 @@ namespace kodo
         /// Copy assignment
         const final_coder_factory& operator=(
             const final_coder_factory&);
-    };
-}
 
+    private:
 
+        /// The single allocation holding the buffers of the layers
+        coder_arena_storage m_arena;
+    };
+}
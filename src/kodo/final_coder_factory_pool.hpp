@@ -11,7 +11,9 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 
-#include <sak/resource_pool.hpp>
+#include "coder_arena.hpp"
+
+#include "concurrent_resource_pool.hpp"
 
 namespace kodo
 {
@@ -20,6 +22,11 @@ namespace kodo
     /// Terminates the layered coder and contains the coder final
     /// factory. The pool factory uses a memory pool to recycle
     /// encoders/decoders, and thereby minimize memory consumption.
+    ///
+    /// The pool is thread-safe, so coders may be built from several
+    /// threads through build(uint32_t,uint32_t), which does not depend
+    /// on the symbols and symbol size set on the factory, and released
+    /// from any thread.
     template<class FinalType>
     class final_coder_factory_pool
     {
@@ -57,14 +64,32 @@ namespace kodo
                 return coder;
             }
 
+            /// Builds a coder with the given number of symbols and
+            /// symbol size. The values set with set_symbols() and
+            /// set_symbol_size() are neither used nor changed, so this
+            /// function may be called from several threads at once.
+            /// @param symbols The number of symbols of the coder
+            /// @param symbol_size The size of a symbol in bytes
+            /// @return The initialized coder
+            pointer build(uint32_t symbols, uint32_t symbol_size)
+            {
+                factory_type *this_factory =
+                    static_cast<factory_type*>(this);
+
+                typename factory_type::build_scope scope(
+                    *this_factory, symbols, symbol_size);
+
+                return build();
+            }
+
             /// @return A reference to the internal resource pool
-            const sak::resource_pool<FinalType>& pool() const
+            const concurrent_resource_pool<FinalType>& pool() const
             {
                 return m_pool;
             }
 
             /// @return A reference to the internal resource pool
-            sak::resource_pool<FinalType>& pool()
+            concurrent_resource_pool<FinalType>& pool()
             {
                 return m_pool;
             }
@@ -99,18 +124,32 @@ namespace kodo
         private:
 
             /// Resource pool for the coders
-            sak::resource_pool<FinalType> m_pool;
+            concurrent_resource_pool<FinalType> m_pool;
 
         };
 
     public:
 
+        /// Lays out the buffers of all layers in a single allocation.
+        /// This runs before the construct() functions of the layers
+        /// above, which find their buffers already in place.
         /// @copydoc layer::construct(Factory&)
         template<class Factory>
         void construct(Factory& the_factory)
         {
-            // This is the final factory layer so we do nothing
+            FinalType *coder = static_cast<FinalType*>(this);
+
+            m_arena.allocate([&](coder_arena& arena)
+                { coder->layout(the_factory, arena); });
+        }
+
+        /// @copydoc layer::layout(Factory&,coder_arena&)
+        template<class Factory>
+        void layout(Factory& the_factory, coder_arena& arena)
+        {
+            // This is the final layer so we do nothing
             (void) the_factory;
+            (void) arena;
         }
 
         /// @copydoc layer::initialize(Factory&)
@@ -121,6 +160,12 @@ namespace kodo
             (void) the_factory;
         }
 
+        /// @copydoc layer::memory_footprint() const
+        uint64_t memory_footprint() const
+        {
+            return sizeof(FinalType) + m_arena.memory_footprint();
+        }
+
     protected:
 
         /// Constructor
@@ -140,5 +185,9 @@ namespace kodo
         const final_coder_factory_pool& operator=(
             const final_coder_factory_pool&);
 
+    private:
+
+        /// The single allocation holding the buffers of the layers
+        coder_arena_storage m_arena;
     };
 }
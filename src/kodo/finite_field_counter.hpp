@@ -7,6 +7,8 @@
 
 #include <cstdint>
 
+#include <fifi/is_binary.hpp>
+
 #include "operations_counter.hpp"
 
 namespace kodo
@@ -92,6 +94,42 @@ namespace kodo
                                  symbol_length);
         }
 
+        /// @copydoc layer::multiply_add_many(value_type*,
+        ///              const value_type* const*, const value_type*,
+        ///              uint32_t, uint32_t)
+        void multiply_add_many(value_type *symbol_dest,
+                               const value_type* const* symbols_src,
+                               const value_type *coefficients,
+                               uint32_t count, uint32_t symbol_length)
+        {
+            // Every source counts as one of the single source operations
+            if(fifi::is_binary<field_type>::value)
+                m_counter.m_add += count;
+            else
+                m_counter.m_multiply_add += count;
+
+            SuperCoder::multiply_add_many(symbol_dest, symbols_src,
+                                          coefficients, count, symbol_length);
+        }
+
+        /// @copydoc layer::multiply_subtract_many(value_type*,
+        ///              const value_type* const*, const value_type*,
+        ///              uint32_t, uint32_t)
+        void multiply_subtract_many(value_type *symbol_dest,
+                                    const value_type* const* symbols_src,
+                                    const value_type *coefficients,
+                                    uint32_t count, uint32_t symbol_length)
+        {
+            // Every source counts as one of the single source operations
+            if(fifi::is_binary<field_type>::value)
+                m_counter.m_subtract += count;
+            else
+                m_counter.m_multiply_subtract += count;
+
+            SuperCoder::multiply_subtract_many(symbol_dest, symbols_src,
+                coefficients, count, symbol_length);
+        }
+
         /// @copydoc layer::invert(value_type)
         value_type invert(value_type value)
         {
@@ -6,9 +6,11 @@
 #pragma once
 
 #include <cstdint>
+#include <algorithm>
 #include <type_traits>
 
 #include <fifi/fifi_utils.hpp>
+#include <fifi/is_binary.hpp>
 
 namespace kodo
 {
@@ -35,6 +37,12 @@ namespace kodo
         /// Pointer to coder produced by the factories
         typedef typename SuperCoder::pointer pointer;
 
+        /// The size in bytes of the part of the destination symbol
+        /// which is updated with all sources before moving on in the
+        /// multiply_add_many() and multiply_subtract_many() functions.
+        /// The destination tile should stay in the L1 cache.
+        static const uint32_t tile_size = 2048;
+
     private:
 
         /// The field type of the finite field implementation
@@ -176,6 +184,91 @@ namespace kodo
             m_field->region_subtract(symbol_dest, symbol_src, symbol_length);
         }
 
+        /// @copydoc layer::multiply_add_many(value_type*,
+        ///              const value_type* const*, const value_type*,
+        ///              uint32_t, uint32_t)
+        void multiply_add_many(value_type *symbol_dest,
+                               const value_type* const* symbols_src,
+                               const value_type *coefficients,
+                               uint32_t count, uint32_t symbol_length)
+        {
+            assert(m_field);
+            assert(symbol_dest != 0);
+            assert(symbols_src != 0);
+            assert(coefficients != 0);
+            assert(symbol_length > 0);
+
+            uint32_t tile_length = fifi::size_to_length<field_type>(tile_size);
+
+            for(uint32_t offset = 0; offset < symbol_length;
+                offset += tile_length)
+            {
+                uint32_t length = std::min(tile_length, symbol_length - offset);
+
+                for(uint32_t i = 0; i < count; ++i)
+                {
+                    assert(symbols_src[i] != 0);
+
+                    if(fifi::is_binary<field_type>::value)
+                    {
+                        m_field->region_add(symbol_dest + offset,
+                            symbols_src[i] + offset, length);
+                    }
+                    else
+                    {
+                        value_type coefficient =
+                            fifi::pack_constant<field_type>(coefficients[i]);
+
+                        m_field->region_multiply_add(symbol_dest + offset,
+                            symbols_src[i] + offset, coefficient, length);
+                    }
+                }
+            }
+        }
+
+        /// @copydoc layer::multiply_subtract_many(value_type*,
+        ///              const value_type* const*, const value_type*,
+        ///              uint32_t, uint32_t)
+        void multiply_subtract_many(value_type *symbol_dest,
+                                    const value_type* const* symbols_src,
+                                    const value_type *coefficients,
+                                    uint32_t count, uint32_t symbol_length)
+        {
+            assert(m_field);
+            assert(symbol_dest != 0);
+            assert(symbols_src != 0);
+            assert(coefficients != 0);
+            assert(symbol_length > 0);
+
+            uint32_t tile_length = fifi::size_to_length<field_type>(tile_size);
+
+            for(uint32_t offset = 0; offset < symbol_length;
+                offset += tile_length)
+            {
+                uint32_t length = std::min(tile_length, symbol_length - offset);
+
+                for(uint32_t i = 0; i < count; ++i)
+                {
+                    assert(symbols_src[i] != 0);
+                    assert(symbols_src[i] != symbol_dest);
+
+                    if(fifi::is_binary<field_type>::value)
+                    {
+                        m_field->region_subtract(symbol_dest + offset,
+                            symbols_src[i] + offset, length);
+                    }
+                    else
+                    {
+                        value_type coefficient =
+                            fifi::pack_constant<field_type>(coefficients[i]);
+
+                        m_field->region_multiply_subtract(symbol_dest + offset,
+                            symbols_src[i] + offset, coefficient, length);
+                    }
+                }
+            }
+        }
+
         /// @copydoc layer::invert(value_type)
         value_type invert(value_type value)
         {
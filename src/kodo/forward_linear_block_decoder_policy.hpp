@@ -55,6 +55,25 @@ namespace kodo
             ++m_start;
         }
 
+        /// Advances the policy to the next non-zero coefficient in the
+        /// remaining interval, or to the end if all remaining
+        /// coefficients are zero. The policy does not move if the
+        /// coefficient at the current index is non-zero.
+        /// @param coder The coder providing the coefficient value access
+        /// @param coefficients The coefficients being searched
+        template<class Coder, class ValueType>
+        void skip_zero_coefficients(const Coder& coder,
+                                    const ValueType* coefficients)
+        {
+            if(at_end())
+                return;
+
+            auto index = coder.first_nonzero_coefficient(
+                coefficients, m_start, m_stop);
+
+            m_start = index ? *index : m_stop + 1;
+        }
+
         /// @return the current index
         uint32_t index() const
         {
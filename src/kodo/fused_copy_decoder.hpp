@@ -0,0 +1,122 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+
+#include <fifi/is_binary.hpp>
+
+namespace kodo
+{
+
+    /// @ingroup decoder_layers
+    /// @brief Decodes encoded symbols from read-only buffers without
+    ///        first copying them.
+    ///
+    /// The linear block decoders reduce the encoded symbol in the
+    /// buffer passed in and finally copy the result into the symbol
+    /// storage, so a caller which needs to keep the payload has to copy
+    /// it before decoding, e.g. using the copy_payload_decoder. This
+    /// layer adds decode_symbol() overloads taking const symbol data.
+    /// The coding coefficients are reduced first while the operations
+    /// on the symbol data are deferred. Once the pivot is known the
+    /// symbol is written directly into its slot in the symbol storage
+    /// as the source minus the deferred symbols, in a single fused
+    /// pass, and the remaining elimination is performed in place. The
+    /// symbol data of non-innovative symbols is never touched.
+    ///
+    /// The coding coefficients are still reduced in place, they are
+    /// typically small and can be copied by the layers above. The layer
+    /// must be placed directly on top of a layer derived from the
+    /// bidirectional_linear_block_decoder, e.g. the
+    /// forward_linear_block_decoder.
+    template<class SuperCoder>
+    class fused_copy_decoder : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::field_type
+        typedef typename SuperCoder::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename SuperCoder::value_type value_type;
+
+        /// Access the direction policy used by the underlying decoder
+        typedef typename SuperCoder::direction_policy direction_policy;
+
+        /// Pull up the decode_symbol() functions
+        using SuperCoder::decode_symbol;
+
+    public:
+
+        /// @copydoc layer::decode_symbol(const uint8_t*,uint8_t*)
+        void decode_symbol(const uint8_t *symbol_data,
+                           uint8_t *symbol_coefficients)
+        {
+            assert(symbol_data != 0);
+            assert(symbol_coefficients != 0);
+
+            const value_type *src =
+                reinterpret_cast<const value_type*>(symbol_data);
+
+            value_type *coefficients =
+                reinterpret_cast<value_type*>(symbol_coefficients);
+
+            auto pivot_index =
+                SuperCoder::forward_substitute_coefficients_to_pivot(
+                    coefficients);
+
+            if(!pivot_index)
+            {
+                SuperCoder::discard_pending_symbols();
+                return;
+            }
+
+            uint32_t pivot = *pivot_index;
+
+            assert(SuperCoder::is_symbol_available(pivot));
+
+            // The storage of the pivot is free, so the first row
+            // operation writes its result there directly
+            value_type *symbol = SuperCoder::symbol_value(pivot);
+
+            SuperCoder::subtract_pending_symbols(symbol, src);
+
+            if(!fifi::is_binary<field_type>::value)
+            {
+                SuperCoder::normalize(symbol, coefficients, pivot);
+            }
+
+            SuperCoder::forward_substitute_from_pivot(
+                symbol, coefficients, pivot);
+
+            SuperCoder::backward_substitute(symbol, coefficients, pivot);
+
+            SuperCoder::store_coded_coefficients(coefficients, pivot);
+
+            m_maximum_pivot = direction_policy::max(pivot, m_maximum_pivot);
+
+            SuperCoder::update_symbol_status();
+        }
+
+        /// @copydoc layer::decode_symbol(const uint8_t*,uint32_t)
+        void decode_symbol(const uint8_t *symbol_data, uint32_t symbol_index)
+        {
+            assert(symbol_data != 0);
+
+            // The uncoded symbol is only read by the decoder
+            SuperCoder::decode_symbol(
+                const_cast<uint8_t*>(symbol_data), symbol_index);
+        }
+
+    protected:
+
+        /// Access the maximum pivot of the decoder
+        using SuperCoder::m_maximum_pivot;
+
+    };
+
+}
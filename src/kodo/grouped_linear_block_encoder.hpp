@@ -0,0 +1,257 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+#include <sak/aligned_allocator.hpp>
+
+#include <fifi/is_binary.hpp>
+
+#include "coder_arena.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup encoder_layers
+    /// @brief Linear block encoder which adds up the source symbols
+    ///        sharing a coefficient before multiplying.
+    ///
+    /// With more source symbols than field elements many source
+    /// symbols are combined using the same coefficient, e.g. for the
+    /// binary8 field with 1000 symbols every coefficient is on average
+    /// used about four times. Instead of one multiply_add() per source
+    /// symbol, this layer groups the source symbols by coefficient,
+    /// adds the symbols of every group together and multiplies the sum
+    /// once. The number of multiplications is thereby reduced from the
+    /// number of symbols to at most the number of non-zero field
+    /// elements. Source symbols which do not share their coefficient
+    /// with any other symbol are combined as in the
+    /// linear_block_encoder.
+    ///
+    /// For fields with at most 256 elements the source symbols are
+    /// grouped with a counting sort over a fixed table of the field
+    /// elements, so grouping costs O(k + q) for k symbols and q field
+    /// elements. Larger fields fall back to sorting the coefficients.
+    ///
+    /// For the binary field all coefficients are one and the layer
+    /// simply forwards to the layer below. The layer should be placed
+    /// on top of the linear_block_encoder.
+    template<class SuperCoder>
+    class grouped_linear_block_encoder : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::field_type
+        typedef typename SuperCoder::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename SuperCoder::value_type value_type;
+
+        /// Pull up the encode_symbol() functions
+        using SuperCoder::encode_symbol;
+
+        /// The number of entries in the table used to group the
+        /// symbols of small fields
+        static const uint32_t max_buckets = 256;
+
+        /// True if the symbols are grouped using the table
+        static const bool use_buckets =
+            field_type::max_value < max_buckets;
+
+    public:
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory& the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            m_sum.resize(the_factory.max_symbol_size());
+            m_groups.reserve(the_factory.max_symbols());
+            m_sources.reserve(the_factory.max_symbols());
+            m_coefficients.reserve(the_factory.max_symbols());
+        }
+
+        /// @copydoc layer::encode_symbol(uint8_t*, uint8_t*)
+        void encode_symbol(uint8_t *symbol_data, uint8_t *coefficients)
+        {
+            assert(symbol_data != 0);
+            assert(coefficients != 0);
+
+            if(fifi::is_binary<field_type>::value)
+            {
+                SuperCoder::encode_symbol(symbol_data, coefficients);
+                return;
+            }
+
+            value_type *symbol =
+                reinterpret_cast<value_type*>(symbol_data);
+
+            const value_type *c =
+                reinterpret_cast<const value_type*>(coefficients);
+
+            if(use_buckets)
+                bucket_groups(c);
+            else
+                sort_groups(c);
+
+            m_sources.clear();
+            m_coefficients.clear();
+
+            value_type *sum = reinterpret_cast<value_type*>(&m_sum[0]);
+            uint32_t length = SuperCoder::symbol_length();
+
+            for(auto first = m_groups.begin(); first != m_groups.end();)
+            {
+                value_type value = first->first;
+
+                auto last = first + 1;
+                while(last != m_groups.end() && last->first == value)
+                    ++last;
+
+                if(last - first == 1)
+                {
+                    // Nothing to share, combine it with the other
+                    // symbols having a unique coefficient
+                    m_sources.push_back(
+                        SuperCoder::symbol_value(first->second));
+                    m_coefficients.push_back(value);
+                }
+                else
+                {
+                    const value_type *symbol_first =
+                        SuperCoder::symbol_value(first->second);
+
+                    std::copy_n(symbol_first, length, sum);
+
+                    for(auto it = first + 1; it != last; ++it)
+                    {
+                        SuperCoder::add(sum,
+                            SuperCoder::symbol_value(it->second), length);
+                    }
+
+                    SuperCoder::multiply_add(symbol, sum, value, length);
+                }
+
+                first = last;
+            }
+
+            if(m_sources.empty())
+                return;
+
+            SuperCoder::multiply_add_many(symbol, &m_sources[0],
+                &m_coefficients[0], m_sources.size(), length);
+        }
+
+    protected:
+
+        /// Collects the non-zero coefficients in m_groups ordered by
+        /// value using a counting sort, only used for fields with at
+        /// most max_buckets elements
+        /// @param coefficients The coding coefficients
+        void bucket_groups(const value_type *coefficients)
+        {
+            assert(use_buckets);
+
+            m_buckets.fill(0);
+
+            for(uint32_t i = 0; i < SuperCoder::symbols(); ++i)
+            {
+                value_type value =
+                    SuperCoder::coefficient_value(coefficients, i);
+
+                ++m_buckets[value];
+            }
+
+            // The zero coefficients are not grouped
+            m_buckets[0] = 0;
+
+            // Turn the counts into the position of every bucket
+            uint32_t position = 0;
+
+            for(uint32_t value = 0; value < max_buckets; ++value)
+            {
+                uint32_t count = m_buckets[value];
+                m_buckets[value] = position;
+                position += count;
+            }
+
+            m_groups.resize(position);
+
+            for(uint32_t i = 0; i < SuperCoder::symbols(); ++i)
+            {
+                value_type value =
+                    SuperCoder::coefficient_value(coefficients, i);
+
+                if(!value)
+                    continue;
+
+                // Did you forget to set the data on the encoder?
+                assert(SuperCoder::symbol_value(i) != 0);
+
+                assert(SuperCoder::is_symbol_pivot(i));
+
+                m_groups[m_buckets[value]++] = std::make_pair(value, i);
+            }
+        }
+
+        /// Collects the non-zero coefficients in m_groups ordered by
+        /// value by sorting them
+        /// @param coefficients The coding coefficients
+        void sort_groups(const value_type *coefficients)
+        {
+            m_groups.clear();
+
+            for(uint32_t i = 0; i < SuperCoder::symbols(); ++i)
+            {
+                value_type value =
+                    SuperCoder::coefficient_value(coefficients, i);
+
+                if(!value)
+                    continue;
+
+                // Did you forget to set the data on the encoder?
+                assert(SuperCoder::symbol_value(i) != 0);
+
+                assert(SuperCoder::is_symbol_pivot(i));
+
+                m_groups.push_back(std::make_pair(value, i));
+            }
+
+            std::sort(m_groups.begin(), m_groups.end());
+        }
+
+    protected:
+
+        /// The storage type used for the sum of a group
+        typedef std::vector<uint8_t, sak::aligned_allocator<
+            uint8_t, coder_arena::vector_alignment> > aligned_vector;
+
+        /// The sum of the source symbols in a group
+        aligned_vector m_sum;
+
+        /// The non-zero coefficients and the index of their source
+        /// symbol, sorted by coefficient
+        std::vector<std::pair<value_type, uint32_t> > m_groups;
+
+        /// The number of symbols per coefficient value and later the
+        /// position of the next symbol of every value in m_groups
+        std::array<uint32_t, max_buckets> m_buckets;
+
+        /// The source symbols with a unique coefficient
+        std::vector<const value_type*> m_sources;
+
+        /// The unique coefficients
+        std::vector<value_type> m_coefficients;
+
+    };
+
+}
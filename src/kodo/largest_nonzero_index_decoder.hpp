@@ -123,18 +123,14 @@ namespace kodo
             // non-zero element.
             assert(SuperCoder::symbols() > m_largest_nonzero_index);
 
-            for (uint32_t i = SuperCoder::symbols();
-                 i --> m_largest_nonzero_index;)
+            auto index = SuperCoder::last_nonzero_coefficient(
+                coefficients, m_largest_nonzero_index,
+                SuperCoder::symbols() - 1);
+
+            if (index)
             {
-                value_type current_coefficient
-                    = SuperCoder::coefficient_value(coefficients, i);
-
-                if (current_coefficient)
-                {
-                    m_nonzero_seen = true;
-                    m_largest_nonzero_index = i;
-                    break;
-                }
+                m_nonzero_seen = true;
+                m_largest_nonzero_index = *index;
             }
 
             SuperCoder::decode_symbol(symbol_data, symbol_coefficients);
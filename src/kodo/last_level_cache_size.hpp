@@ -0,0 +1,45 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace kodo
+{
+
+    /// The cache size in bytes assumed when the size of the last level
+    /// cache cannot be detected
+    const uint32_t default_last_level_cache_size = 1U << 20;
+
+    /// Detects the size of the last level data cache of the processor.
+    /// The cache levels are queried through sysconf() where the C
+    /// library supports it, starting from the third level.
+    /// @return The size in bytes of the last level cache, or
+    ///         default_last_level_cache_size if it cannot be detected
+    inline uint32_t last_level_cache_size()
+    {
+#if defined(_SC_LEVEL3_CACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE)
+        long sizes[] =
+        {
+            ::sysconf(_SC_LEVEL3_CACHE_SIZE),
+            ::sysconf(_SC_LEVEL2_CACHE_SIZE)
+        };
+
+        for(long size : sizes)
+        {
+            // sysconf() returns zero or -1 for unknown or missing levels
+            if(size > 0)
+                return static_cast<uint32_t>(size);
+        }
+#endif
+        return default_last_level_cache_size;
+    }
+
+}
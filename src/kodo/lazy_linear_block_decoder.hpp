@@ -0,0 +1,529 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+#include <boost/optional.hpp>
+
+#include <sak/aligned_allocator.hpp>
+#include <sak/storage.hpp>
+
+#include <fifi/fifi_utils.hpp>
+#include <fifi/is_binary.hpp>
+
+#include "coder_arena.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup decoder_layers
+    /// @brief Linear block decoder which only performs the elimination
+    ///        on the coding coefficients and postpones all arithmetic
+    ///        on the symbol data until full rank is reached.
+    ///
+    /// Every stored coefficient vector is accompanied by a transform
+    /// vector describing it as a linear combination of the encoded
+    /// symbols received so far. The encoded symbols are stored
+    /// unmodified, and the transform is applied to them in a single
+    /// pass when the decoder becomes complete. Since the symbol data
+    /// is never touched during elimination, a non-innovative symbol
+    /// only costs operations on coefficient vectors.
+    ///
+    /// Until the decoder is complete only the symbols received uncoded
+    /// hold decoded data, the remaining stored symbols contain the
+    /// encoded symbols as received. The layer can therefore not be
+    /// used in stacks which recode or inspect partially decoded data.
+    template<class SuperCoder>
+    class lazy_linear_block_decoder : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::field_type
+        typedef typename SuperCoder::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename field_type::value_type value_type;
+
+        /// Access the direction policy used by the underlying decoder
+        typedef typename SuperCoder::direction_policy direction_policy;
+
+        /// The number of bytes the final transform processes of every
+        /// symbol at a time is chosen such that the output for all
+        /// symbols fits within this budget.
+        static const uint32_t transform_budget = 65536;
+
+    public:
+
+        /// Constructor
+        lazy_linear_block_decoder()
+            : m_tile_size(0)
+        { }
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory &the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            uint32_t max_symbols = the_factory.max_symbols();
+            uint32_t max_vector_size =
+                the_factory.max_coefficient_vector_size();
+
+            m_transforms.resize(max_symbols);
+
+            for(auto& transform : m_transforms)
+            {
+                transform.resize(max_vector_size);
+            }
+
+            m_transform.resize(max_vector_size);
+            m_coefficients.resize(max_vector_size);
+
+            // Choose the tile size as a multiple of the vector
+            // alignment which is a valid size for all fields
+            const uint32_t alignment = coder_arena::vector_alignment;
+
+            m_tile_size = (transform_budget / max_symbols) & ~(alignment - 1);
+            m_tile_size = std::max(m_tile_size, alignment);
+            m_tile_size = std::min(m_tile_size, static_cast<uint32_t>(
+                coder_arena::align_size(the_factory.max_symbol_size())));
+
+            m_tile.resize(max_symbols * m_tile_size);
+        }
+
+        /// @copydoc layer::decode_symbol(uint8_t*,uint8_t*)
+        void decode_symbol(uint8_t *symbol_data, uint8_t *coefficients)
+        {
+            assert(symbol_data != 0);
+            assert(coefficients != 0);
+
+            if(SuperCoder::is_complete())
+                return;
+
+            value_type *symbol_id =
+                reinterpret_cast<value_type*>(coefficients);
+
+            decode_coefficients(symbol_data, symbol_id);
+        }
+
+        /// @copydoc layer::decode_symbol(uint8_t*,uint32_t)
+        void decode_symbol(uint8_t *symbol_data, uint32_t symbol_index)
+        {
+            assert(symbol_index < SuperCoder::symbols());
+            assert(symbol_data != 0);
+
+            if(SuperCoder::is_complete())
+                return;
+
+            if(SuperCoder::is_symbol_decoded(symbol_index))
+                return;
+
+            value_type *symbol_id =
+                reinterpret_cast<value_type*>(&m_coefficients[0]);
+
+            std::fill_n(symbol_id,
+                        SuperCoder::coefficient_vector_length(), 0);
+
+            SuperCoder::set_coefficient_value(symbol_id, symbol_index, 1U);
+
+            if(SuperCoder::is_symbol_seen(symbol_index))
+            {
+                // The stored symbol in this position is referenced by
+                // the transforms so we cannot replace it. Instead the
+                // uncoded symbol is treated as any other encoded symbol.
+                decode_coefficients(symbol_data, symbol_id);
+                return;
+            }
+
+            value_type *transform =
+                reinterpret_cast<value_type*>(&m_transform[0]);
+
+            std::fill_n(transform,
+                        SuperCoder::coefficient_vector_length(), 0);
+
+            SuperCoder::set_coefficient_value(transform, symbol_index, 1U);
+
+            backward_substitute(symbol_id, transform, symbol_index);
+
+            store_symbol(symbol_data, symbol_id, transform, symbol_index);
+
+            // The symbol references only itself so it is already
+            // decoded
+            SuperCoder::set_symbol_decoded(symbol_index);
+
+            complete_decoding();
+        }
+
+        /// @return The transform vector of the symbol at the given index
+        /// @param index The index of the symbol
+        const uint8_t* transform_vector_data(uint32_t index) const
+        {
+            assert(index < SuperCoder::symbols());
+            return &(m_transforms[index])[0];
+        }
+
+    protected:
+
+        // Fetch the variables needed
+        using SuperCoder::m_maximum_pivot;
+
+    protected:
+
+        /// Eliminates the coding coefficients of an encoded symbol and
+        /// stores it if it is innovative.
+        /// @param symbol_data The data of the encoded symbol
+        /// @param symbol_id The coding coefficients of the encoded symbol
+        void decode_coefficients(const uint8_t *symbol_data,
+                                 value_type *symbol_id)
+        {
+            assert(symbol_data != 0);
+            assert(symbol_id != 0);
+
+            value_type *transform =
+                reinterpret_cast<value_type*>(&m_transform[0]);
+
+            std::fill_n(transform,
+                        SuperCoder::coefficient_vector_length(), 0);
+
+            auto pivot_index = forward_substitute_to_pivot(
+                symbol_id, transform);
+
+            if(!pivot_index)
+                return;
+
+            // The encoded symbol will be stored at the pivot position,
+            // which is not yet referenced by any transform
+            assert(!SuperCoder::coefficient_value(transform, *pivot_index));
+            SuperCoder::set_coefficient_value(transform, *pivot_index, 1U);
+
+            if(!fifi::is_binary<field_type>::value)
+            {
+                normalize(symbol_id, transform, *pivot_index);
+            }
+
+            forward_substitute_from_pivot(symbol_id, transform, *pivot_index);
+
+            backward_substitute(symbol_id, transform, *pivot_index);
+
+            store_symbol(symbol_data, symbol_id, transform, *pivot_index);
+
+            SuperCoder::set_symbol_seen(*pivot_index);
+
+            complete_decoding();
+        }
+
+        /// Normalizes the coefficients and transform such that the
+        /// coefficient at the pivot position is one
+        /// @param symbol_id The coding coefficients
+        /// @param transform The transform vector
+        /// @param pivot_index The pivot position
+        void normalize(value_type *symbol_id, value_type *transform,
+                       uint32_t pivot_index)
+        {
+            value_type coefficient =
+                SuperCoder::coefficient_value(symbol_id, pivot_index);
+
+            assert(coefficient > 0);
+
+            value_type inverted_coefficient =
+                SuperCoder::invert(coefficient);
+
+            SuperCoder::multiply(symbol_id, inverted_coefficient,
+                                 SuperCoder::coefficient_vector_length());
+
+            SuperCoder::multiply(transform, inverted_coefficient,
+                                 SuperCoder::coefficient_vector_length());
+        }
+
+        /// Subtracts the stored pivots from the coefficients until a
+        /// pivot is found
+        /// @param symbol_id The coding coefficients
+        /// @param transform The transform vector
+        /// @return the pivot index if found.
+        boost::optional<uint32_t> forward_substitute_to_pivot(
+            value_type *symbol_id, value_type *transform)
+        {
+            uint32_t start = direction_policy::min(0, SuperCoder::symbols()-1);
+            uint32_t end = direction_policy::max(0, SuperCoder::symbols()-1);
+
+            direction_policy p(start, end);
+
+            for(p.skip_zero_coefficients(*this, symbol_id); !p.at_end();
+                p.advance(), p.skip_zero_coefficients(*this, symbol_id))
+            {
+                uint32_t i = p.index();
+
+                value_type value =
+                    SuperCoder::coefficient_value(symbol_id, i);
+
+                assert(value);
+
+                if(!SuperCoder::is_symbol_pivot(i))
+                    return boost::optional<uint32_t>(i);
+
+                subtract_row(symbol_id, transform, i, value);
+            }
+
+            return boost::none;
+        }
+
+        /// Subtracts the stored pivots following the found pivot
+        /// @param symbol_id The coding coefficients
+        /// @param transform The transform vector
+        /// @param pivot_index The pivot position
+        void forward_substitute_from_pivot(value_type *symbol_id,
+                                           value_type *transform,
+                                           uint32_t pivot_index)
+        {
+            uint32_t end = direction_policy::max(0, SuperCoder::symbols()-1);
+
+            direction_policy p(pivot_index, end);
+
+            // Jump past the pivot_index position
+            p.advance();
+
+            for(p.skip_zero_coefficients(*this, symbol_id); !p.at_end();
+                p.advance(), p.skip_zero_coefficients(*this, symbol_id))
+            {
+                uint32_t i = p.index();
+
+                value_type value =
+                    SuperCoder::coefficient_value(symbol_id, i);
+
+                assert(value);
+
+                if(!SuperCoder::is_symbol_pivot(i))
+                    continue;
+
+                subtract_row(symbol_id, transform, i, value);
+            }
+        }
+
+        /// Removes the new pivot from the stored coded symbols
+        /// @param symbol_id The coding coefficients
+        /// @param transform The transform vector
+        /// @param pivot_index The pivot position
+        void backward_substitute(const value_type *symbol_id,
+                                 const value_type *transform,
+                                 uint32_t pivot_index)
+        {
+            uint32_t from = direction_policy::min(0, SuperCoder::symbols()-1);
+            uint32_t to = m_maximum_pivot;
+
+            for(direction_policy p(from, to); !p.at_end(); p.advance())
+            {
+                uint32_t i = p.index();
+
+                if(i == pivot_index)
+                    continue;
+
+                // Decoded symbols have no non-zero elements outside
+                // their pivot position
+                if(!SuperCoder::is_symbol_seen(i))
+                    continue;
+
+                value_type *vector_i =
+                    SuperCoder::coefficient_vector_values(i);
+
+                value_type value =
+                    SuperCoder::coefficient_value(vector_i, pivot_index);
+
+                if(!value)
+                    continue;
+
+                value_type *transform_i = transform_values(i);
+
+                if(fifi::is_binary<field_type>::value)
+                {
+                    SuperCoder::subtract(vector_i, symbol_id,
+                        SuperCoder::coefficient_vector_length());
+
+                    SuperCoder::subtract(transform_i, transform,
+                        SuperCoder::coefficient_vector_length());
+                }
+                else
+                {
+                    SuperCoder::multiply_subtract(vector_i, symbol_id, value,
+                        SuperCoder::coefficient_vector_length());
+
+                    SuperCoder::multiply_subtract(transform_i, transform,
+                        value, SuperCoder::coefficient_vector_length());
+                }
+            }
+        }
+
+        /// Subtracts a stored row from the coefficients and transform
+        /// @param symbol_id The coding coefficients
+        /// @param transform The transform vector
+        /// @param index The index of the stored row
+        /// @param value The coefficient the stored row is multiplied with
+        void subtract_row(value_type *symbol_id, value_type *transform,
+                          uint32_t index, value_type value)
+        {
+            const value_type *vector_i =
+                SuperCoder::coefficient_vector_values(index);
+
+            const value_type *transform_i = transform_values(index);
+
+            if(fifi::is_binary<field_type>::value)
+            {
+                SuperCoder::subtract(symbol_id, vector_i,
+                    SuperCoder::coefficient_vector_length());
+
+                SuperCoder::subtract(transform, transform_i,
+                    SuperCoder::coefficient_vector_length());
+            }
+            else
+            {
+                SuperCoder::multiply_subtract(symbol_id, vector_i, value,
+                    SuperCoder::coefficient_vector_length());
+
+                SuperCoder::multiply_subtract(transform, transform_i, value,
+                    SuperCoder::coefficient_vector_length());
+            }
+        }
+
+        /// Stores the encoded symbol data as received together with the
+        /// reduced coefficients and the transform
+        /// @param symbol_data The data of the encoded symbol
+        /// @param symbol_id The coding coefficients
+        /// @param transform The transform vector
+        /// @param pivot_index The pivot position
+        void store_symbol(const uint8_t *symbol_data,
+                          const value_type *symbol_id,
+                          const value_type *transform,
+                          uint32_t pivot_index)
+        {
+            assert(SuperCoder::is_symbol_missing(pivot_index));
+            assert(SuperCoder::is_symbol_available(pivot_index));
+
+            uint32_t vector_size = SuperCoder::coefficient_vector_size();
+
+            SuperCoder::set_coefficient_vector_data(
+                pivot_index, sak::storage(symbol_id, vector_size));
+
+            std::copy_n(reinterpret_cast<const uint8_t*>(transform),
+                        vector_size, &(m_transforms[pivot_index])[0]);
+
+            SuperCoder::copy_into_symbol(pivot_index,
+                sak::storage(symbol_data, SuperCoder::symbol_size()));
+
+            m_maximum_pivot =
+                direction_policy::max(pivot_index, m_maximum_pivot);
+        }
+
+        /// Applies the transforms to the stored symbols when the decoder
+        /// reaches full rank. The symbols are processed in tiles such
+        /// that the output for all symbols stays in cache while the
+        /// stored symbols are read.
+        void complete_decoding()
+        {
+            if(!SuperCoder::is_complete())
+                return;
+
+            uint32_t symbols = SuperCoder::symbols();
+            uint32_t symbol_length = SuperCoder::symbol_length();
+
+            uint32_t tile_length =
+                fifi::size_to_length<field_type>(m_tile_size);
+
+            for(uint32_t offset = 0; offset < symbol_length;
+                offset += tile_length)
+            {
+                uint32_t length = std::min(tile_length, symbol_length - offset);
+
+                for(uint32_t i = 0; i < symbols; ++i)
+                {
+                    // Symbols received uncoded are already decoded
+                    if(SuperCoder::is_symbol_decoded(i))
+                        continue;
+
+                    value_type *output = tile_values(i);
+                    std::fill_n(output, length, 0);
+
+                    const value_type *transform_i = transform_values(i);
+
+                    for(uint32_t j = 0; j < symbols; ++j)
+                    {
+                        value_type value =
+                            SuperCoder::coefficient_value(transform_i, j);
+
+                        if(!value)
+                            continue;
+
+                        const value_type *symbol_j =
+                            SuperCoder::symbol_value(j) + offset;
+
+                        if(fifi::is_binary<field_type>::value)
+                        {
+                            SuperCoder::add(output, symbol_j, length);
+                        }
+                        else
+                        {
+                            SuperCoder::multiply_add(
+                                output, symbol_j, value, length);
+                        }
+                    }
+                }
+
+                // All outputs of the tile have been computed, so the
+                // stored symbols may now be overwritten
+                for(uint32_t i = 0; i < symbols; ++i)
+                {
+                    if(SuperCoder::is_symbol_decoded(i))
+                        continue;
+
+                    std::copy_n(tile_values(i), length,
+                                SuperCoder::symbol_value(i) + offset);
+                }
+            }
+
+            SuperCoder::update_symbol_status();
+        }
+
+        /// @param index The index of the symbol
+        /// @return The transform vector of a stored symbol
+        value_type* transform_values(uint32_t index)
+        {
+            assert(index < SuperCoder::symbols());
+            return reinterpret_cast<value_type*>(&(m_transforms[index])[0]);
+        }
+
+        /// @param index The index of the symbol
+        /// @return The output buffer for a symbol in the current tile
+        value_type* tile_values(uint32_t index)
+        {
+            return reinterpret_cast<value_type*>(
+                &m_tile[index * m_tile_size]);
+        }
+
+    protected:
+
+        /// The storage type
+        typedef std::vector<uint8_t, sak::aligned_allocator<
+            uint8_t, coder_arena::vector_alignment> > aligned_vector;
+
+        /// The transform vectors of the stored symbols
+        std::vector<aligned_vector> m_transforms;
+
+        /// The transform of the symbol currently being decoded
+        aligned_vector m_transform;
+
+        /// Coefficient buffer used for uncoded symbols
+        aligned_vector m_coefficients;
+
+        /// Output buffer for the final transform
+        aligned_vector m_tile;
+
+        /// The size in bytes of one symbol in the output buffer
+        uint32_t m_tile_size;
+
+    };
+
+}
@@ -6,12 +6,14 @@
 #pragma once
 
 #include <cstdint>
+#include <cassert>
 
-#include <fifi/is_binary.hpp>
 #include <fifi/fifi_utils.hpp>
 
 #include <sak/storage.hpp>
 
+#include "coder_arena.hpp"
+
 namespace kodo
 {
 
@@ -20,7 +22,9 @@ namespace kodo
     ///
     /// This type of encoder iterates
     /// over a coefficient vector and combines symbols according
-    /// to the coefficients selected.
+    /// to the coefficients selected. All selected symbols are combined
+    /// using a single multiply_add_many() call, so the encoded symbol
+    /// is only traversed once.
     template<class SuperCoder>
     class linear_block_encoder : public SuperCoder
     {
@@ -34,6 +38,35 @@ namespace kodo
 
     public:
 
+        /// Constructor
+        linear_block_encoder()
+            : m_sources(0),
+              m_coefficients(0)
+        { }
+
+        /// @copydoc layer::layout(Factory&,coder_arena&)
+        template<class Factory>
+        void layout(Factory& the_factory, coder_arena& arena)
+        {
+            SuperCoder::layout(the_factory, arena);
+
+            m_sources =
+                arena.allocate<const value_type*>(the_factory.max_symbols());
+
+            m_coefficients =
+                arena.allocate<value_type>(the_factory.max_symbols());
+        }
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory& the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            assert(m_sources != 0);
+            assert(m_coefficients != 0);
+        }
+
         /// @copydoc layer::encode_symbol(uint8_t*,uint32_t)
         void encode_symbol(uint8_t *symbol_data, uint32_t symbol_index)
         {
@@ -60,6 +93,8 @@ namespace kodo
             const value_type *c =
                 reinterpret_cast<const value_type*>(coefficients);
 
+            uint32_t count = 0;
+
             for(uint32_t i = 0; i < SuperCoder::symbols(); ++i)
             {
                 value_type value = SuperCoder::coefficient_value(c, i);
@@ -76,19 +111,26 @@ namespace kodo
 
                 assert(SuperCoder::is_symbol_pivot(i));
 
-                if(fifi::is_binary<field_type>::value)
-                {
-                    SuperCoder::add(symbol, symbol_i,
-                                    SuperCoder::symbol_length());
-                }
-                else
-                {
-                    SuperCoder::multiply_add(symbol, symbol_i, value,
-                        SuperCoder::symbol_length());
-                }
+                m_sources[count] = symbol_i;
+                m_coefficients[count] = value;
+                ++count;
             }
+
+            if(count == 0)
+                return;
+
+            SuperCoder::multiply_add_many(symbol, m_sources,
+                m_coefficients, count, SuperCoder::symbol_length());
         }
 
+    private:
+
+        /// The symbols combined in the encoded symbol
+        const value_type** m_sources;
+
+        /// The coefficients of the symbols combined
+        value_type* m_coefficients;
+
     };
 
 }
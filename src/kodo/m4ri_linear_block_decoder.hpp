@@ -0,0 +1,345 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+#include <boost/optional.hpp>
+
+#include <sak/aligned_allocator.hpp>
+
+#include <fifi/binary.hpp>
+
+#include "coder_arena.hpp"
+#include "linear_block_decoder_delayed.hpp"
+#include "forward_linear_block_decoder_policy.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup decoder_layers
+    /// @brief Linear block decoder for the binary field which performs
+    ///        the final backward substitution using the Method of Four
+    ///        Russians (M4RI).
+    ///
+    /// As the linear_block_decoder_delayed the layer only brings the
+    /// coding matrix on echelon form while symbols arrive. Once full
+    /// rank is reached the columns are processed in groups of
+    /// group_size, starting from the last group. The symbols of a group
+    /// are first reduced among themselves, after which all their
+    /// 2^group_size combinations are computed in Gray code order, so
+    /// every combination costs a single symbol addition. Each symbol
+    /// above the group is then reduced with one addition of the
+    /// combination selected by its coefficients in the group, instead
+    /// of one addition per non-zero coefficient.
+    ///
+    /// Since the symbols of a group have zero coefficients in all
+    /// preceding columns, only the symbol data has to be updated with
+    /// the combinations, the coefficients of the group are simply
+    /// cleared.
+    ///
+    /// Only the backward substitution uses the tables. The forward
+    /// elimination still reduces every incoming symbol with one
+    /// addition per pivot it meets, so decoding remains O(n^3) and the
+    /// tables only reduce the cost of the backward pass. Using them in
+    /// the forward pass would require holding back the symbols until
+    /// enough have arrived, which would hide the rank from the layers
+    /// above.
+    ///
+    /// For small generations the cost of building the tables is not
+    /// recovered and the ordinary backward substitution is used.
+    ///
+    /// The layer replaces the linear_block_decoder_delayed layer and
+    /// must be placed on top of the forward_linear_block_decoder.
+    template<class SuperCoder>
+    class m4ri_linear_block_decoder :
+        public linear_block_decoder_delayed<SuperCoder>
+    {
+    public:
+
+        /// The actual super class
+        typedef linear_block_decoder_delayed<SuperCoder> Super;
+
+        /// @copydoc layer::field_type
+        typedef typename Super::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename Super::value_type value_type;
+
+        /// Access the direction policy used by the underlying decoder
+        typedef typename Super::direction_policy direction_policy;
+
+        /// The number of columns processed with one table
+        static const uint32_t group_size = 8;
+
+        /// The minimum number of symbols for which the tables are used
+        static const uint32_t minimum_symbols = 128;
+
+        static_assert(std::is_same<field_type, fifi::binary>::value,
+                      "The M4RI decoder only supports the binary field");
+
+        static_assert(std::is_same<direction_policy,
+                          forward_linear_block_decoder_policy>::value,
+                      "The M4RI decoder requires the forward "
+                      "linear block decoder");
+
+    public:
+
+        /// Constructor
+        m4ri_linear_block_decoder()
+            : m_table_stride(0)
+        { }
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory& the_factory)
+        {
+            Super::construct(the_factory);
+
+            m_table_stride = static_cast<uint32_t>(coder_arena::align_size(
+                the_factory.max_symbol_size()));
+
+            m_table.resize((1U << group_size) * m_table_stride);
+        }
+
+        /// @copydoc layer::decode_symbol(uint8_t*,uint8_t*)
+        void decode_symbol(uint8_t *symbol_data, uint8_t *coefficients)
+        {
+            assert(symbol_data != 0);
+            assert(coefficients != 0);
+
+            value_type *s =
+                reinterpret_cast<value_type*>(symbol_data);
+
+            value_type *c =
+                reinterpret_cast<value_type*>(coefficients);
+
+            decode_coefficients(s, c);
+        }
+
+        /// @copydoc layer::decode_symbol(uint8_t*,uint32_t)
+        void decode_symbol(uint8_t *symbol_data, uint32_t symbol_index)
+        {
+            assert(symbol_index < SuperCoder::symbols());
+            assert(symbol_data != 0);
+
+            if(SuperCoder::is_symbol_decoded(symbol_index))
+                return;
+
+            const value_type *symbol =
+                reinterpret_cast<const value_type*>(symbol_data);
+
+            if(SuperCoder::is_symbol_seen(symbol_index))
+            {
+                SuperCoder::swap_decode(symbol, symbol_index);
+            }
+            else
+            {
+                SuperCoder::store_uncoded_symbol(symbol, symbol_index);
+
+                m_maximum_pivot =
+                    direction_policy::max(symbol_index, m_maximum_pivot);
+            }
+
+            if(SuperCoder::is_complete())
+            {
+                final_backward_substitute();
+                SuperCoder::update_symbol_status();
+            }
+        }
+
+    protected:
+
+        // Fetch the variables needed
+        using Super::m_maximum_pivot;
+
+    protected:
+
+        /// @copydoc linear_block_decoder_delayed::decode_coefficients(
+        ///              value_type*,value_type*)
+        void decode_coefficients(value_type *symbol_data,
+                                 value_type *coefficients)
+        {
+            assert(symbol_data != 0);
+            assert(coefficients != 0);
+
+            boost::optional<uint32_t> pivot_index =
+                SuperCoder::forward_substitute_to_pivot(
+                    symbol_data, coefficients);
+
+            if(!pivot_index)
+                return;
+
+            SuperCoder::store_coded_symbol(
+                symbol_data, coefficients, *pivot_index);
+
+            m_maximum_pivot =
+                direction_policy::max(*pivot_index, m_maximum_pivot);
+
+            if(SuperCoder::is_complete())
+            {
+                final_backward_substitute();
+                SuperCoder::update_symbol_status();
+            }
+        }
+
+        /// Transforms the coding matrix from echelon form to reduced
+        /// echelon form using one table of combinations per group of
+        /// columns
+        void final_backward_substitute()
+        {
+            assert(SuperCoder::is_complete());
+
+            uint32_t symbols = SuperCoder::symbols();
+
+            if(symbols < minimum_symbols)
+            {
+                Super::final_backward_substitute();
+                return;
+            }
+
+            uint32_t groups = (symbols + group_size - 1) / group_size;
+
+            for(uint32_t group = groups; group --> 0;)
+            {
+                uint32_t first = group * group_size;
+                uint32_t width = std::min(group_size, symbols - first);
+
+                reduce_group(first, width);
+                build_table(first, width);
+
+                for(uint32_t i = 0; i < first; ++i)
+                {
+                    // Uncoded symbols have no coefficients to remove
+                    if(SuperCoder::is_symbol_decoded(i))
+                        continue;
+
+                    apply_table(i, first, width);
+                }
+            }
+        }
+
+        /// Reduces the symbols of a group such that their coefficients
+        /// in the group form the identity. The coefficients following
+        /// the group must already be zero.
+        /// @param first The first column of the group
+        /// @param width The number of columns in the group
+        void reduce_group(uint32_t first, uint32_t width)
+        {
+            for(uint32_t j = first + width; j --> first + 1;)
+            {
+                const value_type *vector_j =
+                    SuperCoder::coefficient_vector_values(j);
+
+                const value_type *symbol_j = SuperCoder::symbol_value(j);
+
+                for(uint32_t i = first; i < j; ++i)
+                {
+                    value_type *vector_i =
+                        SuperCoder::coefficient_vector_values(i);
+
+                    if(!SuperCoder::coefficient_value(vector_i, j))
+                        continue;
+
+                    SuperCoder::subtract(vector_i, vector_j,
+                        SuperCoder::coefficient_vector_length());
+
+                    SuperCoder::subtract(SuperCoder::symbol_value(i),
+                        symbol_j, SuperCoder::symbol_length());
+                }
+            }
+        }
+
+        /// Computes all combinations of the symbols in a group. The
+        /// combination at index k is the sum of the symbols whose bit
+        /// is set in k.
+        /// @param first The first column of the group
+        /// @param width The number of columns in the group
+        void build_table(uint32_t first, uint32_t width)
+        {
+            std::fill_n(table_entry(0), SuperCoder::symbol_length(), 0);
+
+            // Consecutive Gray codes differ in a single bit, so every
+            // combination is the previous one plus a single symbol
+            uint32_t previous = 0;
+
+            for(uint32_t k = 1; k < (1U << width); ++k)
+            {
+                uint32_t gray = k ^ (k >> 1);
+
+                uint32_t bit = 0;
+                while(((gray ^ previous) >> bit) != 1)
+                    ++bit;
+
+                value_type *entry = table_entry(gray);
+
+                std::copy_n(table_entry(previous),
+                            SuperCoder::symbol_length(), entry);
+
+                SuperCoder::add(entry, SuperCoder::symbol_value(first + bit),
+                                SuperCoder::symbol_length());
+
+                previous = gray;
+            }
+        }
+
+        /// Removes the coefficients of a group from a symbol using the
+        /// table of combinations
+        /// @param index The index of the symbol
+        /// @param first The first column of the group
+        /// @param width The number of columns in the group
+        void apply_table(uint32_t index, uint32_t first, uint32_t width)
+        {
+            value_type *vector =
+                SuperCoder::coefficient_vector_values(index);
+
+            uint32_t combination = 0;
+
+            for(uint32_t bit = 0; bit < width; ++bit)
+            {
+                if(!SuperCoder::coefficient_value(vector, first + bit))
+                    continue;
+
+                combination |= 1U << bit;
+                SuperCoder::set_coefficient_value(vector, first + bit, 0U);
+            }
+
+            if(!combination)
+                return;
+
+            SuperCoder::add(SuperCoder::symbol_value(index),
+                            table_entry(combination),
+                            SuperCoder::symbol_length());
+        }
+
+        /// @param combination The index of the combination
+        /// @return The symbol data of the combination
+        value_type* table_entry(uint32_t combination)
+        {
+            assert(combination < (1U << group_size));
+
+            return reinterpret_cast<value_type*>(
+                &m_table[combination * m_table_stride]);
+        }
+
+    protected:
+
+        /// The storage type
+        typedef std::vector<uint8_t, sak::aligned_allocator<
+            uint8_t, coder_arena::vector_alignment> > aligned_vector;
+
+        /// The combinations of the symbols in the current group
+        aligned_vector m_table;
+
+        /// The distance in bytes between two combinations
+        uint32_t m_table_stride;
+
+    };
+
+}
@@ -0,0 +1,202 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <limits>
+#include <string>
+
+#include <boost/noncopyable.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace kodo
+{
+
+    /// @brief Memory mapping of a file.
+    ///
+    /// The file is mapped in its entirety, so the data is read and
+    /// written directly in the page cache without being copied to or
+    /// from a user space buffer. The whole mapping is advised to be
+    /// accessed sequentially, and the pages of a range can be requested
+    /// ahead of use with will_need() or dropped from the process after
+    /// use with dont_need(). Files larger than 4 GiB are supported on
+    /// 64-bit platforms. Only available on POSIX platforms.
+    class mapped_file : boost::noncopyable
+    {
+    public:
+
+        /// Maps an existing file read-only
+        /// @param filename The file to map
+        mapped_file(const std::string &filename)
+            : m_data(0),
+              m_size(0),
+              m_mapping_size(0),
+              m_fd(-1)
+        {
+            int fd = ::open(filename.c_str(), O_RDONLY);
+            assert(fd >= 0);
+
+            struct stat status;
+            int result = ::fstat(fd, &status);
+            assert(result == 0);
+            (void) result;
+
+            assert(status.st_size > 0);
+
+            m_size = static_cast<uint64_t>(status.st_size);
+            m_mapping_size = m_size;
+
+            map(fd, PROT_READ);
+
+            // The mapping keeps its own reference to the file
+            ::close(fd);
+        }
+
+        /// Creates a file, or truncates an existing one, and maps it
+        /// read-write. The mapping may be larger than the file, e.g. to
+        /// cover a partially filled last block, in which case the file
+        /// is extended while mapped and truncated to its size once
+        /// unmapped.
+        /// @param filename The file to create
+        /// @param size The size of the file in bytes
+        /// @param mapping_size The size of the mapping in bytes
+        mapped_file(const std::string &filename, uint64_t size,
+                    uint64_t mapping_size)
+            : m_data(0),
+              m_size(size),
+              m_mapping_size(mapping_size),
+              m_fd(-1)
+        {
+            assert(m_size > 0);
+            assert(m_mapping_size >= m_size);
+
+            m_fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            assert(m_fd >= 0);
+
+            int result = ::ftruncate(m_fd, static_cast<off_t>(m_mapping_size));
+            assert(result == 0);
+            (void) result;
+
+            map(m_fd, PROT_READ | PROT_WRITE);
+        }
+
+        /// Unmaps the file
+        ~mapped_file()
+        {
+            ::munmap(m_data, m_mapping_size);
+
+            if(m_fd >= 0)
+            {
+                int result = ::ftruncate(m_fd, static_cast<off_t>(m_size));
+                assert(result == 0);
+                (void) result;
+
+                ::close(m_fd);
+            }
+        }
+
+        /// @return Pointer to the first byte of the file
+        const uint8_t *data() const
+        {
+            return m_data;
+        }
+
+        /// @return Pointer to the first byte of a file mapped read-write
+        uint8_t *mutable_data()
+        {
+            assert(m_fd >= 0);
+            return m_data;
+        }
+
+        /// @return The size of the file in bytes
+        uint64_t size() const
+        {
+            return m_size;
+        }
+
+        /// @return The size of the mapping in bytes
+        uint64_t mapping_size() const
+        {
+            return m_mapping_size;
+        }
+
+        /// Asks the kernel to start reading in a range of the file
+        /// @param offset The offset in bytes of the range
+        /// @param size The size in bytes of the range
+        void will_need(uint64_t offset, uint64_t size) const
+        {
+            advise(offset, size, MADV_WILLNEED);
+        }
+
+        /// Drops the pages of a range from the process. The pages stay
+        /// in the page cache, and changes to a file mapped read-write
+        /// are still written to the file.
+        /// @param offset The offset in bytes of the range
+        /// @param size The size in bytes of the range
+        void dont_need(uint64_t offset, uint64_t size) const
+        {
+            advise(offset, size, MADV_DONTNEED);
+        }
+
+    private:
+
+        /// Maps the file
+        /// @param fd The open file
+        /// @param protection The protection of the mapping
+        void map(int fd, int protection)
+        {
+            // The whole file must fit in the address space
+            assert(m_mapping_size <= std::numeric_limits<size_t>::max());
+
+            void *data = ::mmap(0, m_mapping_size, protection,
+                                MAP_SHARED, fd, 0);
+            assert(data != MAP_FAILED);
+
+            m_data = static_cast<uint8_t*>(data);
+
+            ::madvise(data, m_mapping_size, MADV_SEQUENTIAL);
+        }
+
+        /// Passes advice on a range of the mapping to the kernel
+        /// @param offset The offset in bytes of the range
+        /// @param size The size in bytes of the range
+        /// @param advice The advice passed to madvise()
+        void advise(uint64_t offset, uint64_t size, int advice) const
+        {
+            assert(offset < m_mapping_size);
+            assert(size <= m_mapping_size - offset);
+
+            // madvise() requires a page aligned address
+            uint64_t page_size = static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+            uint64_t aligned_offset = (offset / page_size) * page_size;
+
+            ::madvise(m_data + aligned_offset,
+                      size + (offset - aligned_offset), advice);
+        }
+
+    private:
+
+        /// The mapped data
+        uint8_t *m_data;
+
+        /// The size of the file in bytes
+        uint64_t m_size;
+
+        /// The size of the mapping in bytes
+        uint64_t m_mapping_size;
+
+        /// The file descriptor of a file mapped read-write, which is
+        /// kept open to truncate the file once unmapped
+        int m_fd;
+    };
+
+}
@@ -0,0 +1,57 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "object_encoder.hpp"
+#include "mmap_file_reader.hpp"
+#include "rfc5052_partitioning_scheme.hpp"
+
+namespace kodo
+{
+
+    /// @brief A mmap file encoder creates a number of encoders over
+    ///        the data of a memory mapped file.
+    ///
+    /// The mmap file encoder uses the specified block partitioning
+    /// scheme to allocate a number of encoders of a file. The encoders
+    /// must use const shallow storage, e.g. the
+    /// shallow_full_rlnc_encoder, since they point directly into the
+    /// mapping of the file.
+    template
+    <
+        class EncoderType,
+        class BlockPartitioning = rfc5052_partitioning_scheme
+    >
+    class mmap_file_encoder : public
+            object_encoder
+            <
+                mmap_file_reader<EncoderType>,
+                EncoderType,
+                BlockPartitioning
+            >
+    {
+    public:
+
+        /// The encoder factory type
+        typedef typename EncoderType::factory factory;
+
+    public:
+
+        /// Constructs a new mmap file encoder
+        /// @param factory the encoder factory to use
+        /// @param filename the file to encode
+        mmap_file_encoder(typename EncoderType::factory &factory,
+                          const std::string &filename)
+            : object_encoder
+                  <
+                  mmap_file_reader<EncoderType>,
+                  EncoderType,
+                  BlockPartitioning
+                  >
+              (factory, mmap_file_reader<EncoderType>(filename))
+            { }
+    };
+}
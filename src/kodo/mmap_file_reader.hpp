@@ -0,0 +1,103 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+#include <sak/storage.hpp>
+
+#include "has_shallow_symbol_storage.hpp"
+#include "mapped_file.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup object_data_implementation
+    ///
+    /// @brief The mmap file reader maps a local file into memory and
+    ///        initializes encoders with the mapped data at a specific
+    ///        offset within the file. This class can be used in
+    ///        conjunction with object encoders.
+    ///
+    /// Unlike the file_reader no data is copied, the encoders point
+    /// directly into the read-only mapping of the file and the pages are
+    /// loaded from the page cache as they are encoded. The pages of a
+    /// block are requested from the kernel when the encoder is
+    /// initialized.
+    ///
+    /// Note that this type of data reader can only be used together
+    /// with const shallow storage encoders, and unless the file size is
+    /// a multiple of the block size the encoder must use the
+    /// partial_shallow_symbol_storage. The encoders may not be used
+    /// after the reader and all its copies have been destroyed.
+    template<class EncoderType>
+    class mmap_file_reader
+    {
+    public:
+
+        static_assert(has_const_shallow_symbol_storage<EncoderType>::value,
+                      "The mmap file reader only works with encoders using "
+                      "const shallow storage");
+
+    public:
+
+        /// Pointer to the encoders
+        typedef typename EncoderType::pointer pointer;
+
+    public:
+
+        /// Construct a new mmap file reader
+        /// @param filename of the file to use
+        mmap_file_reader(const std::string &filename)
+        {
+            m_file = boost::make_shared<mapped_file>(filename);
+        }
+
+        /// @return the size in bytes of the file
+        uint64_t size() const
+        {
+            return m_file->size();
+        }
+
+        /// Initializes the encoder with data from the file.
+        /// @param encoder to be initialized
+        /// @param offset in bytes into the file
+        /// @param size the number of bytes to use
+        void read(pointer &encoder, uint64_t offset, uint32_t size)
+        {
+            assert(encoder);
+            assert(offset < m_file->size());
+            assert(size > 0);
+
+            uint64_t remaining_bytes = m_file->size() - offset;
+            assert(size <= remaining_bytes);
+
+            m_file->will_need(offset, size);
+
+            sak::const_storage storage;
+            storage.m_data = m_file->data() + offset;
+            storage.m_size = size;
+
+            encoder->set_symbols(storage);
+
+            // We require that encoders includes the has_bytes_used
+            // layer to support partially filled encoders
+            encoder->set_bytes_used(size);
+        }
+
+    private:
+
+        /// The mapped file shared by all copies of the reader
+        boost::shared_ptr<mapped_file> m_file;
+
+    };
+
+}
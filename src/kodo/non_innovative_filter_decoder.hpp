@@ -0,0 +1,175 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+#include <sak/aligned_allocator.hpp>
+
+#include <fifi/is_binary.hpp>
+
+#include "coder_arena.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup decoder_layers
+    /// @brief Drops non-innovative coded symbols before any operation
+    ///        is performed on the symbol data.
+    ///
+    /// The linear block decoders only discover that a coded symbol is
+    /// linearly dependent on the stored symbols once the forward
+    /// substitution has completed, at which point the symbol data has
+    /// been updated once for every non-zero coefficient. This layer
+    /// first reduces a copy of the coding coefficients with the stored
+    /// coefficient vectors. The reduction stops as soon as a non-zero
+    /// coefficient is found at a position without a pivot, in which
+    /// case the symbol is innovative and is passed on to the decoder.
+    /// Otherwise the symbol is dropped without touching the symbol
+    /// data and the non-innovative counter is incremented.
+    ///
+    /// The check requires that the stored coefficient vector at a pivot
+    /// position has a one at the pivot and zeros at all positions
+    /// preceding it in the search direction of the decoder. This holds
+    /// for the forward_linear_block_decoder and
+    /// backward_linear_block_decoder layers, also when combined with
+    /// the linear_block_decoder_delayed layer.
+    template<class SuperCoder>
+    class non_innovative_filter_decoder : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::field_type
+        typedef typename SuperCoder::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename SuperCoder::value_type value_type;
+
+        /// Access the direction policy used by the underlying decoder
+        typedef typename SuperCoder::direction_policy direction_policy;
+
+        /// Pull up the decode_symbol() functions
+        using SuperCoder::decode_symbol;
+
+    public:
+
+        /// Constructor
+        non_innovative_filter_decoder()
+            : m_non_innovative_symbols(0)
+        { }
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory& the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            m_coefficients.resize(
+                the_factory.max_coefficient_vector_size());
+        }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory& the_factory)
+        {
+            SuperCoder::initialize(the_factory);
+
+            m_non_innovative_symbols = 0;
+        }
+
+        /// @copydoc layer::decode_symbol(uint8_t*,uint8_t*)
+        void decode_symbol(uint8_t *symbol_data, uint8_t *coefficients)
+        {
+            assert(symbol_data != 0);
+            assert(coefficients != 0);
+
+            if(!is_innovative(coefficients))
+            {
+                ++m_non_innovative_symbols;
+                return;
+            }
+
+            SuperCoder::decode_symbol(symbol_data, coefficients);
+        }
+
+        /// @return The number of coded symbols dropped since they were
+        ///         not innovative
+        uint32_t non_innovative_symbols() const
+        {
+            return m_non_innovative_symbols;
+        }
+
+    protected:
+
+        /// Reduces a copy of the coding coefficients with the stored
+        /// coefficient vectors
+        /// @param coefficients The coding coefficients
+        /// @return True if the coefficients are linearly independent of
+        ///         the stored coefficient vectors
+        bool is_innovative(const uint8_t *coefficients)
+        {
+            if(SuperCoder::is_complete())
+                return false;
+
+            uint32_t size = SuperCoder::coefficient_vector_size();
+            assert(size <= m_coefficients.size());
+
+            std::copy_n(coefficients, size, m_coefficients.begin());
+
+            value_type *symbol_id =
+                reinterpret_cast<value_type*>(&m_coefficients[0]);
+
+            uint32_t start = direction_policy::min(0, SuperCoder::symbols()-1);
+            uint32_t end = direction_policy::max(0, SuperCoder::symbols()-1);
+
+            direction_policy p(start, end);
+
+            for(p.skip_zero_coefficients(*this, symbol_id); !p.at_end();
+                p.advance(), p.skip_zero_coefficients(*this, symbol_id))
+            {
+                uint32_t i = p.index();
+
+                if(!SuperCoder::is_symbol_pivot(i))
+                    return true;
+
+                value_type value =
+                    SuperCoder::coefficient_value(symbol_id, i);
+
+                const value_type *vector_i =
+                    SuperCoder::coefficient_vector_values(i);
+
+                if(fifi::is_binary<field_type>::value)
+                {
+                    SuperCoder::subtract(symbol_id, vector_i,
+                        SuperCoder::coefficient_vector_length());
+                }
+                else
+                {
+                    SuperCoder::multiply_subtract(symbol_id, vector_i, value,
+                        SuperCoder::coefficient_vector_length());
+                }
+            }
+
+            return false;
+        }
+
+    protected:
+
+        /// The storage type
+        typedef std::vector<uint8_t, sak::aligned_allocator<
+            uint8_t, coder_arena::vector_alignment> > aligned_vector;
+
+        /// Scratch copy of the coding coefficients
+        aligned_vector m_coefficients;
+
+        /// The number of non-innovative symbols dropped
+        uint32_t m_non_innovative_symbols;
+
+    };
+
+}
@@ -91,6 +91,24 @@ namespace kodo
                 m_data.size());
         }
 
+        /// Constructs a new object encoder using a given block layout.
+        /// This allows the parameters of the partitioning scheme, e.g.
+        /// the cache size of the cache_aware_partitioning_scheme, to be
+        /// chosen by the caller, who must make sure the decoder uses the
+        /// same layout.
+        /// @param factory the encoder factory to use
+        /// @param object the object to encode
+        /// @param partitioning the block layout of the object
+        object_encoder(factory_type &factory, const object_data &data,
+                       const block_partitioning &partitioning) :
+            m_factory(factory),
+            m_data(data),
+            m_partitioning(partitioning)
+        {
+            assert(m_data.size() > 0);
+            assert(m_partitioning.object_size() == m_data.size());
+        }
+
         /// @return The number of encoders which may be created for
         ///         this object
         uint32_t encoders() const
@@ -118,7 +136,7 @@ namespace kodo
             pointer_type encoder = m_factory.build();
 
             // Initialize encoder with data
-            uint32_t offset =
+            uint64_t offset =
                 m_partitioning.byte_offset(encoder_id);
 
             uint32_t bytes_used =
@@ -130,7 +148,7 @@ namespace kodo
         }
 
         /// @return The total size of the object to encode in bytes
-        uint32_t object_size() const
+        uint64_t object_size() const
         {
             return m_data.size();
         }
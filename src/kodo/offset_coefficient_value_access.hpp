@@ -7,6 +7,8 @@
 
 #include <cstdint>
 
+#include <boost/optional.hpp>
+
 #include <fifi/fifi_utils.hpp>
 
 #include "coefficient_value_access.hpp"
@@ -88,6 +90,40 @@ namespace kodo
             Super::set_coefficient_value(coefficients, index, value);
         }
 
+        /// @copydoc coefficient_value_access::first_nonzero_coefficient(
+        ///             const value_type*, uint32_t, uint32_t) const
+        boost::optional<uint32_t> first_nonzero_coefficient(
+            const value_type* coefficients, uint32_t first,
+            uint32_t last) const
+        {
+            assert(last + m_offset < SuperCoder::coefficients_elements());
+
+            auto index = Super::first_nonzero_coefficient(
+                coefficients, first + m_offset, last + m_offset);
+
+            if(!index)
+                return boost::none;
+
+            return boost::optional<uint32_t>(*index - m_offset);
+        }
+
+        /// @copydoc coefficient_value_access::last_nonzero_coefficient(
+        ///             const value_type*, uint32_t, uint32_t) const
+        boost::optional<uint32_t> last_nonzero_coefficient(
+            const value_type* coefficients, uint32_t first,
+            uint32_t last) const
+        {
+            assert(last + m_offset < SuperCoder::coefficients_elements());
+
+            auto index = Super::last_nonzero_coefficient(
+                coefficients, first + m_offset, last + m_offset);
+
+            if(!index)
+                return boost::none;
+
+            return boost::optional<uint32_t>(*index - m_offset);
+        }
+
         /// Sets the coefficient offset which will be added when accessing
         /// coefficient values
         /// @param offset The offset to add
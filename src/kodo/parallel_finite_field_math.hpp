@@ -0,0 +1,309 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+#include <fifi/fifi_utils.hpp>
+
+#include "stripe_thread_pool.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup finite_field_layers
+    /// @brief Splits the finite field operations on large symbols into
+    ///        stripes which are executed in parallel.
+    ///
+    /// The layer should be placed on top of the finite_field_math
+    /// layer. Every operation on a region of at least two stripes is
+    /// split into stripes of stripe_size bytes which are executed on a
+    /// thread pool shared by all coders built by the same factory.
+    /// Shorter regions, e.g. the coefficient vectors, are processed
+    /// directly by the calling thread, so the coefficient side of the
+    /// coding algorithms stays single threaded while the symbol data
+    /// is processed on all cores.
+    ///
+    /// By default the pool uses one thread less than the number of
+    /// hardware threads, since the calling thread also executes
+    /// stripes. The pool runs the stripes of one operation at a time,
+    /// an operation started while the pool is busy with another coder
+    /// is executed by the calling thread alone, see stripe_thread_pool.
+    ///
+    /// The source pointers of the *_many() operations are offset to a
+    /// stripe in a table allocated when the coder is initialized, with
+    /// one row per thread of the pool, so no memory is allocated while
+    /// coding.
+    template<class SuperCoder>
+    class parallel_finite_field_math : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::field_type
+        typedef typename SuperCoder::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename SuperCoder::value_type value_type;
+
+        /// Pointer to the thread pool
+        typedef boost::shared_ptr<stripe_thread_pool> pool_pointer;
+
+        /// The size in bytes of a stripe
+        static const uint32_t stripe_size = 16384;
+
+    public:
+
+        /// @ingroup factory_layers
+        /// The factory layer associated with this coder. The thread
+        /// pool is created by the factory and shared with all coders
+        class factory : public SuperCoder::factory
+        {
+        public:
+
+            /// @copydoc layer::factory::factory(uint32_t,uint32_t)
+            factory(uint32_t max_symbols, uint32_t max_symbol_size) :
+                SuperCoder::factory(max_symbols, max_symbol_size)
+            {
+                uint32_t threads = std::thread::hardware_concurrency();
+                m_pool = boost::make_shared<stripe_thread_pool>(
+                    threads > 1 ? threads - 1 : 0);
+            }
+
+            /// Replaces the thread pool used by coders built after this
+            /// call
+            /// @param threads The number of worker threads, zero
+            ///        disables the parallel execution
+            void set_worker_threads(uint32_t threads)
+            {
+                m_pool = boost::make_shared<stripe_thread_pool>(threads);
+            }
+
+            /// @return The number of worker threads used
+            uint32_t worker_threads() const
+            {
+                return m_pool->threads();
+            }
+
+        private:
+
+            /// Give the layer access
+            friend class parallel_finite_field_math;
+
+            /// @return The thread pool
+            pool_pointer pool()
+            {
+                return m_pool;
+            }
+
+        private:
+
+            /// The thread pool
+            pool_pointer m_pool;
+        };
+
+    public:
+
+        /// Constructor
+        parallel_finite_field_math()
+            : m_max_sources(0)
+        { }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory &the_factory)
+        {
+            SuperCoder::initialize(the_factory);
+
+            // Pick up a pool replaced with set_worker_threads()
+            m_pool = the_factory.pool();
+
+            // A recycled coder keeps the capacity of its table
+            m_max_sources = the_factory.max_symbols();
+            m_sources.resize((m_pool->threads() + 1) * m_max_sources);
+        }
+
+        /// @copydoc layer::multiply(value_type*,value_type,uint32_t)
+        void multiply(value_type *symbol_dest, value_type coefficient,
+                      uint32_t symbol_length)
+        {
+            run_striped(symbol_length,
+                [&](uint32_t offset, uint32_t length, uint32_t)
+                {
+                    this->SuperCoder::multiply(
+                        symbol_dest + offset, coefficient, length);
+                });
+        }
+
+        /// @copydoc layer::multipy_add(value_type *, const value_type*,
+        ///                             value_type, uint32_t)
+        void multiply_add(value_type *symbol_dest,
+                          const value_type *symbol_src,
+                          value_type coefficient, uint32_t symbol_length)
+        {
+            run_striped(symbol_length,
+                [&](uint32_t offset, uint32_t length, uint32_t)
+                {
+                    this->SuperCoder::multiply_add(symbol_dest + offset,
+                        symbol_src + offset, coefficient, length);
+                });
+        }
+
+        /// @copydoc layer::add(value_type*, const value_type *, uint32_t)
+        void add(value_type *symbol_dest, const value_type *symbol_src,
+                 uint32_t symbol_length)
+        {
+            run_striped(symbol_length,
+                [&](uint32_t offset, uint32_t length, uint32_t)
+                {
+                    this->SuperCoder::add(symbol_dest + offset,
+                        symbol_src + offset, length);
+                });
+        }
+
+        /// @copydoc layer::multiply_subtract(value_type*, const value_type*,
+        ///                                   value_type, uint32_t)
+        void multiply_subtract(value_type *symbol_dest,
+                               const value_type *symbol_src,
+                               value_type coefficient,
+                               uint32_t symbol_length)
+        {
+            run_striped(symbol_length,
+                [&](uint32_t offset, uint32_t length, uint32_t)
+                {
+                    this->SuperCoder::multiply_subtract(symbol_dest + offset,
+                        symbol_src + offset, coefficient, length);
+                });
+        }
+
+        /// @copydoc layer::subtract(value_type*,const value_type*, uint32_t)
+        void subtract(value_type *symbol_dest, const value_type *symbol_src,
+                      uint32_t symbol_length)
+        {
+            run_striped(symbol_length,
+                [&](uint32_t offset, uint32_t length, uint32_t)
+                {
+                    this->SuperCoder::subtract(symbol_dest + offset,
+                        symbol_src + offset, length);
+                });
+        }
+
+        /// @copydoc layer::multiply_add_many(value_type*,
+        ///              const value_type* const*, const value_type*,
+        ///              uint32_t, uint32_t)
+        void multiply_add_many(value_type *symbol_dest,
+                               const value_type* const* symbols_src,
+                               const value_type *coefficients,
+                               uint32_t count, uint32_t symbol_length)
+        {
+            run_striped(symbol_length,
+                [&](uint32_t offset, uint32_t length, uint32_t thread)
+                {
+                    this->SuperCoder::multiply_add_many(symbol_dest + offset,
+                        offset_sources(symbols_src, count, offset, thread),
+                        coefficients, count, length);
+                });
+        }
+
+        /// @copydoc layer::multiply_subtract_many(value_type*,
+        ///              const value_type* const*, const value_type*,
+        ///              uint32_t, uint32_t)
+        void multiply_subtract_many(value_type *symbol_dest,
+                                    const value_type* const* symbols_src,
+                                    const value_type *coefficients,
+                                    uint32_t count, uint32_t symbol_length)
+        {
+            run_striped(symbol_length,
+                [&](uint32_t offset, uint32_t length, uint32_t thread)
+                {
+                    this->SuperCoder::multiply_subtract_many(
+                        symbol_dest + offset,
+                        offset_sources(symbols_src, count, offset, thread),
+                        coefficients, count, length);
+                });
+        }
+
+    protected:
+
+        /// Invokes the function for every stripe of a region, in
+        /// parallel if the region is large enough
+        /// @param symbol_length The length of the region in value_type
+        ///        elements
+        /// @param function The function invoked with the offset and
+        ///        the length of every stripe in value_type elements and
+        ///        the index of the executing thread in the pool
+        template<class Function>
+        void run_striped(uint32_t symbol_length, const Function& function)
+        {
+            assert(symbol_length > 0);
+
+            uint32_t stripe_length =
+                fifi::size_to_length<field_type>(stripe_size);
+
+            if(!m_pool || m_pool->threads() == 0 ||
+               symbol_length < 2 * stripe_length)
+            {
+                function(0, symbol_length, 0);
+                return;
+            }
+
+            uint32_t stripes =
+                (symbol_length + stripe_length - 1) / stripe_length;
+
+            m_pool->run(stripes, [&](uint32_t stripe, uint32_t thread)
+                {
+                    uint32_t offset = stripe * stripe_length;
+
+                    function(offset,
+                             std::min(stripe_length, symbol_length - offset),
+                             thread);
+                });
+        }
+
+        /// Offsets the source symbols to a stripe
+        /// @param symbols_src The source symbols
+        /// @param count The number of source symbols
+        /// @param offset The offset of the stripe in value_type elements
+        /// @param thread The index of the thread executing the stripe
+        /// @return The source pointers of the stripe, stored in the row
+        ///         of the thread in the offset table
+        const value_type* const* offset_sources(
+            const value_type* const* symbols_src, uint32_t count,
+            uint32_t offset, uint32_t thread)
+        {
+            if(offset == 0)
+                return symbols_src;
+
+            assert(count <= m_max_sources);
+            assert((thread + 1) * m_max_sources <= m_sources.size());
+
+            const value_type** sources = &m_sources[thread * m_max_sources];
+
+            for(uint32_t i = 0; i < count; ++i)
+                sources[i] = symbols_src[i] + offset;
+
+            return sources;
+        }
+
+    protected:
+
+        /// The thread pool
+        pool_pointer m_pool;
+
+        /// The maximum number of source symbols of an operation
+        uint32_t m_max_sources;
+
+        /// The offset source pointers, one row per thread of the pool
+        std::vector<const value_type*> m_sources;
+
+    };
+
+}
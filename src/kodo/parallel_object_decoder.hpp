@@ -0,0 +1,377 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+#include <sak/storage.hpp>
+
+#include "rfc5052_partitioning_scheme.hpp"
+#include "spsc_queue.hpp"
+
+namespace kodo
+{
+
+    /// @brief Object decoder which decodes the blocks of an object on a
+    ///        pool of worker threads.
+    ///
+    /// The blocks are assigned to the workers in a round robin fashion,
+    /// block i is owned by worker i % threads(). Every worker has its
+    /// own factory, so the decoders are built and used by their owning
+    /// worker only and no locking is needed. Payloads passed to
+    /// decode() are copied into a lock-free single producer single
+    /// consumer queue of the owning worker, which decodes them in the
+    /// order they were received. Since the blocks are independent, the
+    /// decoding throughput scales with the number of workers as long
+    /// as the payloads are spread over the blocks.
+    ///
+    /// decode() must always be called from the same thread. The
+    /// decoders can be accessed once wait() has returned.
+    ///
+    /// @tparam DecoderType The decoder stack which should be used
+    /// @tparam BlockParitioning block_partitioning
+    template
+    <
+        class DecoderType,
+        class BlockPartitioning = rfc5052_partitioning_scheme
+    >
+    class parallel_object_decoder : boost::noncopyable
+    {
+    public:
+
+        /// The type of factory used to build decoders
+        typedef typename DecoderType::factory factory;
+
+        /// Pointer to a decoder
+        typedef typename DecoderType::pointer pointer;
+
+        /// The block partitioning scheme used
+        typedef BlockPartitioning block_partitioning;
+
+        /// The default number of payloads queued per worker
+        static const uint32_t default_queue_size = 64;
+
+    public:
+
+        /// Constructs a new parallel object decoder and starts the
+        /// workers
+        /// @param max_symbols The maximum number of symbols per block
+        /// @param max_symbol_size The maximum size of a symbol in bytes
+        /// @param object_size The size in bytes of the object to be decoded
+        /// @param threads The number of worker threads
+        /// @param queue_size The number of payloads queued per worker,
+        ///        must be a power of two
+        parallel_object_decoder(uint32_t max_symbols,
+                                uint32_t max_symbol_size,
+                                uint64_t object_size, uint32_t threads,
+                                uint32_t queue_size = default_queue_size)
+            : m_object_size(object_size),
+              m_completed(0),
+              m_stop(false)
+        {
+            assert(m_object_size > 0);
+            assert(threads > 0);
+
+            m_partitioning = block_partitioning(
+                max_symbols, max_symbol_size, m_object_size);
+
+            m_decoders.resize(m_partitioning.blocks());
+
+            m_block_complete = std::vector<std::atomic<bool> >(
+                m_partitioning.blocks());
+
+            for(auto& complete : m_block_complete)
+            {
+                complete = false;
+            }
+
+            threads = std::min(threads, m_partitioning.blocks());
+
+            for(uint32_t i = 0; i < threads; ++i)
+            {
+                auto worker = boost::make_shared<worker_state>(
+                    max_symbols, max_symbol_size, queue_size);
+
+                m_workers.push_back(worker);
+            }
+
+            m_max_payload_size = m_workers[0]->m_factory.max_payload_size();
+
+            for(uint32_t i = 0; i < threads; ++i)
+            {
+                m_threads.push_back(std::thread(
+                    &parallel_object_decoder::run, this, i));
+            }
+        }
+
+        /// Stops and joins the workers, payloads not yet decoded are
+        /// dropped
+        ~parallel_object_decoder()
+        {
+            m_stop = true;
+
+            for(auto& thread : m_threads)
+            {
+                thread.join();
+            }
+        }
+
+        /// @return The number of decoders which may be created for
+        ///         this object
+        uint32_t decoders() const
+        {
+            return m_partitioning.blocks();
+        }
+
+        /// @return The number of worker threads
+        uint32_t threads() const
+        {
+            return static_cast<uint32_t>(m_workers.size());
+        }
+
+        /// @return The total size of the object to decode in bytes
+        uint64_t object_size() const
+        {
+            return m_object_size;
+        }
+
+        /// @return The size in bytes of the largest payload
+        uint32_t max_payload_size() const
+        {
+            return m_max_payload_size;
+        }
+
+        /// Queues a payload for decoding by the worker owning the block.
+        /// Waits if the queue of the worker is full.
+        /// @param decoder_id The block the payload belongs to
+        /// @param payload The payload, which is copied
+        /// @param payload_size The size of the payload in bytes
+        void decode(uint32_t decoder_id, const uint8_t *payload,
+                    uint32_t payload_size)
+        {
+            assert(decoder_id < m_partitioning.blocks());
+            assert(payload != 0);
+
+            worker_state &state = worker(decoder_id);
+            spsc_queue &queue = state.m_queue;
+
+            assert(payload_size <= queue.slot_size());
+
+            uint8_t *slot = 0;
+
+            for(uint32_t attempt = 0; (slot = queue.back()) == 0; ++attempt)
+            {
+                spsc_queue::back_off(attempt);
+            }
+
+            std::copy_n(payload, payload_size, slot);
+
+            queue.push(decoder_id, payload_size);
+            ++state.m_pushed;
+        }
+
+        /// Waits until all queued payloads have been decoded
+        void wait()
+        {
+            for(auto& worker : m_workers)
+            {
+                for(uint32_t attempt = 0;
+                    worker->m_decoded.load() != worker->m_pushed; ++attempt)
+                {
+                    spsc_queue::back_off(attempt);
+                }
+            }
+        }
+
+        /// @return The number of blocks which have been fully decoded
+        uint32_t blocks_completed() const
+        {
+            return m_completed.load();
+        }
+
+        /// @return True if all blocks have been fully decoded
+        bool is_complete() const
+        {
+            return blocks_completed() == m_partitioning.blocks();
+        }
+
+        /// May be called while the workers are decoding, e.g. to call
+        /// parallel_object_encoder::finish() for the block
+        /// @param decoder_id Specifies the block
+        /// @return True if the block has been fully decoded
+        bool is_complete(uint32_t decoder_id) const
+        {
+            assert(decoder_id < m_partitioning.blocks());
+            return m_block_complete[decoder_id];
+        }
+
+        /// Access a decoder, which is only allowed after wait() has
+        /// returned
+        /// @param decoder_id Specifies the decoder
+        /// @return The decoder or an empty pointer if no payload has
+        ///         been decoded for the block
+        pointer decoder(uint32_t decoder_id) const
+        {
+            assert(decoder_id < m_partitioning.blocks());
+            return m_decoders[decoder_id];
+        }
+
+        /// Copies the decoded object into the storage, which is only
+        /// allowed after wait() has returned
+        /// @param storage The destination buffer of at least
+        ///        object_size() bytes
+        void copy_symbols(const sak::mutable_storage &storage) const
+        {
+            assert(is_complete());
+            assert(storage.m_size >= m_object_size);
+
+            for(uint32_t i = 0; i < m_partitioning.blocks(); ++i)
+            {
+                const pointer &decoder = m_decoders[i];
+                assert(decoder);
+
+                sak::mutable_storage block = sak::storage(
+                    storage.m_data + m_partitioning.byte_offset(i),
+                    decoder->bytes_used());
+
+                decoder->copy_symbols(block);
+            }
+        }
+
+    private:
+
+        /// The state of a worker
+        struct worker_state : boost::noncopyable
+        {
+            /// Creates the factory and the queue of the worker
+            worker_state(uint32_t max_symbols, uint32_t max_symbol_size,
+                         uint32_t queue_size)
+                : m_factory(max_symbols, max_symbol_size),
+                  m_queue(queue_size, m_factory.max_payload_size()),
+                  m_pushed(0),
+                  m_decoded(0)
+            { }
+
+            /// The factory used to build the decoders of the worker
+            factory m_factory;
+
+            /// The payloads waiting to be decoded by the worker
+            spsc_queue m_queue;
+
+            /// The number of payloads queued, only used by the producer
+            uint32_t m_pushed;
+
+            /// The number of payloads decoded by the worker
+            std::atomic<uint32_t> m_decoded;
+        };
+
+        /// @param decoder_id The block
+        /// @return The worker owning the block
+        worker_state &worker(uint32_t decoder_id)
+        {
+            return *m_workers[decoder_id % m_workers.size()];
+        }
+
+        /// Builds the decoder of a block on the owning worker
+        /// @param the_factory The factory of the worker
+        /// @param decoder_id The block
+        /// @return The decoder
+        pointer build(factory &the_factory, uint32_t decoder_id)
+        {
+            the_factory.set_symbols(m_partitioning.symbols(decoder_id));
+            the_factory.set_symbol_size(
+                m_partitioning.symbol_size(decoder_id));
+
+            pointer decoder = the_factory.build();
+            decoder->set_bytes_used(m_partitioning.bytes_used(decoder_id));
+
+            return decoder;
+        }
+
+        /// The loop of a worker thread
+        /// @param index The index of the worker
+        void run(uint32_t index)
+        {
+            worker_state &state = *m_workers[index];
+
+            uint32_t attempt = 0;
+
+            while(!m_stop)
+            {
+                uint32_t decoder_id = 0;
+                uint32_t payload_size = 0;
+
+                uint8_t *payload =
+                    state.m_queue.front(decoder_id, payload_size);
+
+                if(payload == 0)
+                {
+                    spsc_queue::back_off(attempt++);
+                    continue;
+                }
+
+                attempt = 0;
+
+                pointer &decoder = m_decoders[decoder_id];
+
+                if(!decoder)
+                    decoder = build(state.m_factory, decoder_id);
+
+                if(!decoder->is_complete())
+                {
+                    decoder->decode(payload);
+
+                    if(decoder->is_complete())
+                    {
+                        m_block_complete[decoder_id] = true;
+                        ++m_completed;
+                    }
+                }
+
+                state.m_queue.pop();
+                ++state.m_decoded;
+            }
+        }
+
+    private:
+
+        /// The size of the object in bytes
+        uint64_t m_object_size;
+
+        /// The block partitioning scheme used
+        block_partitioning m_partitioning;
+
+        /// The size in bytes of the largest payload
+        uint32_t m_max_payload_size;
+
+        /// The decoders, each only accessed by its owning worker
+        std::vector<pointer> m_decoders;
+
+        /// The state of the workers
+        std::vector<boost::shared_ptr<worker_state> > m_workers;
+
+        /// The worker threads
+        std::vector<std::thread> m_threads;
+
+        /// True for the blocks which have been fully decoded
+        std::vector<std::atomic<bool> > m_block_complete;
+
+        /// The number of fully decoded blocks
+        std::atomic<uint32_t> m_completed;
+
+        /// True when the workers should exit
+        std::atomic<bool> m_stop;
+    };
+
+}
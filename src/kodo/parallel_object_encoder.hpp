@@ -0,0 +1,383 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+#include "rfc5052_partitioning_scheme.hpp"
+#include "spsc_queue.hpp"
+
+namespace kodo
+{
+
+    /// @brief Object encoder which encodes the blocks of an object on a
+    ///        pool of worker threads.
+    ///
+    /// The blocks are assigned to the workers in a round robin fashion,
+    /// block i is owned by worker i % threads(). Every worker has its
+    /// own factory and its own copy of the object data and keeps
+    /// producing payloads, one block at a time, into a lock-free single
+    /// producer single consumer queue. encode() takes the payloads from
+    /// the queues of the workers in turn, so the encoding throughput
+    /// scales with the number of workers.
+    ///
+    /// A worker only holds the encoders of a window of its blocks. The
+    /// data of a block is read when it enters the window, and its
+    /// encoder is released once the block is stopped with finish(),
+    /// e.g. after the receiver has decoded it, which lets the next block
+    /// in. The memory used is therefore bounded by the window size and
+    /// not by the object size, but the caller must finish blocks for
+    /// the later blocks to be encoded.
+    ///
+    /// The object data is copied to every worker and read concurrently,
+    /// which is safe for the storage_reader and the mmap_file_reader
+    /// but not for the file_reader, whose copies share a file stream.
+    /// encode() and finish() must always be called from the same
+    /// thread.
+    ///
+    /// @tparam ObjectData object_data
+    /// @tparam EncoderType An encoder stack which should be used
+    /// @tparam BlockParitioning block_partitioning
+    template
+    <
+        class ObjectData,
+        class EncoderType,
+        class BlockPartitioning = rfc5052_partitioning_scheme
+    >
+    class parallel_object_encoder : boost::noncopyable
+    {
+    public:
+
+        /// The type of factory used to build encoders
+        typedef typename EncoderType::factory factory_type;
+
+        /// Pointer to an encoder
+        typedef typename EncoderType::pointer pointer_type;
+
+        /// The block partitioning scheme used
+        typedef BlockPartitioning block_partitioning;
+
+        /// The data source type
+        typedef ObjectData object_data;
+
+        /// The default number of payloads queued per worker
+        static const uint32_t default_queue_size = 64;
+
+        /// The default number of blocks a worker encodes at a time
+        static const uint32_t default_window_size = 4;
+
+    public:
+
+        /// Constructs a new parallel object encoder and starts the
+        /// workers
+        /// @param max_symbols The maximum number of symbols per block
+        /// @param max_symbol_size The maximum size of a symbol in bytes
+        /// @param data The object to encode
+        /// @param threads The number of worker threads
+        /// @param queue_size The number of payloads queued per worker,
+        ///        must be a power of two
+        /// @param window_size The number of blocks a worker encodes at
+        ///        a time
+        parallel_object_encoder(uint32_t max_symbols,
+                                uint32_t max_symbol_size,
+                                const object_data &data, uint32_t threads,
+                                uint32_t queue_size = default_queue_size,
+                                uint32_t window_size = default_window_size)
+            : m_object_size(data.size()),
+              m_window_size(window_size),
+              m_next_worker(0),
+              m_finished_count(0),
+              m_stop(false)
+        {
+            assert(m_object_size > 0);
+            assert(threads > 0);
+            assert(m_window_size > 0);
+
+            m_partitioning = block_partitioning(
+                max_symbols, max_symbol_size, m_object_size);
+
+            m_finished = std::vector<std::atomic<bool> >(
+                m_partitioning.blocks());
+
+            for(auto& finished : m_finished)
+            {
+                finished = false;
+            }
+
+            threads = std::min(threads, m_partitioning.blocks());
+
+            for(uint32_t i = 0; i < threads; ++i)
+            {
+                auto worker = boost::make_shared<worker_state>(
+                    max_symbols, max_symbol_size, data, queue_size);
+
+                m_workers.push_back(worker);
+            }
+
+            m_max_payload_size = m_workers[0]->m_factory.max_payload_size();
+
+            for(uint32_t i = 0; i < threads; ++i)
+            {
+                m_threads.push_back(std::thread(
+                    &parallel_object_encoder::run, this, i));
+            }
+        }
+
+        /// Stops and joins the workers
+        ~parallel_object_encoder()
+        {
+            m_stop = true;
+
+            for(auto& thread : m_threads)
+            {
+                thread.join();
+            }
+        }
+
+        /// @return The number of encoders used for this object
+        uint32_t encoders() const
+        {
+            return m_partitioning.blocks();
+        }
+
+        /// @return The number of worker threads
+        uint32_t threads() const
+        {
+            return static_cast<uint32_t>(m_workers.size());
+        }
+
+        /// @return The total size of the object to encode in bytes
+        uint64_t object_size() const
+        {
+            return m_object_size;
+        }
+
+        /// @return The size in bytes of the largest payload
+        uint32_t max_payload_size() const
+        {
+            return m_max_payload_size;
+        }
+
+        /// Takes the next payload produced by the workers. Waits until
+        /// a payload is available unless all blocks have been finished.
+        /// @param encoder_id Set to the block the payload belongs to
+        /// @param payload The buffer of at least max_payload_size()
+        ///        bytes the payload is copied to
+        /// @return The size of the payload in bytes, or zero if all
+        ///         blocks have been finished and no payloads are left
+        uint32_t encode(uint32_t &encoder_id, uint8_t *payload)
+        {
+            assert(payload != 0);
+
+            for(uint32_t attempt = 0; ; ++attempt)
+            {
+                for(uint32_t i = 0; i < m_workers.size(); ++i)
+                {
+                    spsc_queue &queue = m_workers[m_next_worker]->m_queue;
+
+                    m_next_worker = (m_next_worker + 1) % m_workers.size();
+
+                    uint32_t payload_size = 0;
+                    uint8_t *slot = queue.front(encoder_id, payload_size);
+
+                    if(slot == 0)
+                        continue;
+
+                    std::copy_n(slot, payload_size, payload);
+                    queue.pop();
+
+                    return payload_size;
+                }
+
+                if(is_finished())
+                {
+                    // The workers may have queued a last payload before
+                    // seeing that their blocks were finished
+                    bool empty = true;
+
+                    for(auto& worker : m_workers)
+                        empty = empty && worker->m_queue.empty();
+
+                    if(empty)
+                        return 0;
+                }
+
+                spsc_queue::back_off(attempt);
+            }
+        }
+
+        /// Stops the production of payloads for a block. Payloads
+        /// already queued are still returned by encode().
+        /// @param encoder_id Specifies the block
+        void finish(uint32_t encoder_id)
+        {
+            assert(encoder_id < m_partitioning.blocks());
+
+            if(!m_finished[encoder_id].exchange(true))
+                ++m_finished_count;
+        }
+
+        /// @return True if finish() has been called for all blocks
+        bool is_finished() const
+        {
+            return m_finished_count == m_partitioning.blocks();
+        }
+
+    private:
+
+        /// The state of a worker
+        struct worker_state : boost::noncopyable
+        {
+            /// Creates the factory and the queue of the worker
+            worker_state(uint32_t max_symbols, uint32_t max_symbol_size,
+                         const object_data &data, uint32_t queue_size)
+                : m_factory(max_symbols, max_symbol_size),
+                  m_data(data),
+                  m_queue(queue_size, m_factory.max_payload_size())
+            { }
+
+            /// The factory used to build the encoders of the worker
+            factory_type m_factory;
+
+            /// The copy of the object data used by the worker
+            object_data m_data;
+
+            /// The payloads produced by the worker
+            spsc_queue m_queue;
+        };
+
+        /// The loop of a worker thread
+        /// @param index The index of the worker
+        void run(uint32_t index)
+        {
+            worker_state &state = *m_workers[index];
+
+            // The blocks in the window and their encoders
+            std::vector<uint32_t> blocks;
+            std::vector<pointer_type> encoders;
+
+            // The next block of the worker to enter the window
+            uint32_t unstarted = index;
+
+            // The next block in the window to produce a payload for,
+            // kept across rounds so a full queue does not starve the
+            // later blocks
+            uint32_t next = 0;
+            uint32_t attempt = 0;
+
+            while(!m_stop)
+            {
+                // Release the encoders of the finished blocks
+                for(uint32_t i = 0; i < blocks.size(); )
+                {
+                    if(!m_finished[blocks[i]])
+                    {
+                        ++i;
+                        continue;
+                    }
+
+                    blocks.erase(blocks.begin() + i);
+                    encoders.erase(encoders.begin() + i);
+                }
+
+                // Let the following blocks into the window
+                while(blocks.size() < m_window_size &&
+                      unstarted < m_partitioning.blocks())
+                {
+                    uint32_t block = unstarted;
+                    unstarted += m_workers.size();
+
+                    if(m_finished[block])
+                        continue;
+
+                    state.m_factory.set_symbols(
+                        m_partitioning.symbols(block));
+                    state.m_factory.set_symbol_size(
+                        m_partitioning.symbol_size(block));
+
+                    pointer_type encoder = state.m_factory.build();
+
+                    state.m_data.read(encoder,
+                                      m_partitioning.byte_offset(block),
+                                      m_partitioning.bytes_used(block));
+
+                    blocks.push_back(block);
+                    encoders.push_back(encoder);
+                }
+
+                bool produced = false;
+
+                for(uint32_t n = 0; n < blocks.size() && !m_stop; ++n)
+                {
+                    next = next % blocks.size();
+
+                    if(m_finished[blocks[next]])
+                    {
+                        ++next;
+                        continue;
+                    }
+
+                    uint8_t *slot = state.m_queue.back();
+
+                    if(slot == 0)
+                        break;
+
+                    uint32_t payload_size = encoders[next]->encode(slot);
+                    state.m_queue.push(blocks[next], payload_size);
+
+                    ++next;
+                    produced = true;
+                }
+
+                if(produced)
+                    attempt = 0;
+                else
+                    spsc_queue::back_off(attempt++);
+            }
+        }
+
+    private:
+
+        /// The size of the object in bytes
+        uint64_t m_object_size;
+
+        /// The number of blocks a worker encodes at a time
+        uint32_t m_window_size;
+
+        /// The block partitioning scheme used
+        block_partitioning m_partitioning;
+
+        /// The size in bytes of the largest payload
+        uint32_t m_max_payload_size;
+
+        /// The state of the workers
+        std::vector<boost::shared_ptr<worker_state> > m_workers;
+
+        /// The worker threads
+        std::vector<std::thread> m_threads;
+
+        /// The worker whose queue is checked first by encode()
+        uint32_t m_next_worker;
+
+        /// True for the blocks which should not be encoded any more
+        std::vector<std::atomic<bool> > m_finished;
+
+        /// The number of finished blocks, only used by the caller
+        uint32_t m_finished_count;
+
+        /// True when the workers should exit
+        std::atomic<bool> m_stop;
+    };
+
+}
@@ -6,6 +6,9 @@
 #pragma once
 
 #include <cstdint>
+#include <algorithm>
+
+#include "coder_arena.hpp"
 
 namespace kodo
 {
@@ -40,6 +43,26 @@ namespace kodo
 
     public:
 
+        /// Constructor
+        payload_decoder()
+            : m_symbol_header(0),
+              m_symbol_header_size(0)
+        { }
+
+        /// @copydoc layer::layout(Factory&,coder_arena&)
+        template<class Factory>
+        void layout(Factory& the_factory, coder_arena& arena)
+        {
+            SuperCoder::layout(the_factory, arena);
+
+            // The header is aligned so the coding coefficients in it do
+            // not have to be copied again by the
+            // aligned_coefficients_decoder
+            m_symbol_header_size = the_factory.max_header_size();
+            m_symbol_header = arena.allocate<uint8_t>(
+                m_symbol_header_size, coder_arena::vector_alignment);
+        }
+
         /// Unpacks the symbol data and symbol header from the payload
         /// buffer.
         /// @copydoc layer::decode(uint8_t*)
@@ -53,12 +76,60 @@ namespace kodo
             SuperCoder::decode(symbol_data, symbol_id);
         }
 
+        /// Unpacks the symbol data and symbol header from a read-only
+        /// payload buffer. Only the symbol header is copied, the symbol
+        /// data is passed on as it is. Requires a layer decoding const
+        /// symbol data, e.g. the fused_copy_decoder, further down the
+        /// stack.
+        /// @copydoc layer::decode(const uint8_t*)
+        void decode(const uint8_t *payload)
+        {
+            assert(payload != 0);
+
+            const uint8_t *symbol_data = payload;
+            const uint8_t *symbol_id = payload + SuperCoder::symbol_size();
+
+            uint32_t header_size = SuperCoder::header_size();
+            assert(header_size <= m_symbol_header_size);
+
+            std::copy_n(symbol_id, header_size, m_symbol_header);
+
+            SuperCoder::decode(symbol_data, m_symbol_header);
+        }
+
+        /// Decodes a number of payloads as a single batch. Requires a
+        /// layer supporting batches, e.g. the batch_linear_block_decoder,
+        /// further down the stack.
+        /// @copydoc layer::decode(uint8_t**, uint32_t)
+        void decode(uint8_t **payloads, uint32_t payload_count)
+        {
+            assert(payloads != 0);
+
+            SuperCoder::begin_batch();
+
+            for(uint32_t i = 0; i < payload_count; ++i)
+            {
+                decode(payloads[i]);
+            }
+
+            SuperCoder::end_batch();
+        }
+
         /// @copydoc layer::payload_size() const
         uint32_t payload_size() const
         {
             return SuperCoder::symbol_size() +
                 SuperCoder::header_size();
         }
+
+    private:
+
+        /// Copy of the symbol header of a read-only payload
+        uint8_t* m_symbol_header;
+
+        /// The size in bytes of the symbol header buffer
+        uint32_t m_symbol_header_size;
+
     };
 
 }
@@ -70,6 +70,53 @@ namespace kodo
                 + SuperCoder::symbol_size();
         }
 
+        /// Encodes a symbol without copying the symbol data into a
+        /// payload buffer. Requires the zero_copy_encoder layer further
+        /// down the stack. The payload consists of the symbol data
+        /// followed by the symbol header, using the same layout as
+        /// encode(uint8_t*), e.g. as the two entries of an iovec.
+        /// Uncoded symbols are referenced directly in the symbol
+        /// storage, coded symbols are placed in an internal buffer.
+        /// @copydoc layer::encode_iovec(uint8_t*, const uint8_t**)
+        uint32_t encode_iovec(uint8_t *symbol_header,
+                              const uint8_t **symbol_data)
+        {
+            assert(symbol_header != 0);
+            assert(symbol_data != 0);
+
+            SuperCoder::set_zero_copy(true);
+
+            uint32_t bytes_used = SuperCoder::encode(
+                SuperCoder::zero_copy_buffer(), symbol_header);
+
+            SuperCoder::set_zero_copy(false);
+
+            *symbol_data = SuperCoder::encoded_symbol();
+            assert(*symbol_data != 0);
+
+            return bytes_used;
+        }
+
+        /// Encodes a number of payloads as a single batch. Requires a
+        /// layer supporting batches, e.g. the batch_linear_block_encoder,
+        /// further down the stack.
+        /// @copydoc layer::encode(uint8_t**, uint32_t*, uint32_t)
+        void encode(uint8_t **payloads, uint32_t *payload_sizes,
+                    uint32_t payload_count)
+        {
+            assert(payloads != 0);
+            assert(payload_sizes != 0);
+
+            SuperCoder::begin_batch();
+
+            for(uint32_t i = 0; i < payload_count; ++i)
+            {
+                payload_sizes[i] = encode(payloads[i]);
+            }
+
+            SuperCoder::end_batch();
+        }
+
         /// @copydoc layer::payload_size() const
         uint32_t payload_size() const
         {
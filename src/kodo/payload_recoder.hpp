@@ -94,8 +94,7 @@ namespace kodo
 
             if(!m_recode_stack)
             {
-                stack_factory.set_stack_proxy(this);
-                m_recode_stack = stack_factory.build();
+                m_recode_stack = stack_factory.build(this);
             }
             else
             {
@@ -111,6 +110,19 @@ namespace kodo
             return m_recode_stack->encode(payload);
         }
 
+        /// Includes the memory of the recoding stack, which is built
+        /// in a separate allocation.
+        /// @copydoc layer::memory_footprint() const
+        uint64_t memory_footprint() const
+        {
+            uint64_t footprint = SuperCoder::memory_footprint();
+
+            if(m_recode_stack)
+                footprint += m_recode_stack->memory_footprint();
+
+            return footprint;
+        }
+
         /// Make sure we have enough space for both the payload
         /// produced by the main stack and the recoding stack.
         /// @copydoc layer::payload_size() const
@@ -0,0 +1,60 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "prefetch_object_encoder.hpp"
+#include "file_reader.hpp"
+#include "rfc5052_partitioning_scheme.hpp"
+
+namespace kodo
+{
+
+    /// @brief A file encoder which reads the next block of the file
+    ///        on a background thread.
+    ///
+    /// Identical to the file_encoder, except that it uses the
+    /// prefetch_object_encoder, so building the encoders in order does
+    /// not block on the disk.
+    template
+    <
+        class EncoderType,
+        class BlockPartitioning = rfc5052_partitioning_scheme
+    >
+    class prefetch_file_encoder : public
+            prefetch_object_encoder
+            <
+                file_reader<EncoderType>,
+                EncoderType,
+                BlockPartitioning
+            >
+    {
+    public:
+
+        /// The encoder factory type
+        typedef typename EncoderType::factory factory;
+
+    public:
+
+        /// Constructs a new file encoder
+        /// @param factory the encoder factory to use
+        /// @param filename the file to encode
+        prefetch_file_encoder(typename EncoderType::factory &factory,
+                              const std::string &filename)
+            : prefetch_object_encoder
+                  <
+                  file_reader<EncoderType>,
+                  EncoderType,
+                  BlockPartitioning
+                  >
+              (factory, file_reader<EncoderType>(
+                  filename,
+                  factory.max_symbols() * factory.max_symbol_size()))
+            { }
+    };
+}
+
+
+
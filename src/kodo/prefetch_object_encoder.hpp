@@ -0,0 +1,290 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include <boost/noncopyable.hpp>
+
+#include "rfc5052_partitioning_scheme.hpp"
+
+namespace kodo
+{
+
+    /// @brief Object encoder which loads the data of the next block on
+    ///        a background thread while the current block is encoded.
+    ///
+    /// The object_encoder reads the data of a block when the encoder is
+    /// built, so with object data such as the file_reader the sender
+    /// stalls on the disk at every block boundary. This encoder has the
+    /// same interface, but whenever encoder i is built, the encoder for
+    /// block i + 1 is built as well and its data is read on a
+    /// background thread. Encoders requested in increasing order are
+    /// therefore ready when they are requested, as long as reading a
+    /// block is faster than sending it.
+    ///
+    /// The reads are performed by a single reader thread, which lives
+    /// as long as the object encoder. The prefetched encoder is handed
+    /// to it through a slot holding one encoder. The encoders are built
+    /// by the factory on the calling thread, so only the object data is
+    /// accessed from the reader thread and at most one read is in
+    /// progress at any time. Requesting an encoder other than the
+    /// prefetched one waits for the prefetch to complete, drops it and
+    /// reads the block directly.
+    ///
+    /// @tparam ObjectData object_data
+    /// @tparam EncoderType An encoder stack which should be used
+    /// @tparam BlockParitioning block_partitioning
+    template
+    <
+        class ObjectData,
+        class EncoderType,
+        class BlockPartitioning = rfc5052_partitioning_scheme
+    >
+    class prefetch_object_encoder : boost::noncopyable
+    {
+    public:
+
+        /// The type of factory used to build encoders
+        typedef typename EncoderType::factory factory_type;
+
+        /// Pointer to an encoder
+        typedef typename EncoderType::pointer pointer_type;
+
+        /// The block partitioning scheme used
+        typedef BlockPartitioning block_partitioning;
+
+        /// The data source type
+        typedef ObjectData object_data;
+
+    public:
+
+        /// Constructs a new object encoder
+        /// @param factory the encoder factory to use
+        /// @param object the object to encode
+        prefetch_object_encoder(factory_type &factory,
+                                const object_data &data) :
+            m_factory(factory),
+            m_data(data),
+            m_prefetch_id(0),
+            m_prefetch_requested(false),
+            m_prefetch_ready(false),
+            m_stop(false)
+        {
+            assert(m_data.size() > 0);
+
+            m_partitioning = block_partitioning(
+                m_factory.max_symbols(),
+                m_factory.max_symbol_size(),
+                m_data.size());
+
+            m_reader = std::thread(&prefetch_object_encoder::reader, this);
+        }
+
+        /// Stops the reader thread, a read in progress is completed
+        /// first since it uses the object data
+        ~prefetch_object_encoder()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+
+            m_signal.notify_all();
+            m_reader.join();
+        }
+
+        /// @return The number of encoders which may be created for
+        ///         this object
+        uint32_t encoders() const
+        {
+            return m_partitioning.blocks();
+        }
+
+        /// Builds a specific encoder and starts prefetching the data of
+        /// the following encoder
+        /// @param encoder_id Specifies the encoder to build
+        /// @return The initialized encoder
+        pointer_type build(uint32_t encoder_id)
+        {
+            assert(encoder_id < m_partitioning.blocks());
+
+            pointer_type encoder = take_prefetched(encoder_id);
+
+            if(!encoder)
+            {
+                encoder = build_encoder(encoder_id);
+                read(encoder, encoder_id);
+            }
+
+            uint32_t next_id = encoder_id + 1;
+
+            if(next_id < m_partitioning.blocks())
+            {
+                // The reader does not touch the slot until the request
+                // is made, so the encoder can be placed without the lock
+                m_prefetch_encoder = build_encoder(next_id);
+
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_prefetch_id = next_id;
+                    m_prefetch_requested = true;
+                }
+
+                m_signal.notify_all();
+            }
+
+            return encoder;
+        }
+
+        /// @return The total size of the object to encode in bytes
+        uint64_t object_size() const
+        {
+            return m_data.size();
+        }
+
+    private:
+
+        /// Waits for the prefetch in progress and empties the slot
+        /// @param encoder_id The block of the requested encoder
+        /// @return The prefetched encoder if it is the requested one,
+        ///         otherwise an empty pointer
+        pointer_type take_prefetched(uint32_t encoder_id)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_signal.wait(lock, [this] { return !m_prefetch_requested; });
+
+            pointer_type encoder;
+
+            if(m_prefetch_ready && m_prefetch_id == encoder_id)
+                encoder = m_prefetch_encoder;
+
+            // The encoder is only released to the factory pool on the
+            // calling thread
+            m_prefetch_encoder = pointer_type();
+            m_prefetch_ready = false;
+
+            // Rethrows any exception raised while reading
+            if(m_prefetch_error)
+            {
+                std::exception_ptr error = m_prefetch_error;
+                m_prefetch_error = std::exception_ptr();
+                std::rethrow_exception(error);
+            }
+
+            return encoder;
+        }
+
+        /// The loop of the reader thread, reads the data of the encoder
+        /// in the slot whenever a prefetch is requested
+        void reader()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            while(true)
+            {
+                m_signal.wait(lock, [this] {
+                    return m_stop || m_prefetch_requested; });
+
+                if(m_stop)
+                    return;
+
+                uint32_t encoder_id = m_prefetch_id;
+
+                lock.unlock();
+
+                std::exception_ptr error;
+
+                try
+                {
+                    read(m_prefetch_encoder, encoder_id);
+                }
+                catch(...)
+                {
+                    error = std::current_exception();
+                }
+
+                lock.lock();
+
+                m_prefetch_error = error;
+                m_prefetch_ready = !error;
+                m_prefetch_requested = false;
+
+                m_signal.notify_all();
+            }
+        }
+
+        /// Builds an uninitialized encoder for a block
+        /// @param encoder_id Specifies the encoder to build
+        /// @return The encoder without data
+        pointer_type build_encoder(uint32_t encoder_id)
+        {
+            m_factory.set_symbols(m_partitioning.symbols(encoder_id));
+            m_factory.set_symbol_size(m_partitioning.symbol_size(encoder_id));
+
+            return m_factory.build();
+        }
+
+        /// Initializes an encoder with the data of its block
+        /// @param encoder The encoder to initialize
+        /// @param encoder_id The block of the encoder
+        void read(pointer_type &encoder, uint32_t encoder_id)
+        {
+            uint64_t offset =
+                m_partitioning.byte_offset(encoder_id);
+
+            uint32_t bytes_used =
+                m_partitioning.bytes_used(encoder_id);
+
+            m_data.read(encoder, offset, bytes_used);
+        }
+
+    private:
+
+        /// The encoder factory
+        factory_type &m_factory;
+
+        /// Store the object storage
+        object_data m_data;
+
+        /// The block partitioning scheme used
+        block_partitioning m_partitioning;
+
+        /// The block of the prefetched encoder
+        uint32_t m_prefetch_id;
+
+        /// The slot holding the encoder being initialized by the
+        /// reader thread
+        pointer_type m_prefetch_encoder;
+
+        /// True while the reader thread reads the encoder in the slot
+        bool m_prefetch_requested;
+
+        /// True if the encoder in the slot has its data
+        bool m_prefetch_ready;
+
+        /// True when the reader thread should exit
+        bool m_stop;
+
+        /// The exception raised by the last read of the reader thread
+        std::exception_ptr m_prefetch_error;
+
+        /// Protects the slot and the flags shared with the reader
+        std::mutex m_mutex;
+
+        /// Signals a prefetch request or its completion
+        std::condition_variable m_signal;
+
+        /// The reader thread
+        std::thread m_reader;
+    };
+
+}
@@ -7,6 +7,8 @@
 
 #include <cstdint>
 
+#include "coder_arena.hpp"
+
 namespace kodo
 {
 
@@ -83,13 +85,24 @@ namespace kodo
 
             /// @copydoc layer::factory::build()
             pointer build()
+            {
+                return build(m_stack_proxy);
+            }
+
+            /// Builds a coder forwarding to the given main stack. Unlike
+            /// set_stack_proxy() followed by build() the factory is not
+            /// changed, so coders for different main stacks may be
+            /// built concurrently.
+            /// @param stack_proxy The main stack the coder forwards to
+            /// @return The new coder
+            pointer build(MainStack* stack_proxy)
             {
                 assert(m_factory_proxy != 0);
-                assert(m_stack_proxy != 0);
+                assert(stack_proxy != 0);
 
                 pointer coder = boost::make_shared<FinalType>();
 
-                coder->set_proxy(m_stack_proxy);
+                coder->set_proxy(stack_proxy);
 
                 factory_type *this_factory =
                     static_cast<factory_type*>(this);
@@ -188,11 +201,25 @@ namespace kodo
             m_proxy = proxy;
         }
 
+        /// Lays out the buffers of the layers of the proxy stack in a
+        /// single allocation, which is separate from the one of the
+        /// main stack.
         /// @copydoc layer::construct(Factory&)
         template<class Factory>
         void construct(Factory &the_factory)
+        {
+            FinalType *coder = static_cast<FinalType*>(this);
+
+            m_arena.allocate([&](coder_arena &arena)
+                { coder->layout(the_factory, arena); });
+        }
+
+        /// @copydoc layer::layout(Factory&,coder_arena&)
+        template<class Factory>
+        void layout(Factory &the_factory, coder_arena &arena)
         {
             (void) the_factory;
+            (void) arena;
         }
 
         /// @copydoc layer::initialize(Factory&)
@@ -432,6 +459,33 @@ namespace kodo
             m_proxy->subtract(symbol_dest, symbol_src, symbol_length);
         }
 
+        /// @copydoc layer::multiply_add_many(value_type*,
+        ///              const value_type* const*, const value_type*,
+        ///              uint32_t, uint32_t)
+        void multiply_add_many(
+            value_type *symbol_dest, const value_type* const* symbols_src,
+            const value_type *coefficients, uint32_t count,
+            uint32_t symbol_length)
+        {
+            assert(m_proxy);
+            m_proxy->multiply_add_many(symbol_dest, symbols_src,
+                                       coefficients, count, symbol_length);
+        }
+
+        /// @copydoc layer::multiply_subtract_many(value_type*,
+        ///              const value_type* const*, const value_type*,
+        ///              uint32_t, uint32_t)
+        void multiply_subtract_many(
+            value_type *symbol_dest, const value_type* const* symbols_src,
+            const value_type *coefficients, uint32_t count,
+            uint32_t symbol_length)
+        {
+            assert(m_proxy);
+            m_proxy->multiply_subtract_many(symbol_dest, symbols_src,
+                                            coefficients, count,
+                                            symbol_length);
+        }
+
         /// @copydoc layer::invert(value_type)
         value_type invert(value_type value)
         {
@@ -492,11 +546,22 @@ namespace kodo
             return m_proxy->is_symbol_pivot(index);
         }
 
+        /// @copydoc layer::memory_footprint() const
+        uint64_t memory_footprint() const
+        {
+            return sizeof(FinalType) + m_arena.memory_footprint();
+        }
+
     protected:
 
         /// Pointer to the main stack
         MainStack *m_proxy;
 
+    private:
+
+        /// The single allocation holding the buffers of the layers
+        coder_arena_storage m_arena;
+
     };
 
 }
@@ -33,7 +33,9 @@ namespace kodo
         {
             SuperCoder::initialize(the_factory);
 
-            m_proxy = the_factory.proxy_stack();
+            // The main stack is taken from the coder rather than the
+            // factory, which may have been used for other main stacks
+            m_proxy = SuperCoder::proxy_stack();
             assert(m_proxy);
         }
 
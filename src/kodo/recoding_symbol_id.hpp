@@ -12,6 +12,8 @@
 
 #include <fifi/is_binary.hpp>
 
+#include "coder_arena.hpp"
+
 namespace kodo
 {
 
@@ -52,14 +54,39 @@ namespace kodo
 
     public:
 
+        /// Constructor
+        recoding_symbol_id()
+            : m_id_size(0),
+              m_coefficients(0),
+              m_recode_id(0)
+        { }
+
+        /// @copydoc layer::layout(Factory&,coder_arena&)
+        template<class Factory>
+        void layout(Factory& the_factory, coder_arena& arena)
+        {
+            SuperCoder::layout(the_factory, arena);
+
+            // We use aligned storage for both buffers since if the
+            // coefficients are multibyte data types we have to ensure
+            // the de-referencing the pointers are safe.
+            uint32_t max_size = the_factory.max_coefficient_vector_size();
+
+            m_coefficients = arena.allocate<uint8_t>(
+                max_size, coder_arena::vector_alignment);
+
+            m_recode_id = arena.allocate<uint8_t>(
+                max_size, coder_arena::vector_alignment);
+        }
+
         /// @copydoc layer::construct(Factory&)
         template<class Factory>
         void construct(Factory& the_factory)
         {
             SuperCoder::construct(the_factory);
 
-            m_coefficients.resize(the_factory.max_coefficient_vector_size());
-            m_recode_id.resize(the_factory.max_coefficient_vector_size());
+            assert(m_coefficients != 0);
+            assert(m_recode_id != 0);
         }
 
         /// @copydoc layer::initialize(Factory&)
@@ -84,7 +111,7 @@ namespace kodo
             assert(coefficients != 0);
 
             // Zero the symbol id
-            std::fill_n(m_recode_id.begin(), m_id_size, 0);
+            std::fill_n(m_recode_id, m_id_size, 0);
 
             // Prepare the symbol id storage
             sak::mutable_storage id_storage =
@@ -99,25 +126,25 @@ namespace kodo
                 // symbol coefficients and id
                 *coefficients = symbol_id;
                 sak::copy_storage(
-                    id_storage, sak::storage(&m_recode_id[0], m_id_size));
+                    id_storage, sak::storage(m_recode_id, m_id_size));
 
                 return m_id_size;
             }
             else if(symbol_count < SuperCoder::symbols())
             {
-                SuperCoder::generate_partial(&m_coefficients[0]);
+                SuperCoder::generate_partial(m_coefficients);
             }
             else
             {
-                SuperCoder::generate(&m_coefficients[0]);
+                SuperCoder::generate(m_coefficients);
             }
 
             // Create the recoded symbol id
             value_type *recode_id
-                = reinterpret_cast<value_type*>(&m_recode_id[0]);
+                = reinterpret_cast<value_type*>(m_recode_id);
 
             value_type *recode_coefficients
-                = reinterpret_cast<value_type*>(&m_coefficients[0]);
+                = reinterpret_cast<value_type*>(m_coefficients);
 
             for(uint32_t i = 0; i < SuperCoder::symbols(); ++i)
             {
@@ -148,9 +175,9 @@ namespace kodo
             }
 
 
-            *coefficients = &m_coefficients[0];
+            *coefficients = m_coefficients;
             sak::copy_storage(
-                id_storage, sak::storage(&m_recode_id[0], m_id_size));
+                id_storage, sak::storage(m_recode_id, m_id_size));
 
             return m_id_size;
         }
@@ -168,17 +195,11 @@ namespace kodo
         /// coding coefficients
         uint32_t m_id_size;
 
-        /// The storage type - we use aligned storage for both buffers
-        /// since if the coefficients are multibyte data types was have
-        /// to ensure the de-referencing the pointers are safe.
-        typedef std::vector<uint8_t, sak::aligned_allocator<uint8_t> >
-        aligned_vector;
-
         /// Buffer for the recoding coefficients
-        aligned_vector m_coefficients;
+        uint8_t* m_coefficients;
 
         /// Buffer for the recoded id
-        aligned_vector m_recode_id;
+        uint8_t* m_recode_id;
     };
 
 }
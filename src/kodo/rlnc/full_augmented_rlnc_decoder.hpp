@@ -0,0 +1,54 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <kodo/augmented_linear_block_decoder.hpp>
+#include <kodo/augmented_storage.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+
+namespace kodo
+{
+    /// @ingroup fec_stacks
+    /// @brief Complete stack implementing a RLNC decoder which stores
+    ///        the coefficients and the symbol of every row contiguously.
+    ///
+    /// The decoder is compatible with the full_rlnc_encoder. Using the
+    /// augmented_storage every row operation during decoding is a
+    /// single finite field operation covering both the coefficients
+    /// and the symbol. The incoming coefficients are always copied into
+    /// the storage, so the aligned_coefficients_decoder is not needed.
+    template<class Field>
+    class full_augmented_rlnc_decoder : public
+        // Payload API
+        payload_recoder<recoding_stack,
+        payload_decoder<
+        // Codec Header API
+        systematic_decoder<
+        symbol_id_decoder<
+        // Symbol ID API
+        plain_symbol_id_reader<
+        // Decoder API
+        augmented_linear_block_decoder<
+        forward_linear_block_decoder<
+        symbol_decoding_status_counter<
+        symbol_decoding_status_tracker<
+        // Coefficient Storage API
+        coefficient_value_access<
+        augmented_storage<
+        coefficient_info<
+        // Storage API
+        storage_bytes_used<
+        storage_block_info<
+        // Finite Field API
+        finite_field_math<typename fifi::default_field<Field>::type,
+        finite_field_info<Field,
+        // Factory API
+        final_coder_factory_pool<
+        // Final type
+        full_augmented_rlnc_decoder<Field>
+        > > > > > > > > > > > > > > > > >
+    { };
+}
@@ -0,0 +1,56 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <kodo/batch_linear_block_decoder.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+
+namespace kodo
+{
+    /// @ingroup fec_stacks
+    /// @brief Complete stack implementing a RLNC decoder which can
+    ///        decode several payloads as a single batch.
+    ///
+    /// The decoder is identical to the full_rlnc_decoder except for
+    /// the batch_linear_block_decoder layer, which makes it possible
+    /// to pass a burst of payloads to decode(uint8_t**,uint32_t). The
+    /// burst is eliminated as one block, which means that every stored
+    /// symbol is only traversed once per batch instead of once per
+    /// payload.
+    template<class Field>
+    class full_batch_rlnc_decoder : public
+        // Payload API
+        payload_recoder<recoding_stack,
+        payload_decoder<
+        // Codec Header API
+        systematic_decoder<
+        symbol_id_decoder<
+        // Symbol ID API
+        plain_symbol_id_reader<
+        // Decoder API
+        aligned_coefficients_decoder<
+        batch_linear_block_decoder<
+        forward_linear_block_decoder<
+        symbol_decoding_status_counter<
+        symbol_decoding_status_tracker<
+        // Coefficient Storage API
+        coefficient_value_access<
+        coefficient_storage<
+        coefficient_info<
+        // Storage API
+        deep_symbol_storage<
+        storage_bytes_used<
+        storage_block_info<
+        // Finite Field API
+        finite_field_math<typename fifi::default_field<Field>::type,
+        finite_field_info<Field,
+        // Factory API
+        final_coder_factory_pool<
+        // Final type
+        full_batch_rlnc_decoder<Field>
+        > > > > > > > > > > > > > > > > > > >
+    { };
+}
@@ -0,0 +1,56 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <kodo/batch_linear_block_encoder.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+
+namespace kodo
+{
+    /// @ingroup fec_stacks
+    /// @brief Complete stack implementing a RLNC encoder which can
+    ///        encode several payloads as a single batch.
+    ///
+    /// The encoder is identical to the full_rlnc_encoder except for
+    /// the batch_linear_block_encoder layer, which makes it possible
+    /// to produce a burst of payloads with
+    /// encode(uint8_t**,uint32_t*,uint32_t). The burst is computed one
+    /// tile at a time, which means that every source symbol is only
+    /// loaded from memory once per batch instead of once per payload.
+    template<class Field>
+    class full_batch_rlnc_encoder : public
+        // Payload Codec API
+        payload_encoder<
+        // Codec Header API
+        default_on_systematic_encoder<
+        symbol_id_encoder<
+        // Symbol ID API
+        plain_symbol_id_writer<
+        // Coefficient Generator API
+        uniform_generator<
+        // Encoder API
+        encode_symbol_tracker<
+        zero_symbol_encoder<
+        batch_linear_block_encoder<
+        linear_block_encoder<
+        storage_aware_encoder<
+        // Coefficient Storage API
+        coefficient_value_access<
+        coefficient_info<
+        // Symbol Storage API
+        deep_symbol_storage<
+        storage_bytes_used<
+        storage_block_info<
+        // Finite Field API
+        finite_field_math<typename fifi::default_field<Field>::type,
+        finite_field_info<Field,
+        // Factory API
+        final_coder_factory_pool<
+        // Final type
+        full_batch_rlnc_encoder<Field>
+        > > > > > > > > > > > > > > > > > >
+    { };
+}
@@ -0,0 +1,55 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <kodo/lazy_linear_block_decoder.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+
+namespace kodo
+{
+    /// @ingroup fec_stacks
+    /// @brief Complete stack implementing a RLNC decoder which defers
+    ///        all arithmetic on the symbol data until full rank.
+    ///
+    /// The decoder is compatible with the full_rlnc_encoder. Only the
+    /// coding coefficients are eliminated as symbols arrive, the
+    /// symbol data is decoded in a single pass once the decoder is
+    /// complete, see the lazy_linear_block_decoder. Since the stored
+    /// symbols are not decoded before the decoder is complete, the
+    /// stack does not support recoding.
+    template<class Field>
+    class full_lazy_rlnc_decoder : public
+        // Payload API
+        payload_decoder<
+        // Codec Header API
+        systematic_decoder<
+        symbol_id_decoder<
+        // Symbol ID API
+        plain_symbol_id_reader<
+        // Decoder API
+        aligned_coefficients_decoder<
+        lazy_linear_block_decoder<
+        forward_linear_block_decoder<
+        symbol_decoding_status_counter<
+        symbol_decoding_status_tracker<
+        // Coefficient Storage API
+        coefficient_value_access<
+        coefficient_storage<
+        coefficient_info<
+        // Storage API
+        deep_symbol_storage<
+        storage_bytes_used<
+        storage_block_info<
+        // Finite Field API
+        finite_field_math<typename fifi::default_field<Field>::type,
+        finite_field_info<Field,
+        // Factory API
+        final_coder_factory_pool<
+        // Final type
+        full_lazy_rlnc_decoder<Field>
+        > > > > > > > > > > > > > > > > > >
+    { };
+}
@@ -0,0 +1,57 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <kodo/m4ri_linear_block_decoder.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+
+namespace kodo
+{
+    /// @ingroup fec_stacks
+    /// @brief Complete stack implementing a RLNC decoder for the binary
+    ///        field using the Method of Four Russians.
+    ///
+    /// The decoder can replace the full_rlnc_decoder<fifi::binary>. It
+    /// uses deep symbol storage and supports recoding, but the final
+    /// backward substitution is performed by the
+    /// m4ri_linear_block_decoder once full rank is reached. Since the
+    /// fused_copy_decoder substitutes backwards immediately, the stack
+    /// does not decode read-only payloads. Only fifi::binary is
+    /// supported.
+    template<class Field>
+    class full_m4ri_rlnc_decoder : public
+        // Payload API
+        payload_recoder<recoding_stack,
+        payload_decoder<
+        // Codec Header API
+        systematic_decoder<
+        symbol_id_decoder<
+        // Symbol ID API
+        plain_symbol_id_reader<
+        // Decoder API
+        aligned_coefficients_decoder<
+        m4ri_linear_block_decoder<
+        forward_linear_block_decoder<
+        symbol_decoding_status_counter<
+        symbol_decoding_status_tracker<
+        // Coefficient Storage API
+        coefficient_value_access<
+        coefficient_storage<
+        coefficient_info<
+        // Storage API
+        deep_symbol_storage<
+        storage_bytes_used<
+        storage_block_info<
+        // Finite Field API
+        finite_field_math<typename fifi::default_field<Field>::type,
+        finite_field_info<Field,
+        // Factory API
+        final_coder_factory_pool<
+        // Final type
+        full_m4ri_rlnc_decoder<Field>
+        > > > > > > > > > > > > > > > > > > >
+    { };
+}
@@ -16,3 +16,11 @@
 #include "shallow_backward_full_rlnc_decoder.hpp"
 #include "shallow_full_delayed_rlnc_decoder.hpp"
 #include "shallow_sparse_full_rlnc_encoder.hpp"
+#include "full_batch_rlnc_decoder.hpp"
+#include "full_batch_rlnc_encoder.hpp"
+#include "full_lazy_rlnc_decoder.hpp"
+#include "full_augmented_rlnc_decoder.hpp"
+#include "full_m4ri_rlnc_decoder.hpp"
+#include "full_zero_copy_rlnc_encoder.hpp"
+#include "shallow_full_zero_copy_rlnc_encoder.hpp"
+#include "shallow_full_m4ri_rlnc_decoder.hpp"
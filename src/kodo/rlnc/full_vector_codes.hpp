@@ -10,6 +10,7 @@
 #include <fifi/default_field.hpp>
 
 #include "../aligned_coefficients_decoder.hpp"
+#include "../fused_copy_decoder.hpp"
 #include "../final_coder_factory_pool.hpp"
 #include "../final_coder_factory.hpp"
 #include "../finite_field_math.hpp"
@@ -137,6 +138,8 @@ namespace kodo
     /// described for the encoder):
     /// - Recoding using the recoding_stack
     /// - Linear block decoder using Gauss-Jordan elimination.
+    /// - Decoding of read-only payloads without copying the symbol
+    ///   data using the fused_copy_decoder
     template<class Field>
     class full_rlnc_decoder
         : public // Payload API
@@ -149,6 +152,7 @@ namespace kodo
                  plain_symbol_id_reader<
                  // Decoder API
                  aligned_coefficients_decoder<
+                 fused_copy_decoder<
                  forward_linear_block_decoder<
                  symbol_decoding_status_counter<
                  symbol_decoding_status_tracker<
@@ -167,7 +171,7 @@ namespace kodo
                  final_coder_factory_pool<
                  // Final type
                  full_rlnc_decoder<Field>
-                     > > > > > > > > > > > > > > > > > >
+                     > > > > > > > > > > > > > > > > > > >
     { };
 
     /// @ingroup fec_stacks
@@ -0,0 +1,56 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <kodo/rlnc/full_vector_codes.hpp>
+#include <kodo/zero_copy_encoder.hpp>
+
+namespace kodo
+{
+    /// @ingroup fec_stacks
+    /// @brief Complete stack implementing a RLNC encoder which can
+    ///        produce payloads without copying the uncoded symbols.
+    ///
+    /// The encoder is identical to the full_rlnc_encoder except for the
+    /// zero_copy_encoder layer, which allows payloads to be produced
+    /// with encode_iovec(). Uncoded symbols are then referenced in the
+    /// symbol storage and coded symbols are written to a buffer of the
+    /// maximum symbol size, which the full_rlnc_encoder does not
+    /// allocate.
+    template<class Field>
+    class full_zero_copy_rlnc_encoder : public
+        // Payload Codec API
+        payload_encoder<
+        // Codec Header API
+        default_on_systematic_encoder<
+        symbol_id_encoder<
+        // Symbol ID API
+        plain_symbol_id_writer<
+        // Coefficient Generator API
+        uniform_generator<
+        // Encoder API
+        encode_symbol_tracker<
+        zero_symbol_encoder<
+        zero_copy_encoder<
+        linear_block_encoder<
+        storage_aware_encoder<
+        // Coefficient Storage API
+        coefficient_value_access<
+        coefficient_info<
+        // Symbol Storage API
+        deep_symbol_storage<
+        storage_bytes_used<
+        storage_block_info<
+        // Finite Field API
+        finite_field_math<typename fifi::default_field<Field>::type,
+        finite_field_info<Field,
+        // Factory API
+        final_coder_factory_pool<
+        // Final type
+        full_zero_copy_rlnc_encoder<Field>
+        > > > > > > > > > > > > > > > > > >
+    { };
+}
@@ -31,6 +31,8 @@
 #include "../seed_symbol_id_writer.hpp"
 #include "../seed_symbol_id_reader.hpp"
 #include "../uniform_generator.hpp"
+#include "../fast_uniform_generator.hpp"
+#include "../cached_coefficient_generator.hpp"
 #include "../recoding_symbol_id.hpp"
 #include "../proxy_layer.hpp"
 #include "../storage_aware_encoder.hpp"
@@ -100,6 +102,9 @@ namespace kodo
     /// Adds the following features (including those described for
     /// the encoder):
     /// - Linear block decoder using Gauss-Jordan elimination.
+    /// - Optional cache of the generated coefficient vectors shared by
+    ///   all decoders built by the same factory, see
+    ///   cached_coefficient_generator.
     template<class Field>
     class seed_rlnc_decoder
         : public // Payload API
@@ -110,6 +115,7 @@ namespace kodo
                  // Symbol ID API
                  seed_symbol_id_reader<
                  // Coefficient Generator API
+                 cached_coefficient_generator<
                  uniform_generator<
                  // Decoder API
                  aligned_coefficients_decoder<
@@ -131,9 +137,89 @@ namespace kodo
                  final_coder_factory_pool<
                  // Final type
                  seed_rlnc_decoder<Field>
-                     > > > > > > > > > > > > > > > > > >
+                     > > > > > > > > > > > > > > > > > > >
     { };
 
-}
+    /// @ingroup fec_stacks
+    /// @brief Seed based RLNC encoder using the fast_uniform_generator.
+    ///
+    /// The encoder is identical to the seed_rlnc_encoder except for the
+    /// coefficient generator, which makes it incompatible with the
+    /// seed_rlnc_decoder. It must be used with the
+    /// fast_seed_rlnc_decoder.
+    template<class Field>
+    class fast_seed_rlnc_encoder
+        : public // Payload Codec API
+                 payload_encoder<
+                 // Codec Header API
+                 default_on_systematic_encoder<
+                 symbol_id_encoder<
+                 // Symbol ID API
+                 seed_symbol_id_writer<
+                 // Coefficient Generator API
+                 fast_uniform_generator<
+                 // Encoder API
+                 encode_symbol_tracker<
+                 zero_symbol_encoder<
+                 linear_block_encoder<
+                 storage_aware_encoder<
+                 // Coefficient Storage API
+                 coefficient_value_access<
+                 coefficient_info<
+                 // Symbol Storage API
+                 deep_symbol_storage<
+                 storage_bytes_used<
+                 storage_block_info<
+                 // Finite Field API
+                 finite_field_math<typename fifi::default_field<Field>::type,
+                 finite_field_info<Field,
+                 // Factory API
+                 final_coder_factory_pool<
+                 // Final type
+                 fast_seed_rlnc_encoder<Field>
+                     > > > > > > > > > > > > > > > > >
+    { };
 
+    /// @ingroup fec_stacks
+    /// @brief Seed based RLNC decoder using the fast_uniform_generator.
+    ///
+    /// The decoder is identical to the seed_rlnc_decoder except for the
+    /// coefficient generator, with the generation of coefficients for
+    /// every received symbol being considerably cheaper. It decodes
+    /// the symbols produced by the fast_seed_rlnc_encoder.
+    template<class Field>
+    class fast_seed_rlnc_decoder
+        : public // Payload API
+                 payload_decoder<
+                 // Codec Header API
+                 systematic_decoder<
+                 symbol_id_decoder<
+                 // Symbol ID API
+                 seed_symbol_id_reader<
+                 // Coefficient Generator API
+                 cached_coefficient_generator<
+                 fast_uniform_generator<
+                 // Decoder API
+                 aligned_coefficients_decoder<
+                 forward_linear_block_decoder<
+                 symbol_decoding_status_counter<
+                 symbol_decoding_status_tracker<
+                 // Coefficient Storage API
+                 coefficient_value_access<
+                 coefficient_storage<
+                 coefficient_info<
+                 // Storage API
+                 deep_symbol_storage<
+                 storage_bytes_used<
+                 storage_block_info<
+                 // Finite Field Math API
+                 finite_field_math<typename fifi::default_field<Field>::type,
+                 finite_field_info<Field,
+                 // Factory API
+                 final_coder_factory_pool<
+                 // Final type
+                 fast_seed_rlnc_decoder<Field>
+                     > > > > > > > > > > > > > > > > > > >
+    { };
 
+}
@@ -0,0 +1,56 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <kodo/m4ri_linear_block_decoder.hpp>
+#include <kodo/shallow_symbol_storage.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+
+namespace kodo
+{
+    /// @ingroup fec_stacks
+    /// @brief Complete stack implementing a shallow storage RLNC
+    ///        decoder for the binary field using the Method of Four
+    ///        Russians.
+    ///
+    /// The decoder is identical to the shallow_full_delayed_rlnc_decoder
+    /// except that the final backward substitution is performed by the
+    /// m4ri_linear_block_decoder, which reduces the number of symbol
+    /// additions for large generations. Only fifi::binary is supported.
+    template<class Field>
+    class shallow_full_m4ri_rlnc_decoder : public
+        // Payload API
+        payload_recoder<recoding_stack,
+        payload_decoder<
+        // Codec Header API
+        systematic_decoder<
+        symbol_id_decoder<
+        // Symbol ID API
+        plain_symbol_id_reader<
+        // Decoder API
+        aligned_coefficients_decoder<
+        m4ri_linear_block_decoder<
+        forward_linear_block_decoder<
+        symbol_decoding_status_counter<
+        symbol_decoding_status_tracker<
+        // Coefficient Storage API
+        coefficient_value_access<
+        coefficient_storage<
+        coefficient_info<
+        // Storage API
+        mutable_shallow_symbol_storage<
+        storage_bytes_used<
+        storage_block_info<
+        // Finite Field API
+        finite_field_math<typename fifi::default_field<Field>::type,
+        finite_field_info<Field,
+        // Factory API
+        final_coder_factory_pool<
+        // Final type
+        shallow_full_m4ri_rlnc_decoder<Field>
+        > > > > > > > > > > > > > > > > > > >
+    { };
+}
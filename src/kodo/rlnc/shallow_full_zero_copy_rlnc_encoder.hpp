@@ -0,0 +1,55 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <kodo/partial_shallow_symbol_storage.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+#include <kodo/zero_copy_encoder.hpp>
+
+namespace kodo
+{
+    /// @ingroup fec_stacks
+    /// @brief Complete stack implementing a shallow storage RLNC encoder
+    ///        which can produce payloads without copying the uncoded
+    ///        symbols.
+    ///
+    /// The encoder is identical to the shallow_full_rlnc_encoder except
+    /// for the zero_copy_encoder layer, see the
+    /// full_zero_copy_rlnc_encoder.
+    template<class Field>
+    class shallow_full_zero_copy_rlnc_encoder : public
+        // Payload Codec API
+        payload_encoder<
+        // Codec Header API
+        default_on_systematic_encoder<
+        symbol_id_encoder<
+        // Symbol ID API
+        plain_symbol_id_writer<
+        // Coefficient Generator API
+        uniform_generator<
+        // Encoder API
+        encode_symbol_tracker<
+        zero_symbol_encoder<
+        zero_copy_encoder<
+        linear_block_encoder<
+        storage_aware_encoder<
+        // Coefficient Storage API
+        coefficient_value_access<
+        coefficient_info<
+        // Symbol Storage API
+        partial_shallow_symbol_storage<
+        storage_bytes_used<
+        storage_block_info<
+        // Finite Field API
+        finite_field_math<typename fifi::default_field<Field>::type,
+        finite_field_info<Field,
+        // Factory API
+        final_coder_factory_pool<
+        // Final type
+        shallow_full_zero_copy_rlnc_encoder<Field>
+        > > > > > > > > > > > > > > > > > >
+    { };
+}
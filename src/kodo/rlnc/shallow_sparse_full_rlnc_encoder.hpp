@@ -11,6 +11,8 @@
 #include <kodo/partial_shallow_symbol_storage.hpp>
 #include <kodo/rlnc/full_vector_codes.hpp>
 #include <kodo/shallow_symbol_storage.hpp>
+#include <kodo/sparse_linear_block_encoder.hpp>
+#include <kodo/sparse_symbol_id_encoder.hpp>
 #include <kodo/sparse_uniform_generator.hpp>
 
 namespace kodo
@@ -23,14 +25,17 @@ namespace kodo
     /// the fact that is uses a shallow storage layer. Furthermore the
     /// RLNC encoder using a density based random generator, which can be
     /// used to control the density i.e. the number of non-zero elements in
-    /// the encoding vector.
+    /// the encoding vector. The sparse_symbol_id_encoder passes the
+    /// non-zero coefficients listed by the generator directly to the
+    /// sparse_linear_block_encoder, so the encoding cost only depends on
+    /// the density.
     template<class Field>
     class shallow_sparse_full_rlnc_encoder : public
         // Payload Codec API
         payload_encoder<
         // Codec Header API
         default_on_systematic_encoder<
-        symbol_id_encoder<
+        sparse_symbol_id_encoder<
         // Symbol ID API
         plain_symbol_id_writer<
         // Coefficient Generator API
@@ -38,6 +43,7 @@ namespace kodo
         // Encoder API
         encode_symbol_tracker<
         zero_symbol_encoder<
+        sparse_linear_block_encoder<
         linear_block_encoder<
         storage_aware_encoder<
         // Coefficient Storage API
@@ -54,6 +60,6 @@ namespace kodo
         final_coder_factory_pool<
         // Final type
         shallow_sparse_full_rlnc_encoder<Field
-        > > > > > > > > > > > > > > > > > >
+        > > > > > > > > > > > > > > > > > > >
     { };
 }
@@ -46,11 +46,11 @@ namespace kodo
                              m_matrix->row_size());
 
             sak::mutable_storage dest =
-                sak::storage(m_coefficients);
+                sak::storage(m_coefficients, m_matrix->row_size());
 
             sak::copy_storage(dest, src);
 
-            *symbol_coefficients = &m_coefficients[0];
+            *symbol_coefficients = m_coefficients;
         }
 
     private:
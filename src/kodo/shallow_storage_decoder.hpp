@@ -68,7 +68,7 @@ namespace kodo
             ///         does not fully cover all decoders we may require
             ///         additional memory to be able to provide all
             ///         decoders with the memory needed.
-            uint32_t total_block_size(uint32_t object_size) const
+            uint64_t total_block_size(uint64_t object_size) const
             {
                 partitioning p(DecoderType::factory::max_symbols(),
                                DecoderType::factory::max_symbol_size(),
@@ -86,7 +86,7 @@ namespace kodo
         /// @param decoding_buffer The storage where the object will be
         ///        decoded. The memory used must be zero initialized.
         shallow_storage_decoder(
-            factory &factory, uint32_t object_size,
+            factory &factory, uint64_t object_size,
             const sak::mutable_storage &decoding_storage) :
             base_decoder(factory, object_size),
             m_decoding_storage(decoding_storage)
@@ -101,7 +101,7 @@ namespace kodo
         {
             auto decoder = base_decoder::build(decoder_id);
 
-            uint32_t offset = m_partitioning.byte_offset(decoder_id);
+            uint64_t offset = m_partitioning.byte_offset(decoder_id);
             uint32_t block_size = m_partitioning.block_size(decoder_id);
 
             sak::mutable_storage data = m_decoding_storage + offset;
@@ -0,0 +1,95 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+#include <vector>
+
+namespace kodo
+{
+
+    /// @ingroup encoder_layers
+    /// @brief Linear block encoder which combines the source symbols
+    ///        listed by a sparse coefficient generator.
+    ///
+    /// The linear_block_encoder inspects the coefficient of every
+    /// source symbol, which for sparse coefficient vectors means that
+    /// most of the work is spent skipping zeros. This layer adds the
+    /// encode_nonzero() function, which is given the list of non-zero
+    /// coefficients written by the generate_nonzero() function of the
+    /// sparse_uniform_generator, so the cost of encoding only depends
+    /// on the number of non-zero coefficients. The encode_symbol()
+    /// functions are forwarded to the layer below.
+    ///
+    /// The list is passed down by the sparse_symbol_id_encoder through
+    /// the encode_symbol_tracker and zero_symbol_encoder layers, so the
+    /// destination buffer is already zeroed.
+    template<class SuperCoder>
+    class sparse_linear_block_encoder : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::value_type
+        typedef typename SuperCoder::value_type value_type;
+
+    public:
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory& the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            m_sources.resize(the_factory.max_symbols());
+        }
+
+        /// Encodes a symbol from a list of non-zero coefficients
+        /// @param symbol_data The zero initialized destination buffer for
+        ///        the encoded symbol
+        /// @param indices The symbol indices of the non-zero coefficients
+        /// @param values The values of the non-zero coefficients
+        /// @param count The number of non-zero coefficients
+        void encode_nonzero(uint8_t *symbol_data, const uint32_t *indices,
+                            const value_type *values, uint32_t count)
+        {
+            assert(symbol_data != 0);
+            assert(count <= SuperCoder::symbols());
+
+            if(count == 0)
+                return;
+
+            assert(indices != 0);
+            assert(values != 0);
+
+            for(uint32_t k = 0; k < count; ++k)
+            {
+                const value_type *symbol_k =
+                    SuperCoder::symbol_value(indices[k]);
+
+                // Did you forget to set the data on the encoder?
+                assert(symbol_k != 0);
+
+                assert(SuperCoder::is_symbol_pivot(indices[k]));
+
+                m_sources[k] = symbol_k;
+            }
+
+            value_type *symbol =
+                reinterpret_cast<value_type*>(symbol_data);
+
+            SuperCoder::multiply_add_many(symbol, &m_sources[0], values,
+                count, SuperCoder::symbol_length());
+        }
+
+    private:
+
+        /// The symbols combined in the encoded symbol
+        std::vector<const value_type*> m_sources;
+
+    };
+
+}
@@ -0,0 +1,107 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+#include <vector>
+
+namespace kodo
+{
+
+    /// @ingroup codec_header_layers
+    ///
+    /// @brief Writes the symbol id into the symbol header and encodes
+    ///        the symbol from the non-zero coefficients of the id.
+    ///
+    /// The layer is used in place of the symbol_id_encoder with plain
+    /// symbol ids, i.e. the symbol id is the coefficient vector. It
+    /// generates the coefficient vector directly into the symbol header
+    /// with layer::generate_nonzero() and hands the listed non-zero
+    /// coefficients to layer::encode_nonzero(). The call passes through
+    /// the encoder layers like layer::encode_symbol() does, e.g. the
+    /// encode_symbol_tracker counts the symbol and the
+    /// zero_symbol_encoder zeroes the buffer, before the
+    /// sparse_linear_block_encoder combines the source symbols.
+    template<class SuperCoder>
+    class sparse_symbol_id_encoder : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::value_type
+        typedef typename SuperCoder::value_type value_type;
+
+    public:
+
+        /// @ingroup factory_layers
+        /// The factory layer associated with this coder.
+        /// In this case only needed to provide the max_header_size()
+        /// function.
+        class factory : public SuperCoder::factory
+        {
+        public:
+
+            /// @copydoc layer::factory::factory(uint32_t,uint32_t)
+            factory(uint32_t max_symbols, uint32_t max_symbol_size)
+                : SuperCoder::factory(max_symbols, max_symbol_size)
+            { }
+
+            /// @copydoc layer::factory::max_header_size() const
+            uint32_t max_header_size() const
+            {
+                return SuperCoder::factory::max_id_size();
+            }
+
+        };
+
+    public:
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory& the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            m_indices.resize(the_factory.max_symbols());
+            m_values.resize(the_factory.max_symbols());
+        }
+
+        /// @copydoc layer::encode(uint8_t*, uint8_t*)
+        uint32_t encode(uint8_t *symbol_data, uint8_t *symbol_header)
+        {
+            assert(symbol_data != 0);
+            assert(symbol_header != 0);
+
+            // The plain symbol id is the coefficient vector
+            assert(SuperCoder::id_size() ==
+                   SuperCoder::coefficient_vector_size());
+
+            uint32_t count = SuperCoder::generate_nonzero(
+                symbol_header, &m_indices[0], &m_values[0]);
+
+            SuperCoder::encode_nonzero(
+                symbol_data, &m_indices[0], &m_values[0], count);
+
+            return SuperCoder::id_size();
+        }
+
+        /// @copydoc layer::header_size() const
+        uint32_t header_size() const
+        {
+            return SuperCoder::id_size();
+        }
+
+    private:
+
+        /// The symbol indices of the non-zero coefficients
+        std::vector<uint32_t> m_indices;
+
+        /// The values of the non-zero coefficients
+        std::vector<value_type> m_values;
+
+    };
+
+}
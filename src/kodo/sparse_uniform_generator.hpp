@@ -20,6 +20,11 @@ namespace kodo
     /// @ingroup coefficient_generator_layers
     /// @brief Generate uniformly distributed coefficients with a specific
     /// density
+    ///
+    /// Besides writing the coefficient vector, generate_nonzero() also
+    /// lists the indices and values of the non-zero coefficients. The
+    /// list is handed to the sparse_linear_block_encoder, which
+    /// combines the source symbols without scanning the full vector.
     template<class SuperCoder>
     class sparse_uniform_generator : public SuperCoder
     {
@@ -47,8 +52,25 @@ namespace kodo
 
         /// @copydoc layer::generate(uint8_t*)
         void generate(uint8_t *coefficients)
+        {
+            generate_nonzero(coefficients, 0, 0);
+        }
+
+        /// Generates a coefficient vector and lists its non-zero
+        /// coefficients
+        /// @param coefficients The buffer for the coefficient vector
+        /// @param indices Buffer of at least symbols() elements for the
+        ///        symbol indices of the non-zero coefficients, written in
+        ///        increasing order. May be null if values is null
+        /// @param values Buffer of at least symbols() elements for the
+        ///        values of the non-zero coefficients. May be null if
+        ///        indices is null
+        /// @return The number of non-zero coefficients
+        uint32_t generate_nonzero(uint8_t *coefficients, uint32_t *indices,
+                                  value_type *values)
         {
             assert(coefficients != 0);
+            assert((indices == 0) == (values == 0));
 
             // Since we will not set all coefficients we should ensure
             // that the non specified ones are zero
@@ -56,24 +78,26 @@ namespace kodo
 
             value_type* c = reinterpret_cast<value_type*>(coefficients);
 
+            uint32_t count = 0;
+
             for (uint32_t i = 0; i < SuperCoder::symbols(); ++i)
             {
                 if (m_bernoulli(m_random_generator))
                 {
-                    if (fifi::is_binary<field_type>::value)
+                    value_type coefficient = nonzero_coefficient();
+                    fifi::set_value<field_type>(c, i, coefficient);
+
+                    if (indices != 0)
                     {
-                        fifi::set_value<field_type>(c, i, 1);
+                        indices[count] = i;
+                        values[count] = coefficient;
                     }
-                    else
-                    {
-                        value_type coefficient =
-                            m_value_distribution(m_random_generator);
 
-                        fifi::set_value<field_type>(
-                            c, i, coefficient);
-                    }
+                    ++count;
                 }
             }
+
+            return count;
         }
 
         /// @copydoc layer::generate(uint8_t*)
@@ -98,17 +122,8 @@ namespace kodo
 
                 if (m_bernoulli(m_random_generator))
                 {
-                    if (fifi::is_binary<field_type>::value)
-                    {
-                        fifi::set_value<field_type>(c, i, 1);
-                    }
-                    else
-                    {
-                        value_type coefficient =
-                            m_value_distribution(m_random_generator);
-
-                        fifi::set_value<field_type>(c, i, coefficient);
-                    }
+                    fifi::set_value<field_type>(
+                        c, i, nonzero_coefficient());
                 }
 
             }
@@ -157,6 +172,19 @@ namespace kodo
             return m_bernoulli.p();
         }
 
+    private:
+
+        /// @return A random non-zero coefficient
+        value_type nonzero_coefficient()
+        {
+            if (fifi::is_binary<field_type>::value)
+            {
+                return 1;
+            }
+
+            return m_value_distribution(m_random_generator);
+        }
+
     private:
 
         /// The distribution controlling the density of the coefficients
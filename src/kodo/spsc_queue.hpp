@@ -0,0 +1,195 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include <sak/aligned_allocator.hpp>
+
+#include "coder_arena.hpp"
+
+namespace kodo
+{
+
+    /// @brief Lock-free single producer single consumer queue of
+    ///        payload buffers.
+    ///
+    /// The queue is a ring of a fixed number of slots of a fixed size,
+    /// which are written in place by the producer and read in place by
+    /// the consumer, so a payload is never copied by the queue itself.
+    /// Every slot carries the id of the block the payload belongs to
+    /// and the number of bytes used. The producer and the consumer
+    /// only share the read and write counters, which are updated with
+    /// release semantics once a slot has been written or read.
+    class spsc_queue : boost::noncopyable
+    {
+    public:
+
+        /// Creates an empty queue
+        /// @param capacity The number of slots, must be a power of two
+        ///        so the counters can wrap around
+        /// @param slot_size The size in bytes of a slot
+        spsc_queue(uint32_t capacity, uint32_t slot_size)
+            : m_capacity(capacity),
+              m_slot_size(slot_size),
+              m_ids(capacity),
+              m_sizes(capacity),
+              m_head(0),
+              m_tail(0)
+        {
+            assert(m_capacity > 0);
+            assert((m_capacity & (m_capacity - 1)) == 0);
+            assert(m_slot_size > 0);
+
+            // Keep every slot aligned as required by the finite field
+            // implementations
+            m_slot_stride = static_cast<uint32_t>(
+                coder_arena::align_size(m_slot_size));
+            m_slots.resize(m_capacity * m_slot_stride);
+        }
+
+        /// @return The size in bytes of a slot
+        uint32_t slot_size() const
+        {
+            return m_slot_size;
+        }
+
+        /// Called by the producer to get the next free slot
+        /// @return The slot or zero if the queue is full
+        uint8_t *back()
+        {
+            uint32_t tail = m_tail.load(std::memory_order_relaxed);
+            uint32_t head = m_head.load(std::memory_order_acquire);
+
+            if(tail - head == m_capacity)
+                return 0;
+
+            return slot(tail);
+        }
+
+        /// Called by the producer to hand the slot returned by back()
+        /// to the consumer
+        /// @param id The block id of the payload
+        /// @param size The number of bytes used in the slot
+        void push(uint32_t id, uint32_t size)
+        {
+            assert(size <= m_slot_size);
+
+            uint32_t tail = m_tail.load(std::memory_order_relaxed);
+
+            m_ids[tail % m_capacity] = id;
+            m_sizes[tail % m_capacity] = size;
+
+            m_tail.store(tail + 1, std::memory_order_release);
+        }
+
+        /// Called by the consumer to get the oldest slot
+        /// @param id Set to the block id of the payload
+        /// @param size Set to the number of bytes used in the slot
+        /// @return The slot or zero if the queue is empty
+        uint8_t *front(uint32_t &id, uint32_t &size)
+        {
+            uint32_t head = m_head.load(std::memory_order_relaxed);
+            uint32_t tail = m_tail.load(std::memory_order_acquire);
+
+            if(head == tail)
+                return 0;
+
+            id = m_ids[head % m_capacity];
+            size = m_sizes[head % m_capacity];
+
+            return slot(head);
+        }
+
+        /// Called by the consumer to hand the slot returned by front()
+        /// back to the producer
+        void pop()
+        {
+            uint32_t head = m_head.load(std::memory_order_relaxed);
+
+            assert(head != m_tail.load(std::memory_order_acquire));
+
+            m_head.store(head + 1, std::memory_order_release);
+        }
+
+        /// @return True if the queue has no slots waiting for the
+        ///         consumer
+        bool empty() const
+        {
+            return m_head.load(std::memory_order_acquire) ==
+                m_tail.load(std::memory_order_acquire);
+        }
+
+        /// Backs off while waiting for the other side of a queue. The
+        /// first attempts only yield, after that the thread sleeps so
+        /// idle threads do not take the processor from the busy ones.
+        /// @param attempt The number of failed attempts so far
+        static void back_off(uint32_t attempt)
+        {
+            if(attempt < spin_attempts)
+            {
+                std::this_thread::yield();
+            }
+            else
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+
+    private:
+
+        /// The number of attempts which only yield in back_off()
+        static const uint32_t spin_attempts = 64;
+
+        /// @param position The read or write counter
+        /// @return The slot at the position
+        uint8_t *slot(uint32_t position)
+        {
+            return &m_slots[(position % m_capacity) * m_slot_stride];
+        }
+
+    private:
+
+        /// The storage type of the slots
+        typedef std::vector<uint8_t, sak::aligned_allocator<
+            uint8_t, coder_arena::vector_alignment> > aligned_vector;
+
+        /// The number of slots
+        uint32_t m_capacity;
+
+        /// The size in bytes of a slot
+        uint32_t m_slot_size;
+
+        /// The distance in bytes between the slots
+        uint32_t m_slot_stride;
+
+        /// The slots
+        aligned_vector m_slots;
+
+        /// The block id of every slot
+        std::vector<uint32_t> m_ids;
+
+        /// The bytes used in every slot
+        std::vector<uint32_t> m_sizes;
+
+        /// The number of slots read by the consumer
+        std::atomic<uint32_t> m_head;
+
+        /// Keeps the counters on separate cache lines
+        uint8_t m_padding[64];
+
+        /// The number of slots written by the producer
+        std::atomic<uint32_t> m_tail;
+    };
+
+}
@@ -68,13 +68,15 @@ namespace kodo
             /// @copydoc layer::factory::symbols() const;
             uint32_t symbols() const
             {
-                return m_symbols;
+                const build_scope *scope = build_scope::current(this);
+                return scope ? scope->m_symbols : m_symbols;
             }
 
             /// @copydoc layer::factory::symbol_size() const;
             uint32_t symbol_size() const
             {
-                return m_symbol_size;
+                const build_scope *scope = build_scope::current(this);
+                return scope ? scope->m_symbol_size : m_symbol_size;
             }
 
             /// @copydoc layer::factory::set_symbols(uint32_t)
@@ -95,6 +97,88 @@ namespace kodo
                 m_symbol_size = symbol_size;
             }
 
+        public:
+
+            /// Overrides the symbols and symbol size of the factory for
+            /// the calling thread while it exists. Used to build coders
+            /// from several threads without changing the factory.
+            class build_scope
+            {
+            public:
+
+                /// Starts the override
+                /// @param the_factory The factory to override
+                /// @param symbols The number of symbols to use
+                /// @param symbol_size The symbol size to use
+                build_scope(const factory &the_factory, uint32_t symbols,
+                            uint32_t symbol_size)
+                    : m_factory(&the_factory),
+                      m_symbols(symbols),
+                      m_symbol_size(symbol_size),
+                      m_previous(top())
+                {
+                    assert(m_symbols > 0);
+                    assert(m_symbols <= the_factory.max_symbols());
+                    assert(m_symbol_size > 0);
+                    assert(m_symbol_size <= the_factory.max_symbol_size());
+
+                    top() = this;
+                }
+
+                /// Ends the override
+                ~build_scope()
+                {
+                    assert(top() == this);
+                    top() = m_previous;
+                }
+
+                /// @param the_factory The factory
+                /// @return The innermost override of the factory on the
+                ///         calling thread, or zero if there is none
+                static const build_scope *current(const factory *the_factory)
+                {
+                    const build_scope *scope = top();
+
+                    while(scope != 0 && scope->m_factory != the_factory)
+                        scope = scope->m_previous;
+
+                    return scope;
+                }
+
+            private:
+
+                /// @return The innermost override on the calling thread
+                static const build_scope *&top()
+                {
+                    static thread_local const build_scope *scope = 0;
+                    return scope;
+                }
+
+            public:
+
+                /// The overridden factory
+                const factory *m_factory;
+
+                /// The number of symbols used
+                uint32_t m_symbols;
+
+                /// The symbol size used
+                uint32_t m_symbol_size;
+
+            private:
+
+                /// The enclosing override
+                const build_scope *m_previous;
+
+            private: // Make non-copyable
+
+                /// Copy constructor
+                build_scope(const build_scope&);
+
+                /// Copy assignment
+                const build_scope& operator=(const build_scope&);
+            };
+
         private:
 
             /// The maximum number of symbols
@@ -41,7 +41,7 @@ namespace kodo
         }
 
         /// @return the size of the storage object in bytes
-        uint32_t size() const
+        uint64_t size() const
         {
             return m_storage.m_size;
         }
@@ -50,13 +50,13 @@ namespace kodo
         /// @param encoder to be initialized
         /// @param offset in bytes into the storage object
         /// @param size the number of bytes to use
-        void read(pointer &encoder, uint32_t offset, uint32_t size)
+        void read(pointer &encoder, uint64_t offset, uint32_t size)
         {
             assert(encoder);
             assert(offset < m_storage.m_size);
             assert(size > 0);
 
-            uint32_t remaining_bytes = m_storage.m_size - offset;
+            uint64_t remaining_bytes = m_storage.m_size - offset;
 
             assert(size <= remaining_bytes);
 
@@ -0,0 +1,207 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace kodo
+{
+
+    /// @brief Persistent pool of worker threads executing a number of
+    ///        independent stripes of work.
+    ///
+    /// The stripes of a run are handed out through a shared atomic
+    /// counter, so a thread which finishes its stripe early simply
+    /// takes the next one. The calling thread participates in the work
+    /// and run() returns once all stripes have been executed.
+    ///
+    /// The pool executes one run at a time. If run() is called while
+    /// another thread's run is in progress, the calling thread does not
+    /// wait for the workers but executes all of its stripes itself, so
+    /// concurrent users of a shared pool never block each other.
+    class stripe_thread_pool : boost::noncopyable
+    {
+    public:
+
+        /// The function executed for every stripe, invoked with the
+        /// index of the stripe and the index of the executing thread
+        typedef std::function<void (uint32_t, uint32_t)> function_type;
+
+    public:
+
+        /// Creates the pool and starts the worker threads
+        /// @param threads The number of worker threads, not counting
+        ///        the thread calling run()
+        stripe_thread_pool(uint32_t threads)
+            : m_function(0),
+              m_stripes(0),
+              m_next(0),
+              m_generation(0),
+              m_active(0),
+              m_stop(false)
+        {
+            for(uint32_t i = 0; i < threads; ++i)
+            {
+                m_threads.push_back(
+                    std::thread(&stripe_thread_pool::worker, this, i + 1));
+            }
+        }
+
+        /// Stops and joins the worker threads
+        ~stripe_thread_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+
+            m_start.notify_all();
+
+            for(auto& thread : m_threads)
+            {
+                thread.join();
+            }
+        }
+
+        /// @return The number of worker threads
+        uint32_t threads() const
+        {
+            return static_cast<uint32_t>(m_threads.size());
+        }
+
+        /// Executes the function for every stripe in [0:stripes) and
+        /// waits for all stripes to complete
+        /// @param stripes The number of stripes
+        /// @param function The function invoked with the stripe index
+        ///        and the index of the executing thread. The index is in
+        ///        [0:threads()], the calling thread always has index 0,
+        ///        so per thread state can be kept in threads() + 1 slots
+        void run(uint32_t stripes, const function_type& function)
+        {
+            std::unique_lock<std::mutex> run_lock(
+                m_run_mutex, std::try_to_lock);
+
+            if(!run_lock.owns_lock())
+            {
+                // The workers are busy with the run of another thread
+                for(uint32_t stripe = 0; stripe < stripes; ++stripe)
+                    function(stripe, 0);
+
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                m_function = &function;
+                m_stripes = stripes;
+                m_next = 0;
+                m_active = threads();
+                ++m_generation;
+            }
+
+            m_start.notify_all();
+
+            execute(0);
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_done.wait(lock, [this] { return m_active == 0; });
+
+            m_function = 0;
+        }
+
+    private:
+
+        /// The loop of the worker threads
+        /// @param index The index of the worker thread
+        void worker(uint32_t index)
+        {
+            uint32_t generation = 0;
+
+            while(true)
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+
+                m_start.wait(lock, [&] {
+                    return m_stop || m_generation != generation; });
+
+                if(m_stop)
+                    return;
+
+                generation = m_generation;
+
+                lock.unlock();
+
+                execute(index);
+
+                lock.lock();
+
+                assert(m_active > 0);
+
+                if(--m_active == 0)
+                    m_done.notify_one();
+            }
+        }
+
+        /// Executes stripes until all stripes of the run have been taken
+        /// @param index The index of the executing thread
+        void execute(uint32_t index)
+        {
+            assert(m_function);
+
+            for(uint32_t stripe = m_next++; stripe < m_stripes;
+                stripe = m_next++)
+            {
+                (*m_function)(stripe, index);
+            }
+        }
+
+    private:
+
+        /// The worker threads
+        std::vector<std::thread> m_threads;
+
+        /// Held by the thread whose run is executed by the workers
+        std::mutex m_run_mutex;
+
+        /// Protects the state shared with the workers
+        std::mutex m_mutex;
+
+        /// Signals the workers that a run has started
+        std::condition_variable m_start;
+
+        /// Signals the caller that all workers are done
+        std::condition_variable m_done;
+
+        /// The function of the current run
+        const function_type* m_function;
+
+        /// The number of stripes in the current run
+        uint32_t m_stripes;
+
+        /// The next stripe to execute
+        std::atomic<uint32_t> m_next;
+
+        /// Incremented for every run
+        uint32_t m_generation;
+
+        /// The number of workers still executing the current run
+        uint32_t m_active;
+
+        /// True when the workers should exit
+        bool m_stop;
+    };
+
+}
@@ -0,0 +1,155 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+#include <vector>
+
+#include <sak/aligned_allocator.hpp>
+#include <sak/storage.hpp>
+
+#include "coder_arena.hpp"
+
+namespace kodo
+{
+
+    /// @brief Buffers the encoded symbols of a batch between a
+    ///        begin_batch() and end_batch() pair.
+    ///
+    /// Helper layer shared by the batch_linear_block_encoder and the
+    /// batch_linear_block_decoder. The layer using it buffers a symbol
+    /// with buffer_symbol() while is_batch_active() is true and passes
+    /// the buffered symbols on with flush_batch() when the batch ends.
+    template<class SuperCoder>
+    class symbol_batch_buffer : public SuperCoder
+    {
+    public:
+
+        /// Constructor
+        symbol_batch_buffer()
+            : m_batch_active(false),
+              m_batch_size(0),
+              m_batch_stride(0)
+        { }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory& the_factory)
+        {
+            SuperCoder::initialize(the_factory);
+
+            m_batch_active = false;
+            m_batch_size = 0;
+            m_batch_symbols.clear();
+
+            // Keep every buffered coefficient vector aligned as
+            // required by the finite field implementations
+            m_batch_stride = static_cast<uint32_t>(coder_arena::align_size(
+                SuperCoder::coefficient_vector_size()));
+        }
+
+        /// Starts buffering the symbols of a batch
+        void begin_batch()
+        {
+            assert(!m_batch_active);
+            assert(m_batch_size == 0);
+
+            m_batch_active = true;
+        }
+
+        /// @return true if a batch is currently being buffered
+        bool is_batch_active() const
+        {
+            return m_batch_active;
+        }
+
+    protected:
+
+        /// Buffers a symbol of the current batch. The coefficients may
+        /// live in a buffer owned by the layers above which is reused
+        /// for the next symbol, so we keep our own copy. The symbol
+        /// data must stay valid until the batch ends.
+        /// @param symbol_data The data of the symbol
+        /// @param coefficients The coding coefficients of the symbol
+        void buffer_symbol(uint8_t *symbol_data, uint8_t *coefficients)
+        {
+            assert(m_batch_active);
+            assert(symbol_data != 0);
+            assert(coefficients != 0);
+
+            uint32_t offset = m_batch_size * m_batch_stride;
+
+            if(m_batch_coefficients.size() < offset + m_batch_stride)
+                m_batch_coefficients.resize(offset + m_batch_stride);
+
+            auto src = sak::storage(
+                coefficients, SuperCoder::coefficient_vector_size());
+
+            auto dest = sak::storage(
+                &m_batch_coefficients[offset], m_batch_stride);
+
+            sak::copy_storage(dest, src);
+
+            m_batch_symbols.push_back(symbol_data);
+            ++m_batch_size;
+        }
+
+        /// Stops the buffering and passes the buffered symbols on
+        /// @param function Invoked with the array of symbol data
+        ///        pointers, the array of coefficient pointers and the
+        ///        number of buffered symbols, unless the batch is empty
+        template<class Function>
+        void flush_batch(const Function& function)
+        {
+            assert(m_batch_active);
+            m_batch_active = false;
+
+            if(m_batch_size == 0)
+                return;
+
+            m_batch_pointers.resize(m_batch_size);
+
+            for(uint32_t i = 0; i < m_batch_size; ++i)
+            {
+                m_batch_pointers[i] =
+                    &m_batch_coefficients[i * m_batch_stride];
+            }
+
+            function(&m_batch_symbols[0], &m_batch_pointers[0],
+                     m_batch_size);
+
+            m_batch_symbols.clear();
+            m_batch_size = 0;
+        }
+
+    protected:
+
+        /// The storage type used for the buffered coefficients
+        typedef std::vector<uint8_t, sak::aligned_allocator<
+            uint8_t, coder_arena::vector_alignment> > aligned_vector;
+
+        /// True if symbols are currently being buffered
+        bool m_batch_active;
+
+        /// The number of buffered symbols
+        uint32_t m_batch_size;
+
+        /// The distance in bytes between the buffered coefficient vectors
+        uint32_t m_batch_stride;
+
+        /// Copies of the coefficients of the buffered symbols
+        aligned_vector m_batch_coefficients;
+
+        /// The data of the buffered symbols
+        std::vector<uint8_t*> m_batch_symbols;
+
+        /// Pointers to the buffered coefficient vectors
+        std::vector<uint8_t*> m_batch_pointers;
+
+    };
+
+}
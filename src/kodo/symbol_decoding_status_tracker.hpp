@@ -7,8 +7,10 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <algorithm>
 #include <functional>
-#include <vector>
+
+#include "coder_arena.hpp"
 
 namespace kodo
 {
@@ -41,14 +43,32 @@ namespace kodo
 
     public:
 
+        /// Constructor
+        symbol_decoding_status_tracker()
+            : m_status(0),
+              m_status_size(0)
+        { }
+
+        /// @copydoc layer::layout(Factory&,coder_arena&)
+        template<class Factory>
+        void layout(Factory &the_factory, coder_arena &arena)
+        {
+            SuperCoder::layout(the_factory, arena);
+
+            m_status_size = the_factory.max_symbols();
+            m_status =
+                arena.allocate<symbol_decoding_status>(m_status_size);
+        }
+
         /// @copydoc layer::construct(Factory&)
         template<class Factory>
         void construct(Factory &the_factory)
         {
             SuperCoder::construct(the_factory);
 
-            m_status.resize(the_factory.max_symbols(),
-                            symbol_decoding_status::missing);
+            assert(m_status != 0);
+            std::fill_n(m_status, m_status_size,
+                        symbol_decoding_status::missing);
         }
 
         /// @copydoc layer::initialize(Factory&)
@@ -57,59 +77,60 @@ namespace kodo
         {
             SuperCoder::initialize(the_factory);
 
-            std::fill_n(m_status.begin(), the_factory.symbols(),
+            std::fill_n(m_status, the_factory.symbols(),
                         symbol_decoding_status::missing);
         }
 
         /// @copydoc layer::set_symbol_missing(uint32_t)
         void set_symbol_missing(uint32_t index)
         {
-            assert(index < m_status.size());
+            assert(index < m_status_size);
             m_status[index] = symbol_decoding_status::missing;
         }
 
         /// @copydoc layer::set_symbol_seen(uint32_t)
         void set_symbol_seen(uint32_t index)
         {
-            assert(index < m_status.size());
+            assert(index < m_status_size);
             m_status[index] = symbol_decoding_status::seen;
         }
 
         /// @copydoc layer::set_symbol_decoded(uint32_t)
         void set_symbol_decoded(uint32_t index)
         {
-            assert(index < m_status.size());
+            assert(index < m_status_size);
             m_status[index] = symbol_decoding_status::decoded;
         }
 
         /// @copydoc layer::is_symbol_missing(uint32_t) const
         bool is_symbol_missing(uint32_t index) const
         {
-            assert(index < m_status.size());
+            assert(index < m_status_size);
             return m_status[index] == symbol_decoding_status::missing;
         }
 
         /// @copydoc layer::is_symbol_seen(uint32_t) const
         bool is_symbol_seen(uint32_t index) const
         {
-            assert(index < m_status.size());
+            assert(index < m_status_size);
             return m_status[index] == symbol_decoding_status::seen;
         }
 
         /// @copydoc layer::is_symbol_decoded(uint32_t) const
         bool is_symbol_decoded(uint32_t index) const
         {
-            assert(index < m_status.size());
+            assert(index < m_status_size);
             return m_status[index] == symbol_decoding_status::decoded;
         }
 
     public:
 
         /// Tracks whether a symbol is still partially decoded
-        std::vector<symbol_decoding_status> m_status;
+        symbol_decoding_status* m_status;
+
+        /// The number of symbols tracked
+        uint32_t m_status_size;
 
     };
 
 }
-
-
@@ -56,6 +56,21 @@ namespace kodo
             SuperCoder::decode_symbol(symbol_data, coefficients);
         }
 
+        /// @copydoc layer::decode(const uint8_t*, uint8_t*)
+        void decode(const uint8_t *symbol_data, uint8_t *symbol_header)
+        {
+            assert(symbol_data != 0);
+            assert(symbol_header != 0);
+
+            uint8_t *coefficients = 0;
+
+            SuperCoder::read_id(symbol_header, &coefficients);
+
+            assert(coefficients != 0);
+
+            SuperCoder::decode_symbol(symbol_data, coefficients);
+        }
+
         /// @copydoc layer::header_size() const
         uint32_t header_size() const
         {
@@ -87,6 +87,30 @@ namespace kodo
             }
         }
 
+        /// @copydoc layer::decode(const uint8_t*, uint8_t*)
+        void decode(const uint8_t *symbol_data, uint8_t *symbol_header)
+        {
+            assert(symbol_data != 0);
+            assert(symbol_header != 0);
+
+            flag_type flag =
+                sak::big_endian::get<flag_type>(symbol_header);
+
+            symbol_header += sizeof(flag_type);
+
+            if(flag == systematic_base_coder::systematic_flag)
+            {
+                counter_type symbol_index =
+                    sak::big_endian::get<counter_type>(symbol_header);
+
+                SuperCoder::decode_symbol(symbol_data, symbol_index);
+            }
+            else
+            {
+                SuperCoder::decode(symbol_data, symbol_header);
+            }
+        }
+
         /// @copydoc layer::header_size() const
         uint32_t header_size() const
         {
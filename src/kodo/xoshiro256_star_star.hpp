@@ -0,0 +1,87 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+
+namespace kodo
+{
+
+    /// @brief The xoshiro256** pseudo random number generator.
+    ///
+    /// A small and fast generator with a 256 bit state producing 64
+    /// random bits per step. The state is initialized from the seed
+    /// using the splitmix64 generator, so consecutive seeds give
+    /// unrelated sequences. Seeding only costs a few arithmetic
+    /// operations, compared to the 624 word state of the mt19937.
+    class xoshiro256_star_star
+    {
+    public:
+
+        /// The type of the seed
+        typedef uint64_t seed_type;
+
+        /// The type of the generated values
+        typedef uint64_t result_type;
+
+    public:
+
+        /// Constructor
+        /// @param seed_value The initial seed
+        xoshiro256_star_star(seed_type seed_value = 0)
+        {
+            seed(seed_value);
+        }
+
+        /// Resets the state of the generator
+        /// @param seed_value The seed
+        void seed(seed_type seed_value)
+        {
+            uint64_t x = seed_value;
+
+            for(uint32_t i = 0; i < 4; ++i)
+            {
+                // splitmix64
+                uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+                m_state[i] = z ^ (z >> 31);
+            }
+        }
+
+        /// @return The next 64 random bits
+        result_type operator()()
+        {
+            uint64_t result = rotate_left(m_state[1] * 5, 7) * 9;
+            uint64_t t = m_state[1] << 17;
+
+            m_state[2] ^= m_state[0];
+            m_state[3] ^= m_state[1];
+            m_state[1] ^= m_state[2];
+            m_state[0] ^= m_state[3];
+
+            m_state[2] ^= t;
+            m_state[3] = rotate_left(m_state[3], 45);
+
+            return result;
+        }
+
+    private:
+
+        /// @return The value rotated left by k bits
+        static uint64_t rotate_left(uint64_t value, uint32_t k)
+        {
+            return (value << k) | (value >> (64 - k));
+        }
+
+    private:
+
+        /// The state of the generator
+        uint64_t m_state[4];
+
+    };
+
+}
@@ -0,0 +1,136 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+
+#include "coder_arena.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup encoder_layers
+    /// @brief Allows the encoded symbol to be handed out by reference
+    ///        instead of being written to a caller supplied buffer.
+    ///
+    /// While zero copy is enabled an uncoded symbol is not copied, the
+    /// layer instead remembers a pointer to the stored source symbol.
+    /// Coded symbols are written to the buffer returned by
+    /// zero_copy_buffer(). In both cases encoded_symbol() returns the
+    /// symbol data, which is what the
+    /// payload_encoder::encode_iovec(uint8_t*,const uint8_t**) function
+    /// passes on to the caller.
+    ///
+    /// The layer should be placed below the systematic encoder and the
+    /// zero_symbol_encoder and on top of the linear_block_encoder.
+    template<class SuperCoder>
+    class zero_copy_encoder : public SuperCoder
+    {
+    public:
+
+        /// Constructor
+        zero_copy_encoder()
+            : m_zero_copy(false),
+              m_encoded_symbol(0),
+              m_buffer(0)
+        { }
+
+        /// @copydoc layer::layout(Factory&,coder_arena&)
+        template<class Factory>
+        void layout(Factory& the_factory, coder_arena& arena)
+        {
+            SuperCoder::layout(the_factory, arena);
+
+            m_buffer = arena.allocate<uint8_t>(
+                the_factory.max_symbol_size(), coder_arena::vector_alignment);
+        }
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory& the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            assert(m_buffer != 0);
+        }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory& the_factory)
+        {
+            SuperCoder::initialize(the_factory);
+
+            m_zero_copy = false;
+            m_encoded_symbol = 0;
+        }
+
+        /// @copydoc layer::encode_symbol(uint8_t*, uint8_t*)
+        void encode_symbol(uint8_t *symbol_data, uint8_t *coefficients)
+        {
+            assert(symbol_data != 0);
+            assert(coefficients != 0);
+
+            SuperCoder::encode_symbol(symbol_data, coefficients);
+            m_encoded_symbol = symbol_data;
+        }
+
+        /// With zero copy enabled the symbol is only referenced
+        /// @copydoc layer::encode_symbol(uint8_t*,uint32_t)
+        void encode_symbol(uint8_t *symbol_data, uint32_t symbol_index)
+        {
+            assert(symbol_data != 0);
+
+            if(!m_zero_copy)
+            {
+                SuperCoder::encode_symbol(symbol_data, symbol_index);
+                m_encoded_symbol = symbol_data;
+                return;
+            }
+
+            assert(symbol_index < SuperCoder::symbols());
+            assert(SuperCoder::is_symbol_pivot(symbol_index));
+
+            const SuperCoder& self = *this;
+            m_encoded_symbol = self.symbol(symbol_index);
+        }
+
+        /// Enables or disables zero copy of uncoded symbols
+        /// @param zero_copy True if uncoded symbols should be referenced
+        void set_zero_copy(bool zero_copy)
+        {
+            m_zero_copy = zero_copy;
+        }
+
+        /// @return The buffer used for the coded symbols in zero copy
+        ///         mode, its size is the maximum symbol size
+        uint8_t* zero_copy_buffer()
+        {
+            return m_buffer;
+        }
+
+        /// @return The data of the symbol encoded last. The data is
+        ///         valid until the next symbol is encoded or the
+        ///         stored symbols change.
+        const uint8_t* encoded_symbol() const
+        {
+            return m_encoded_symbol;
+        }
+
+    private:
+
+        /// True if uncoded symbols should be referenced
+        bool m_zero_copy;
+
+        /// The data of the symbol encoded last
+        const uint8_t *m_encoded_symbol;
+
+        /// Buffer for the coded symbols
+        uint8_t *m_buffer;
+
+    };
+
+}
@@ -15,6 +15,11 @@ namespace kodo
     template<class SuperCoder>
     class zero_symbol_encoder : public SuperCoder
     {
+    public:
+
+        /// @copydoc layer::value_type
+        typedef typename SuperCoder::value_type value_type;
+
     public:
 
         /// Zero the incoming symbol data buffer and forward
@@ -41,6 +46,20 @@ namespace kodo
             SuperCoder::encode_symbol(symbol_data, symbol_index);
         }
 
+        /// Zero the incoming symbol data buffer and forward
+        /// the encode_nonzero() call.
+        ///
+        /// @copydoc layer::encode_nonzero(uint8_t*, const uint32_t*,
+        ///                               const value_type*, uint32_t)
+        void encode_nonzero(uint8_t *symbol_data, const uint32_t *indices,
+                            const value_type *values, uint32_t count)
+        {
+            assert(symbol_data != 0);
+
+            std::fill_n(symbol_data, SuperCoder::symbol_size(), 0);
+            SuperCoder::encode_nonzero(symbol_data, indices, values, count);
+        }
+
     };
 
 }
@@ -0,0 +1,123 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_augmented_linear_block_decoder.cpp Unit tests for the
+///       kodo::augmented_linear_block_decoder
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <kodo/augmented_linear_block_decoder.hpp>
+#include <kodo/backward_linear_block_decoder.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+#include <kodo/rlnc/full_augmented_rlnc_decoder.hpp>
+#include <kodo/set_systematic_on.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+#include "kodo_unit_test/helper_test_reuse_api.hpp"
+#include "kodo_unit_test/helper_test_recoding_api.hpp"
+#include "kodo_unit_test/helper_test_basic_api.hpp"
+#include "kodo_unit_test/helper_test_initialize_api.hpp"
+#include "kodo_unit_test/helper_test_systematic_api.hpp"
+#include "kodo_unit_test/helper_test_mix_uncoded_api.hpp"
+
+namespace kodo
+{
+
+    // Put dummy layers and tests classes in an anonymous namespace
+    // to avoid violations of ODF (one-definition-rule) in other
+    // translation units
+    namespace
+    {
+
+        template<class Field>
+        class backward_augmented_rlnc_decoder
+            : public // Payload API
+                     payload_decoder<
+                     // Codec Header API
+                     systematic_decoder<
+                     symbol_id_decoder<
+                     // Symbol ID API
+                     plain_symbol_id_reader<
+                     // Decoder API
+                     augmented_linear_block_decoder<
+                     backward_linear_block_decoder<
+                     symbol_decoding_status_counter<
+                     symbol_decoding_status_tracker<
+                     // Coefficient Storage API
+                     coefficient_value_access<
+                     augmented_storage<
+                     coefficient_info<
+                     // Storage API
+                     storage_bytes_used<
+                     storage_block_info<
+                     // Finite Field API
+                     finite_field_math<typename fifi::default_field<Field>::type,
+                     finite_field_info<Field,
+                     // Factory API
+                     final_coder_factory_pool<
+                     // Final type
+                     backward_augmented_rlnc_decoder<Field>
+                         > > > > > > > > > > > > > > > >
+        { };
+
+    }
+}
+
+/// Tests the basic API functionality this mean basic encoding
+/// and decoding
+TEST(TestAugmentedLinearBlockDecoder, test_basic_api)
+{
+    test_basic_api<kodo::full_rlnc_encoder,
+        kodo::full_augmented_rlnc_decoder>();
+
+    test_basic_api<kodo::full_rlnc_encoder,
+        kodo::backward_augmented_rlnc_decoder>();
+}
+
+/// Tests that the decoder can be initialized and reused
+TEST(TestAugmentedLinearBlockDecoder, test_initialize)
+{
+    test_initialize<kodo::full_rlnc_encoder,
+        kodo::full_augmented_rlnc_decoder>();
+}
+
+/// Tests that an encoder producing systematic packets is handled
+/// correctly in the decoder.
+TEST(TestAugmentedLinearBlockDecoder, test_systematic)
+{
+    test_systematic<kodo::full_rlnc_encoder,
+        kodo::full_augmented_rlnc_decoder>();
+}
+
+/// Tests whether mixed un-coded and coded packets are correctly handled
+/// in the decoder.
+TEST(TestAugmentedLinearBlockDecoder, test_mix_uncoded)
+{
+    test_mix_uncoded<kodo::full_rlnc_encoder,
+        kodo::full_augmented_rlnc_decoder>();
+}
+
+/// Tests the recoding
+TEST(TestAugmentedLinearBlockDecoder, test_recoders_api)
+{
+    test_recoders<kodo::full_rlnc_encoder,
+        kodo::full_augmented_rlnc_decoder>();
+
+    test_recoding_relay<kodo::full_rlnc_encoder,
+        kodo::full_augmented_rlnc_decoder>();
+}
+
+/// Tests that the decoder can be reused
+TEST(TestAugmentedLinearBlockDecoder, test_reuse_api)
+{
+    test_reuse<kodo::full_rlnc_encoder,
+        kodo::full_augmented_rlnc_decoder>();
+
+    test_reuse_incomplete<kodo::full_rlnc_encoder,
+        kodo::full_augmented_rlnc_decoder>();
+}
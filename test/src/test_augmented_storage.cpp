@@ -0,0 +1,66 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_augmented_storage.cpp Unit tests for the
+///       kodo::augmented_storage
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <sak/is_aligned.hpp>
+
+#include <kodo/augmented_storage.hpp>
+#include <kodo/rlnc/full_augmented_rlnc_decoder.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+/// Tests the layout of the rows in the augmented storage
+TEST(TestAugmentedStorage, test_layout)
+{
+    typedef fifi::binary8 field_type;
+    typedef kodo::full_augmented_rlnc_decoder<field_type> decoder_type;
+
+    decoder_type::factory factory(10, 100);
+
+    auto decoder = factory.build();
+
+    EXPECT_EQ(32U, decoder->augmented_symbol_offset());
+    EXPECT_EQ(132U, decoder->augmented_row_length());
+
+    for(uint32_t i = 0; i < decoder->symbols(); ++i)
+    {
+        const uint8_t *row =
+            reinterpret_cast<const uint8_t*>(decoder->augmented_row(i));
+
+        EXPECT_EQ(row, decoder->coefficient_vector_data(i));
+        EXPECT_EQ(row + 32, decoder->symbol(i));
+
+        EXPECT_TRUE(sak::is_aligned(decoder->coefficient_vector_data(i)));
+        EXPECT_TRUE(sak::is_aligned(decoder->symbol(i)));
+    }
+
+    // Exchanging a row with the spare row does not copy
+    uint8_t *spare = reinterpret_cast<uint8_t*>(decoder->spare_row());
+    uint8_t *row = reinterpret_cast<uint8_t*>(decoder->augmented_row(3));
+
+    decoder->swap_spare_row(3);
+
+    EXPECT_EQ(spare, reinterpret_cast<uint8_t*>(decoder->augmented_row(3)));
+    EXPECT_EQ(row, reinterpret_cast<uint8_t*>(decoder->spare_row()));
+    EXPECT_EQ(spare + 32, decoder->symbol(3));
+
+    // Setting and copying the symbols
+    std::vector<uint8_t> data_in = random_vector(decoder->block_size());
+    decoder->set_symbols(sak::storage(data_in));
+
+    EXPECT_TRUE(decoder->is_symbols_initialized());
+
+    std::vector<uint8_t> data_out(decoder->block_size());
+    decoder->copy_symbols(sak::storage(data_out));
+
+    EXPECT_TRUE(std::equal(data_in.begin(), data_in.end(),
+                           data_out.begin()));
+}
@@ -0,0 +1,273 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_batch_linear_block_decoder.cpp Unit tests for the
+///       kodo::batch_linear_block_decoder
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <kodo/batch_linear_block_decoder.hpp>
+#include <kodo/backward_linear_block_decoder.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+#include <kodo/rlnc/full_batch_rlnc_decoder.hpp>
+#include <kodo/set_systematic_on.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+#include "kodo_unit_test/helper_test_reuse_api.hpp"
+#include "kodo_unit_test/helper_test_recoding_api.hpp"
+#include "kodo_unit_test/helper_test_basic_api.hpp"
+#include "kodo_unit_test/helper_test_systematic_api.hpp"
+#include "kodo_unit_test/helper_test_mix_uncoded_api.hpp"
+
+namespace kodo
+{
+
+    // Put dummy layers and tests classes in an anonymous namespace
+    // to avoid violations of ODF (one-definition-rule) in other
+    // translation units
+    namespace
+    {
+
+        /// Batch decoder using the backward linear block decoder
+        template<class Field>
+        class backward_batch_rlnc_decoder
+            : public // Payload API
+                     payload_decoder<
+                     // Codec Header API
+                     systematic_decoder<
+                     symbol_id_decoder<
+                     // Symbol ID API
+                     plain_symbol_id_reader<
+                     // Decoder API
+                     aligned_coefficients_decoder<
+                     batch_linear_block_decoder<
+                     backward_linear_block_decoder<
+                     symbol_decoding_status_counter<
+                     symbol_decoding_status_tracker<
+                     // Coefficient Storage API
+                     coefficient_value_access<
+                     coefficient_storage<
+                     coefficient_info<
+                     // Storage API
+                     deep_symbol_storage<
+                     storage_bytes_used<
+                     storage_block_info<
+                     // Finite Field API
+                     finite_field_math<typename fifi::default_field<Field>::type,
+                     finite_field_info<Field,
+                     // Factory API
+                     final_coder_factory_pool<
+                     // Final type
+                     backward_batch_rlnc_decoder<Field>
+                         > > > > > > > > > > > > > > > > > >
+        { };
+
+    }
+}
+
+/// Encodes the data in bursts and passes every burst to the batch
+/// decode function of the decoder
+template<class Encoder, class Decoder>
+inline void test_batch_decode(uint32_t symbols, uint32_t symbol_size,
+                              uint32_t batch_size, bool systematic)
+{
+    typename Encoder::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+
+    typename Decoder::factory decoder_factory(symbols, symbol_size);
+    auto decoder = decoder_factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    encoder->set_symbols(sak::storage(data_in));
+
+    if(!systematic)
+        kodo::set_systematic_off(encoder);
+
+    std::vector<std::vector<uint8_t> > payloads(
+        batch_size, std::vector<uint8_t>(encoder->payload_size()));
+
+    std::vector<uint8_t*> pointers(batch_size);
+
+    for(uint32_t i = 0; i < batch_size; ++i)
+    {
+        pointers[i] = &payloads[i][0];
+    }
+
+    while(!decoder->is_complete())
+    {
+        uint32_t rank = decoder->rank();
+
+        for(uint32_t i = 0; i < batch_size; ++i)
+        {
+            encoder->encode(pointers[i]);
+        }
+
+        decoder->decode(&pointers[0], batch_size);
+
+        EXPECT_TRUE(decoder->rank() >= rank);
+        EXPECT_TRUE(decoder->rank() <= rank + batch_size);
+    }
+
+    std::vector<uint8_t> data_out(decoder->block_size(), '\0');
+    decoder->copy_symbols(sak::storage(data_out));
+
+    EXPECT_TRUE(std::equal(data_out.begin(),
+                           data_out.end(),
+                           data_in.begin()));
+}
+
+/// Runs the batch decode test with different fields and batch sizes
+template<template <class> class Encoder, template <class> class Decoder>
+inline void test_batch_decode(uint32_t symbols, uint32_t symbol_size)
+{
+    uint32_t batch_sizes[] = { 1U, 2U, symbols, symbols + 3U };
+
+    for(uint32_t batch_size : batch_sizes)
+    {
+        for(bool systematic : { true, false })
+        {
+            test_batch_decode<Encoder<fifi::binary>,
+                Decoder<fifi::binary> >(
+                    symbols, symbol_size, batch_size, systematic);
+
+            test_batch_decode<Encoder<fifi::binary8>,
+                Decoder<fifi::binary8> >(
+                    symbols, symbol_size, batch_size, systematic);
+
+            test_batch_decode<Encoder<fifi::binary16>,
+                Decoder<fifi::binary16> >(
+                    symbols, symbol_size, batch_size, systematic);
+        }
+    }
+}
+
+/// Tests the basic API functionality this mean basic encoding
+/// and decoding
+TEST(TestBatchLinearBlockDecoder, test_basic_api)
+{
+    test_basic_api<kodo::full_rlnc_encoder,
+        kodo::full_batch_rlnc_decoder>();
+
+    test_basic_api<kodo::full_rlnc_encoder,
+        kodo::backward_batch_rlnc_decoder>();
+}
+
+/// Tests that an encoder producing systematic packets is handled
+/// correctly in the decoder.
+TEST(TestBatchLinearBlockDecoder, test_systematic)
+{
+    test_systematic<kodo::full_rlnc_encoder,
+        kodo::full_batch_rlnc_decoder>();
+}
+
+/// Tests whether mixed un-coded and coded packets are correctly handled
+/// in the decoder.
+TEST(TestBatchLinearBlockDecoder, test_mix_uncoded)
+{
+    test_mix_uncoded<kodo::full_rlnc_encoder,
+        kodo::full_batch_rlnc_decoder>();
+}
+
+/// Tests the recoding
+TEST(TestBatchLinearBlockDecoder, test_recoders_api)
+{
+    test_recoders<kodo::full_rlnc_encoder,
+        kodo::full_batch_rlnc_decoder>();
+}
+
+/// Tests that the decoder can be reused
+TEST(TestBatchLinearBlockDecoder, test_reuse_api)
+{
+    test_reuse<kodo::full_rlnc_encoder,
+        kodo::full_batch_rlnc_decoder>();
+}
+
+/// Tests decoding bursts of payloads with the batch decode function
+TEST(TestBatchLinearBlockDecoder, test_batch_decode)
+{
+    test_batch_decode<kodo::full_rlnc_encoder,
+        kodo::full_batch_rlnc_decoder>(32, 160);
+
+    test_batch_decode<kodo::full_rlnc_encoder,
+        kodo::backward_batch_rlnc_decoder>(32, 160);
+
+    test_batch_decode<kodo::full_rlnc_encoder,
+        kodo::full_batch_rlnc_decoder>(1, 160);
+
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_batch_decode<kodo::full_rlnc_encoder,
+        kodo::full_batch_rlnc_decoder>(symbols, symbol_size);
+}
+
+/// Tests that symbols passed directly to decode_symbols() are decoded
+/// in the same way as when passed one at a time
+TEST(TestBatchLinearBlockDecoder, test_decode_symbols)
+{
+    typedef fifi::binary8 field_type;
+
+    uint32_t symbols = 16;
+    uint32_t symbol_size = 160;
+
+    kodo::full_batch_rlnc_decoder<field_type>::factory
+        factory(symbols, symbol_size);
+
+    auto single = factory.build();
+    auto batch = factory.build();
+
+    uint32_t vector_size = batch->coefficient_vector_size();
+
+    std::vector<std::vector<uint8_t> > data(symbols);
+    std::vector<std::vector<uint8_t> > coefficients(symbols);
+
+    std::vector<uint8_t*> data_pointers(symbols);
+    std::vector<uint8_t*> coefficient_pointers(symbols);
+
+    for(uint32_t i = 0; i < symbols; ++i)
+    {
+        data[i] = random_vector(symbol_size);
+        coefficients[i] = random_vector(vector_size);
+
+        // Keep the coefficients of every other symbol in the lower
+        // half so that some of the symbols are non-innovative
+        if(i % 2)
+            coefficients[i] = coefficients[i-1];
+
+        std::vector<uint8_t> data_copy = data[i];
+        std::vector<uint8_t> coefficients_copy = coefficients[i];
+        single->decode_symbol(&data_copy[0], &coefficients_copy[0]);
+
+        data_pointers[i] = &data[i][0];
+        coefficient_pointers[i] = &coefficients[i][0];
+    }
+
+    batch->decode_symbols(&data_pointers[0], &coefficient_pointers[0],
+                          symbols);
+
+    EXPECT_EQ(single->rank(), batch->rank());
+
+    for(uint32_t i = 0; i < symbols; ++i)
+    {
+        EXPECT_EQ(single->is_symbol_pivot(i), batch->is_symbol_pivot(i));
+
+        if(!batch->is_symbol_pivot(i))
+            continue;
+
+        // The stored matrix is kept in reduced echelon form so the
+        // two decoders must end up with the same symbols
+        EXPECT_TRUE(std::equal(
+            single->symbol(i), single->symbol(i) + symbol_size,
+            batch->symbol(i)));
+
+        EXPECT_TRUE(std::equal(
+            single->coefficient_vector_data(i),
+            single->coefficient_vector_data(i) + vector_size,
+            batch->coefficient_vector_data(i)));
+    }
+}
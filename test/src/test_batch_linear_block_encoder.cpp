@@ -0,0 +1,209 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_batch_linear_block_encoder.cpp Unit tests for the
+///       kodo::batch_linear_block_encoder
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <kodo/batch_linear_block_encoder.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+#include <kodo/rlnc/full_batch_rlnc_encoder.hpp>
+#include <kodo/set_systematic_on.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+#include "kodo_unit_test/helper_test_reuse_api.hpp"
+#include "kodo_unit_test/helper_test_basic_api.hpp"
+#include "kodo_unit_test/helper_test_systematic_api.hpp"
+#include "kodo_unit_test/helper_test_mix_uncoded_api.hpp"
+
+/// Encodes the data in bursts with the batch encode function of the
+/// encoder and passes the payloads to the decoder
+template<class Encoder, class Decoder>
+inline void test_batch_encode(uint32_t symbols, uint32_t symbol_size,
+                              uint32_t batch_size, bool systematic)
+{
+    typename Encoder::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+
+    typename Decoder::factory decoder_factory(symbols, symbol_size);
+    auto decoder = decoder_factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    encoder->set_symbols(sak::storage(data_in));
+
+    if(!systematic)
+        kodo::set_systematic_off(encoder);
+
+    std::vector<std::vector<uint8_t> > payloads(
+        batch_size, std::vector<uint8_t>(encoder->payload_size()));
+
+    std::vector<uint8_t*> pointers(batch_size);
+    std::vector<uint32_t> sizes(batch_size);
+
+    for(uint32_t i = 0; i < batch_size; ++i)
+    {
+        pointers[i] = &payloads[i][0];
+    }
+
+    while(!decoder->is_complete())
+    {
+        encoder->encode(&pointers[0], &sizes[0], batch_size);
+
+        EXPECT_FALSE(encoder->is_batch_active());
+
+        for(uint32_t i = 0; i < batch_size; ++i)
+        {
+            EXPECT_TRUE(sizes[i] > 0);
+            EXPECT_TRUE(sizes[i] <= encoder->payload_size());
+
+            decoder->decode(pointers[i]);
+        }
+    }
+
+    std::vector<uint8_t> data_out(decoder->block_size(), '\0');
+    decoder->copy_symbols(sak::storage(data_out));
+
+    EXPECT_TRUE(std::equal(data_out.begin(),
+                           data_out.end(),
+                           data_in.begin()));
+}
+
+/// Runs the batch encode test with different fields and batch sizes
+template<template <class> class Encoder, template <class> class Decoder>
+inline void test_batch_encode(uint32_t symbols, uint32_t symbol_size)
+{
+    uint32_t batch_sizes[] = { 1U, 2U, symbols, symbols + 3U };
+
+    for(uint32_t batch_size : batch_sizes)
+    {
+        for(bool systematic : { true, false })
+        {
+            test_batch_encode<Encoder<fifi::binary>,
+                Decoder<fifi::binary> >(
+                    symbols, symbol_size, batch_size, systematic);
+
+            test_batch_encode<Encoder<fifi::binary8>,
+                Decoder<fifi::binary8> >(
+                    symbols, symbol_size, batch_size, systematic);
+
+            test_batch_encode<Encoder<fifi::binary16>,
+                Decoder<fifi::binary16> >(
+                    symbols, symbol_size, batch_size, systematic);
+        }
+    }
+}
+
+/// Checks that encode_symbols() produces the same symbols as
+/// encoding the symbols one at a time
+template<class Field>
+inline void test_encode_symbols(uint32_t symbols, uint32_t symbol_size,
+                                uint32_t count)
+{
+    typedef kodo::full_batch_rlnc_encoder<Field> encoder_type;
+
+    typename encoder_type::factory factory(symbols, symbol_size);
+    auto encoder = factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    encoder->set_symbols(sak::storage(data_in));
+
+    uint32_t vector_size = encoder->coefficient_vector_size();
+
+    std::vector<std::vector<uint8_t> > single(count);
+    std::vector<std::vector<uint8_t> > batch(count);
+    std::vector<std::vector<uint8_t> > coefficients(count);
+
+    std::vector<uint8_t*> batch_pointers(count);
+    std::vector<uint8_t*> coefficient_pointers(count);
+
+    for(uint32_t j = 0; j < count; ++j)
+    {
+        coefficients[j] = random_vector(vector_size);
+
+        // Include an all zero coding vector
+        if(j == 0)
+            std::fill(coefficients[j].begin(), coefficients[j].end(), 0);
+
+        single[j] = random_vector(symbol_size);
+        encoder->encode_symbol(&single[j][0], &coefficients[j][0]);
+
+        batch[j].resize(symbol_size, 0);
+        batch_pointers[j] = &batch[j][0];
+        coefficient_pointers[j] = &coefficients[j][0];
+    }
+
+    encoder->encode_symbols(&batch_pointers[0], &coefficient_pointers[0],
+                            count);
+
+    for(uint32_t j = 0; j < count; ++j)
+    {
+        EXPECT_TRUE(single[j] == batch[j]);
+    }
+}
+
+/// Tests the basic API functionality this mean basic encoding
+/// and decoding
+TEST(TestBatchLinearBlockEncoder, test_basic_api)
+{
+    test_basic_api<kodo::full_batch_rlnc_encoder,
+        kodo::full_rlnc_decoder>();
+}
+
+/// Tests that the systematic symbols produced by the encoder are
+/// handled correctly
+TEST(TestBatchLinearBlockEncoder, test_systematic)
+{
+    test_systematic<kodo::full_batch_rlnc_encoder,
+        kodo::full_rlnc_decoder>();
+}
+
+/// Tests whether mixed un-coded and coded packets are correctly handled
+TEST(TestBatchLinearBlockEncoder, test_mix_uncoded)
+{
+    test_mix_uncoded<kodo::full_batch_rlnc_encoder,
+        kodo::full_rlnc_decoder>();
+}
+
+/// Tests that the encoder can be reused
+TEST(TestBatchLinearBlockEncoder, test_reuse_api)
+{
+    test_reuse<kodo::full_batch_rlnc_encoder,
+        kodo::full_rlnc_decoder>();
+}
+
+/// Tests encoding bursts of payloads with the batch encode function
+TEST(TestBatchLinearBlockEncoder, test_batch_encode)
+{
+    test_batch_encode<kodo::full_batch_rlnc_encoder,
+        kodo::full_rlnc_decoder>(32, 160);
+
+    test_batch_encode<kodo::full_batch_rlnc_encoder,
+        kodo::full_rlnc_decoder>(1, 160);
+
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_batch_encode<kodo::full_batch_rlnc_encoder,
+        kodo::full_rlnc_decoder>(symbols, symbol_size);
+}
+
+/// Tests that symbols passed directly to encode_symbols() are encoded
+/// in the same way as when passed one at a time, also when the
+/// symbols are split into several tiles
+TEST(TestBatchLinearBlockEncoder, test_encode_symbols)
+{
+    test_encode_symbols<fifi::binary>(16, 160, 10);
+    test_encode_symbols<fifi::binary8>(16, 160, 10);
+    test_encode_symbols<fifi::binary16>(16, 160, 10);
+
+    // With this many symbols the tiles are smaller than the symbols
+    test_encode_symbols<fifi::binary>(1100, 1000, 5);
+    test_encode_symbols<fifi::binary8>(1100, 1000, 5);
+    test_encode_symbols<fifi::binary16>(1100, 1002, 5);
+}
@@ -0,0 +1,265 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_cache_aware_partitioning_scheme.cpp Unit tests for the
+///       kodo::cache_aware_partitioning_scheme
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <fifi/binary.hpp>
+#include <fifi/binary8.hpp>
+#include <fifi/binary16.hpp>
+
+#include <kodo/cache_aware_partitioning_scheme.hpp>
+#include <kodo/last_level_cache_size.hpp>
+#include <kodo/object_encoder.hpp>
+#include <kodo/object_decoder.hpp>
+#include <kodo/storage_reader.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+/// Checks that the blocks fit the cache, respect the overhead and
+/// cover the object
+template<class Field>
+inline void test_partitioning(uint32_t max_symbols,
+                              uint32_t max_symbol_size,
+                              uint64_t object_size,
+                              uint32_t cache_size,
+                              double max_overhead)
+{
+    typedef kodo::cache_aware_partitioning_scheme<Field> partitioning_type;
+
+    partitioning_type partitioning(max_symbols, max_symbol_size,
+                                   object_size, cache_size, max_overhead);
+
+    uint64_t offset = 0;
+
+    for(uint32_t i = 0; i < partitioning.blocks(); ++i)
+    {
+        uint32_t symbols = partitioning.symbols(i);
+        uint32_t symbol_size = partitioning.symbol_size(i);
+
+        EXPECT_TRUE(symbols > 0);
+        EXPECT_TRUE(symbols <= max_symbols);
+        EXPECT_TRUE(symbol_size <= max_symbol_size);
+
+        EXPECT_TRUE(partitioning_type::working_set(symbols, symbol_size)
+                    <= cache_size);
+
+        EXPECT_TRUE(fifi::elements_to_size<Field>(symbols) <=
+                    max_overhead * symbol_size);
+
+        // The symbols are kept a multiple of the vector alignment
+        if(symbol_size != max_symbol_size &&
+           symbol_size > kodo::coder_arena::vector_alignment)
+        {
+            EXPECT_EQ(0U, symbol_size % kodo::coder_arena::vector_alignment);
+        }
+
+        EXPECT_EQ(offset, partitioning.byte_offset(i));
+        offset += partitioning.bytes_used(i);
+    }
+
+    EXPECT_EQ(object_size, offset);
+}
+
+TEST(TestCacheAwarePartitioningScheme, fits_cache)
+{
+    test_partitioning<fifi::binary>(1024, 4096, 10000000, 256*1024, 0.05);
+    test_partitioning<fifi::binary8>(255, 1500, 10000000, 256*1024, 0.05);
+    test_partitioning<fifi::binary8>(255, 1500, 10000000, 64*1024, 0.05);
+    test_partitioning<fifi::binary16>(1000, 9000, 123456789, 2*1024*1024,
+                                      0.02);
+}
+
+TEST(TestCacheAwarePartitioningScheme, uses_maximum_when_cache_is_large)
+{
+    // Nothing has to be reduced when the maxima already fit the cache
+    kodo::cache_aware_partitioning_scheme<fifi::binary8> partitioning(
+        16, 1600, 100000, 1024*1024, 0.05);
+
+    EXPECT_EQ(16U, partitioning.symbols(0));
+    EXPECT_EQ(1600U, partitioning.symbol_size(0));
+}
+
+TEST(TestCacheAwarePartitioningScheme, prefers_symbols)
+{
+    // The cache only holds 64 KiB, the symbol size is reduced before
+    // the number of symbols as long as the overhead allows it
+    uint32_t cache_size = 64*1024;
+
+    kodo::cache_aware_partitioning_scheme<fifi::binary8> partitioning(
+        64, 1500, 1000000, cache_size, 0.1);
+
+    // 64 symbols leave (64 KiB - 64 * 64) / 64 = 960 bytes per symbol
+    EXPECT_EQ(960U, partitioning.symbol_size(0));
+
+    // The symbols are balanced over the blocks as in RFC5052
+    EXPECT_TRUE(partitioning.symbols(0) <= 64U);
+    EXPECT_TRUE(partitioning.symbols(0) > 32U);
+}
+
+TEST(TestCacheAwarePartitioningScheme, detected_cache_size)
+{
+    EXPECT_TRUE(kodo::last_level_cache_size() > 0);
+
+    typedef kodo::cache_aware_partitioning_scheme<fifi::binary8>
+        partitioning_type;
+
+    partitioning_type partitioning(255, 1500, 1000000,
+        kodo::last_level_cache_size(),
+        partitioning_type::default_max_overhead());
+
+    EXPECT_TRUE(partitioning_type::working_set(
+                    partitioning.symbols(0), partitioning.symbol_size(0))
+                <= kodo::last_level_cache_size());
+}
+
+TEST(TestCacheAwarePartitioningScheme, default_does_not_detect)
+{
+    typedef kodo::cache_aware_partitioning_scheme<fifi::binary8>
+        partitioning_type;
+
+    // The layout without a cache size must not depend on the machine
+    partitioning_type implicit(255, 1500, 1000000);
+
+    partitioning_type explicit_default(255, 1500, 1000000,
+        partitioning_type::default_cache_size(),
+        partitioning_type::default_max_overhead());
+
+    EXPECT_EQ(explicit_default.blocks(), implicit.blocks());
+    EXPECT_EQ(explicit_default.symbols(0), implicit.symbols(0));
+    EXPECT_EQ(explicit_default.symbol_size(0), implicit.symbol_size(0));
+}
+
+TEST(TestCacheAwarePartitioningScheme, object_coders)
+{
+    typedef fifi::binary8 field_type;
+    typedef kodo::full_rlnc_encoder<field_type> encoder_type;
+    typedef kodo::full_rlnc_decoder<field_type> decoder_type;
+    typedef kodo::cache_aware_partitioning_scheme<field_type>
+        partitioning_type;
+
+    typedef kodo::storage_reader<encoder_type> reader_type;
+
+    typedef kodo::object_encoder<reader_type, encoder_type,
+        partitioning_type> object_encoder_type;
+
+    typedef kodo::object_decoder<decoder_type, partitioning_type>
+        object_decoder_type;
+
+    uint32_t object_size = 100000;
+    std::vector<uint8_t> data_in = random_vector(object_size);
+    std::vector<uint8_t> data_out(object_size);
+
+    encoder_type::factory encoder_factory(128, 1400);
+    decoder_type::factory decoder_factory(128, 1400);
+
+    object_encoder_type object_encoder(
+        encoder_factory, reader_type(sak::storage(data_in)));
+
+    object_decoder_type object_decoder(decoder_factory, object_size);
+
+    EXPECT_EQ(object_encoder.encoders(), object_decoder.decoders());
+
+    partitioning_type partitioning(128, 1400, object_size);
+
+    for(uint32_t i = 0; i < object_encoder.encoders(); ++i)
+    {
+        auto encoder = object_encoder.build(i);
+        auto decoder = object_decoder.build(i);
+
+        EXPECT_EQ(partitioning.symbols(i), encoder->symbols());
+        EXPECT_EQ(partitioning.symbol_size(i), encoder->symbol_size());
+
+        std::vector<uint8_t> payload(encoder->payload_size());
+
+        while(!decoder->is_complete())
+        {
+            encoder->encode(&payload[0]);
+            decoder->decode(&payload[0]);
+        }
+
+        decoder->copy_symbols(sak::storage(
+            &data_out[0] + partitioning.byte_offset(i),
+            partitioning.bytes_used(i)));
+    }
+
+    EXPECT_EQ(data_in, data_out);
+}
+
+TEST(TestCacheAwarePartitioningScheme, different_cache_sizes)
+{
+    typedef fifi::binary8 field_type;
+    typedef kodo::full_rlnc_encoder<field_type> encoder_type;
+    typedef kodo::full_rlnc_decoder<field_type> decoder_type;
+    typedef kodo::cache_aware_partitioning_scheme<field_type>
+        partitioning_type;
+
+    typedef kodo::storage_reader<encoder_type> reader_type;
+
+    typedef kodo::object_encoder<reader_type, encoder_type,
+        partitioning_type> object_encoder_type;
+
+    typedef kodo::object_decoder<decoder_type, partitioning_type>
+        object_decoder_type;
+
+    uint32_t object_size = 200000;
+    std::vector<uint8_t> data_in = random_vector(object_size);
+    std::vector<uint8_t> data_out(object_size);
+
+    // The sender and the receiver have different caches, each would
+    // choose another layout for its own cache
+    uint32_t sender_cache = 64*1024;
+    uint32_t receiver_cache = 512*1024;
+
+    partitioning_type sender(128, 1400, object_size, sender_cache, 0.05);
+    partitioning_type receiver(128, 1400, object_size, receiver_cache,
+                               0.05);
+
+    EXPECT_NE(sender.symbol_size(0) * sender.symbols(0),
+              receiver.symbol_size(0) * receiver.symbols(0));
+
+    // The receiver therefore uses the cache size of the sender
+    partitioning_type agreed(128, 1400, object_size, sender_cache, 0.05);
+
+    encoder_type::factory encoder_factory(128, 1400);
+    decoder_type::factory decoder_factory(128, 1400);
+
+    object_encoder_type object_encoder(
+        encoder_factory, reader_type(sak::storage(data_in)), sender);
+
+    object_decoder_type object_decoder(decoder_factory, agreed);
+
+    EXPECT_EQ(object_encoder.encoders(), object_decoder.decoders());
+    EXPECT_EQ(uint64_t(object_size), object_decoder.object_size());
+
+    for(uint32_t i = 0; i < object_encoder.encoders(); ++i)
+    {
+        auto encoder = object_encoder.build(i);
+        auto decoder = object_decoder.build(i);
+
+        EXPECT_EQ(sender.symbols(i), encoder->symbols());
+        EXPECT_EQ(sender.symbols(i), decoder->symbols());
+        EXPECT_EQ(sender.symbol_size(i), decoder->symbol_size());
+
+        std::vector<uint8_t> payload(encoder->payload_size());
+
+        while(!decoder->is_complete())
+        {
+            encoder->encode(&payload[0]);
+            decoder->decode(&payload[0]);
+        }
+
+        decoder->copy_symbols(sak::storage(
+            &data_out[0] + sender.byte_offset(i), sender.bytes_used(i)));
+    }
+
+    EXPECT_EQ(data_in, data_out);
+}
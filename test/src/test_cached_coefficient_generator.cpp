@@ -0,0 +1,223 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_cached_coefficient_generator.cpp Unit tests for the
+///       kodo::cached_coefficient_generator
+
+#include <cstdint>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <kodo/cached_coefficient_generator.hpp>
+#include <kodo/rlnc/seed_codes.hpp>
+#include <kodo/set_systematic_off.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+/// Checks that the vectors generated with the cache are identical to
+/// those generated without it, also when several vectors are generated
+/// from one seed
+template<template <class> class Decoder>
+inline void test_cached_generate(uint32_t symbols, uint32_t symbol_size)
+{
+    typedef Decoder<fifi::binary8> decoder_type;
+
+    typename decoder_type::factory plain_factory(symbols, symbol_size);
+    auto plain = plain_factory.build();
+
+    typename decoder_type::factory cached_factory(symbols, symbol_size);
+    cached_factory.set_coefficient_cache_size(16);
+    EXPECT_EQ(16U, cached_factory.coefficient_cache_size());
+
+    auto cached = cached_factory.build();
+
+    uint32_t size = plain->coefficient_vector_size();
+
+    std::vector<uint8_t> expected(size);
+    std::vector<uint8_t> actual(size);
+
+    // The second round is served from the cache
+    for(uint32_t round = 0; round < 2; ++round)
+    {
+        for(uint32_t seed = 0; seed < 8; ++seed)
+        {
+            plain->seed(seed);
+            cached->seed(seed);
+
+            for(uint32_t n = 0; n < 3; ++n)
+            {
+                plain->generate(&expected[0]);
+                cached->generate(&actual[0]);
+
+                EXPECT_TRUE(expected == actual);
+            }
+        }
+    }
+
+    EXPECT_EQ(8U, cached_factory.coefficient_cache()->size());
+
+    // Coders built later share the cache
+    auto other = cached_factory.build();
+    other->seed(3);
+    other->generate(&actual[0]);
+
+    plain->seed(3);
+    plain->generate(&expected[0]);
+
+    EXPECT_TRUE(expected == actual);
+    EXPECT_EQ(8U, cached_factory.coefficient_cache()->size());
+}
+
+/// Decodes the same flow with several decoders sharing the cache
+template<template <class> class Encoder, template <class> class Decoder>
+inline void test_cached_decode(uint32_t symbols, uint32_t symbol_size)
+{
+    typedef Encoder<fifi::binary8> encoder_type;
+    typedef Decoder<fifi::binary8> decoder_type;
+
+    typename encoder_type::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+
+    typename decoder_type::factory decoder_factory(symbols, symbol_size);
+    decoder_factory.set_coefficient_cache_size(4 * symbols);
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    encoder->set_symbols(sak::storage(data_in));
+    kodo::set_systematic_off(encoder);
+
+    std::vector<std::vector<uint8_t> > payloads;
+
+    std::vector<uint8_t> payload(encoder->payload_size());
+
+    for(uint32_t i = 0; i < 2 * symbols; ++i)
+    {
+        encoder->encode(&payload[0]);
+        payloads.push_back(payload);
+    }
+
+    for(uint32_t n = 0; n < 3; ++n)
+    {
+        auto decoder = decoder_factory.build();
+
+        for(auto& p : payloads)
+        {
+            if(decoder->is_complete())
+                break;
+
+            payload = p;
+            decoder->decode(&payload[0]);
+        }
+
+        ASSERT_TRUE(decoder->is_complete());
+
+        std::vector<uint8_t> data_out(decoder->block_size(), '\0');
+        decoder->copy_symbols(sak::storage(data_out));
+
+        EXPECT_TRUE(data_in == data_out);
+    }
+
+    EXPECT_TRUE(decoder_factory.coefficient_cache()->size() > 0);
+    EXPECT_TRUE(decoder_factory.coefficient_cache()->size() <= 2 * symbols);
+}
+
+/// Tests that the cached vectors are identical to the generated ones
+TEST(TestCachedCoefficientGenerator, test_generate)
+{
+    test_cached_generate<kodo::seed_rlnc_decoder>(16, 100);
+    test_cached_generate<kodo::fast_seed_rlnc_decoder>(16, 100);
+}
+
+/// Tests decoding a flow with several decoders sharing a cache
+TEST(TestCachedCoefficientGenerator, test_decode)
+{
+    test_cached_decode<kodo::seed_rlnc_encoder,
+        kodo::seed_rlnc_decoder>(16, 100);
+
+    test_cached_decode<kodo::fast_seed_rlnc_encoder,
+        kodo::fast_seed_rlnc_decoder>(32, 100);
+}
+
+/// Tests that the number of stored vectors is bounded
+TEST(TestCachedCoefficientGenerator, test_capacity)
+{
+    kodo::coefficient_vector_cache cache(4);
+
+    std::vector<uint8_t> vector = random_vector(10);
+    std::vector<uint8_t> copy(10);
+
+    for(uint32_t seed = 0; seed < 10; ++seed)
+    {
+        cache.insert(10, seed, &vector[0], 10);
+        EXPECT_TRUE(cache.size() <= 4U);
+    }
+
+    EXPECT_EQ(4U, cache.size());
+
+    // The oldest vectors are evicted first
+    EXPECT_FALSE(cache.find(10, 5, &copy[0], 10));
+    EXPECT_TRUE(cache.find(10, 6, &copy[0], 10));
+    EXPECT_TRUE(vector == copy);
+
+    // The number of symbols is part of the key
+    EXPECT_FALSE(cache.find(11, 6, &copy[0], 10));
+
+    kodo::coefficient_vector_cache disabled(0);
+    disabled.insert(10, 0, &vector[0], 10);
+    EXPECT_EQ(0U, disabled.size());
+}
+
+/// Tests that coders in different threads can share a cache
+TEST(TestCachedCoefficientGenerator, test_concurrent)
+{
+    kodo::coefficient_vector_cache cache(64);
+
+    const uint32_t size = 40;
+    const uint32_t seeds = 256;
+
+    // The content of a vector is derived from its seed, so any vector
+    // found can be checked
+    auto fill = [](uint64_t seed, uint8_t *vector)
+        {
+            for(uint32_t i = 0; i < size; ++i)
+                vector[i] = static_cast<uint8_t>(seed * 31 + i);
+        };
+
+    std::vector<std::thread> threads;
+    std::vector<uint32_t> errors(4, 0);
+
+    for(uint32_t t = 0; t < errors.size(); ++t)
+    {
+        threads.push_back(std::thread([&, t]
+            {
+                std::vector<uint8_t> vector(size);
+                std::vector<uint8_t> expected(size);
+
+                for(uint32_t n = 0; n < 20000; ++n)
+                {
+                    uint64_t seed = (n * 7 + t) % seeds;
+                    fill(seed, &expected[0]);
+
+                    if(cache.find(10, seed, &vector[0], size))
+                    {
+                        if(vector != expected)
+                            ++errors[t];
+                    }
+                    else
+                    {
+                        cache.insert(10, seed, &expected[0], size);
+                    }
+                }
+            }));
+    }
+
+    for(auto& thread : threads)
+        thread.join();
+
+    for(auto e : errors)
+        EXPECT_EQ(0U, e);
+
+    EXPECT_TRUE(cache.size() <= cache.capacity());
+}
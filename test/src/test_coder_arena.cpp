@@ -0,0 +1,170 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_coder_arena.cpp Unit tests for the kodo::coder_arena and
+///       the layout of the coder buffers in it
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <kodo/coder_arena.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+namespace
+{
+    /// Requests a few buffers with different alignments
+    struct dummy_layout
+    {
+        dummy_layout()
+            : m_bytes(0),
+              m_values(0),
+              m_vector(0)
+        { }
+
+        void operator()(kodo::coder_arena &arena)
+        {
+            m_bytes = arena.allocate<uint8_t>(3);
+            m_values = arena.allocate<uint32_t>(5);
+            m_vector = arena.allocate<uint8_t>(
+                100, kodo::coder_arena::vector_alignment);
+        }
+
+        uint8_t *m_bytes;
+        uint32_t *m_values;
+        uint8_t *m_vector;
+    };
+}
+
+TEST(TestCoderArena, measure)
+{
+    kodo::coder_arena arena;
+    dummy_layout layout;
+
+    layout(arena);
+
+    EXPECT_TRUE(arena.is_measuring());
+    EXPECT_TRUE(layout.m_bytes == 0);
+    EXPECT_TRUE(layout.m_vector == 0);
+
+    // 3 bytes, padding to 4, 5 * 4 bytes, padding to 32 and 100 bytes
+    EXPECT_EQ(132U, arena.size());
+}
+
+TEST(TestCoderArena, align_size)
+{
+    EXPECT_EQ(0U, kodo::coder_arena::align_size(0));
+    EXPECT_EQ(32U, kodo::coder_arena::align_size(1));
+    EXPECT_EQ(32U, kodo::coder_arena::align_size(32));
+    EXPECT_EQ(64U, kodo::coder_arena::align_size(33));
+    EXPECT_EQ(8U, kodo::coder_arena::align_size(5, 4));
+}
+
+TEST(TestCoderArena, storage)
+{
+    kodo::coder_arena_storage storage;
+    dummy_layout layout;
+
+    EXPECT_EQ(0U, storage.memory_footprint());
+
+    storage.allocate([&](kodo::coder_arena &arena) { layout(arena); });
+
+    EXPECT_EQ(132U + kodo::coder_arena::max_alignment,
+              storage.memory_footprint());
+
+    ASSERT_TRUE(layout.m_bytes != 0);
+
+    // The buffers follow each other in the same block
+    EXPECT_EQ(layout.m_bytes + 4,
+              reinterpret_cast<uint8_t*>(layout.m_values));
+    EXPECT_EQ(layout.m_bytes + 32, layout.m_vector);
+
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(layout.m_vector) %
+              kodo::coder_arena::vector_alignment);
+
+    // The memory is zero initialized
+    for(uint32_t i = 0; i < 100; ++i)
+        EXPECT_EQ(0U, layout.m_vector[i]);
+}
+
+/// Checks that the buffers of a coder are laid out in its arena
+template<class Field>
+inline void test_coder_footprint(uint32_t max_symbols,
+                                 uint32_t max_symbol_size)
+{
+    typedef kodo::full_rlnc_encoder<Field> encoder_type;
+    typedef kodo::full_rlnc_decoder<Field> decoder_type;
+
+    typename encoder_type::factory encoder_factory(
+        max_symbols, max_symbol_size);
+
+    typename decoder_type::factory decoder_factory(
+        max_symbols, max_symbol_size);
+
+    auto encoder = encoder_factory.build();
+    auto decoder = decoder_factory.build();
+
+    uint64_t block_size = uint64_t(max_symbols) * max_symbol_size;
+
+    // The symbol storage is the largest buffer of both coders
+    EXPECT_TRUE(encoder->memory_footprint() >
+                sizeof(encoder_type) + block_size);
+
+    EXPECT_TRUE(decoder->memory_footprint() >
+                sizeof(decoder_type) + block_size);
+
+    // The decoder also stores the coefficients and holds the recoding
+    // stack, which needs no room for the symbols
+    uint64_t coefficients_size = uint64_t(max_symbols) *
+        decoder_factory.max_coefficient_vector_size();
+
+    EXPECT_TRUE(decoder->memory_footprint() >
+                sizeof(decoder_type) + block_size + coefficients_size);
+
+    EXPECT_TRUE(decoder->memory_footprint() <
+                2 * (sizeof(decoder_type) + block_size +
+                     coefficients_size) + 4096);
+
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(encoder->symbol(0)) %
+              kodo::coder_arena::vector_alignment);
+
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(decoder->symbol(0)) %
+              kodo::coder_arena::vector_alignment);
+
+    // The footprint does not change when the coder is recycled
+    uint64_t footprint = encoder->memory_footprint();
+
+    encoder.reset();
+    encoder = encoder_factory.build();
+
+    EXPECT_EQ(footprint, encoder->memory_footprint());
+
+    // The coders still work on the laid out buffers
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    encoder->set_symbols(sak::storage(data_in));
+
+    std::vector<uint8_t> payload(encoder->payload_size());
+
+    while(!decoder->is_complete())
+    {
+        encoder->encode(&payload[0]);
+        decoder->decode(&payload[0]);
+    }
+
+    std::vector<uint8_t> data_out(decoder->block_size());
+    decoder->copy_symbols(sak::storage(data_out));
+
+    EXPECT_EQ(data_in, data_out);
+}
+
+TEST(TestCoderArena, coder_footprint)
+{
+    test_coder_footprint<fifi::binary>(32, 1600);
+    test_coder_footprint<fifi::binary8>(64, 1400);
+    test_coder_footprint<fifi::binary16>(16, 100);
+}
@@ -137,6 +137,29 @@ namespace
 
             EXPECT_EQ(length, coder->coefficient_vector_length());
 
+            // The vectors should be stored aligned in a single buffer
+            // with a fixed distance between them
+            uint32_t alignment = Coder::vector_alignment;
+
+            for(uint32_t i = 0; i < symbols; ++i)
+            {
+                uintptr_t address = reinterpret_cast<uintptr_t>(
+                    coder->coefficient_vector_data(i));
+
+                EXPECT_EQ(0U, address % alignment);
+
+                if(i == 0)
+                    continue;
+
+                uint32_t stride = static_cast<uint32_t>(
+                    coder->coefficient_vector_data(i) -
+                    coder->coefficient_vector_data(i - 1));
+
+                EXPECT_EQ(0U, stride % alignment);
+                EXPECT_GE(stride, max_coefficients_size);
+                EXPECT_LT(stride, max_coefficients_size + alignment);
+            }
+
             // Create a zero vector for comparisons
             std::vector<uint8_t> zero_vector(size, '\0');
             auto zero_storage = sak::storage(zero_vector);
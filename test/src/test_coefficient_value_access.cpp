@@ -11,9 +11,12 @@
 #include <gtest/gtest.h>
 #include <fifi/binary.hpp>
 #include <fifi/binary8.hpp>
+#include <fifi/binary16.hpp>
 #include <kodo/coefficient_value_access.hpp>
 #include <kodo/storage_block_info.hpp>
 
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
 namespace kodo
 {
 
@@ -98,3 +101,83 @@ TEST(TestCoefficientValueAccess, api)
 }
 
 
+
+namespace
+{
+    /// Checks the non-zero coefficient searches against a search
+    /// inspecting one element at a time
+    template<class FieldType>
+    void test_nonzero_search(uint32_t symbols, uint32_t nonzeros)
+    {
+        typedef FieldType field_type;
+        typedef typename field_type::value_type value_type;
+        typedef kodo::test_stack<field_type> stack_type;
+
+        stack_type stack;
+
+        std::vector<value_type> coefficients(
+            fifi::elements_to_length<field_type>(symbols));
+
+        const value_type* data = &coefficients[0];
+
+        // Without any non-zero coefficients nothing should be found
+        EXPECT_FALSE(stack.first_nonzero_coefficient(data, 0, symbols - 1));
+        EXPECT_FALSE(stack.last_nonzero_coefficient(data, 0, symbols - 1));
+
+        for(uint32_t i = 0; i < nonzeros; ++i)
+        {
+            stack.set_coefficient_value(
+                &coefficients[0], rand() % symbols, 1U);
+        }
+
+        for(uint32_t first = 0; first < symbols; first += 1 + rand() % 7)
+        {
+            for(uint32_t last = first; last < symbols; last += 1 + rand() % 7)
+            {
+                // The symbols value is used when nothing should be found
+                uint32_t expected_first = symbols;
+                uint32_t expected_last = symbols;
+
+                for(uint32_t i = first; i <= last; ++i)
+                {
+                    if(!stack.coefficient_value(data, i))
+                        continue;
+
+                    if(expected_first == symbols)
+                        expected_first = i;
+
+                    expected_last = i;
+                }
+
+                auto found_first =
+                    stack.first_nonzero_coefficient(data, first, last);
+
+                auto found_last =
+                    stack.last_nonzero_coefficient(data, first, last);
+
+                EXPECT_EQ(expected_first, found_first ? *found_first : symbols);
+                EXPECT_EQ(expected_last, found_last ? *found_last : symbols);
+            }
+        }
+    }
+}
+
+TEST(TestCoefficientValueAccess, nonzero_search)
+{
+    uint32_t symbols = rand_symbols(300);
+
+    test_nonzero_search<fifi::binary>(symbols, 0);
+    test_nonzero_search<fifi::binary>(symbols, 1);
+    test_nonzero_search<fifi::binary>(symbols, 5);
+    test_nonzero_search<fifi::binary>(symbols, symbols);
+
+    test_nonzero_search<fifi::binary8>(symbols, 0);
+    test_nonzero_search<fifi::binary8>(symbols, 1);
+    test_nonzero_search<fifi::binary8>(symbols, 5);
+    test_nonzero_search<fifi::binary8>(symbols, symbols);
+
+    test_nonzero_search<fifi::binary16>(symbols, 0);
+    test_nonzero_search<fifi::binary16>(symbols, 1);
+    test_nonzero_search<fifi::binary16>(symbols, 5);
+    test_nonzero_search<fifi::binary16>(symbols, symbols);
+}
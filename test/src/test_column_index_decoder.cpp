@@ -0,0 +1,210 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_column_index_decoder.cpp Unit tests for the
+///       kodo::column_index_decoder
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <kodo/column_index_decoder.hpp>
+#include <kodo/backward_linear_block_decoder.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+#include <kodo/rlnc/shallow_sparse_full_rlnc_encoder.hpp>
+#include <kodo/set_systematic_on.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+#include "kodo_unit_test/helper_test_reuse_api.hpp"
+#include "kodo_unit_test/helper_test_recoding_api.hpp"
+#include "kodo_unit_test/helper_test_basic_api.hpp"
+#include "kodo_unit_test/helper_test_systematic_api.hpp"
+#include "kodo_unit_test/helper_test_mix_uncoded_api.hpp"
+
+namespace kodo
+{
+
+    // Put dummy layers and tests classes in an anonymous namespace
+    // to avoid violations of ODF (one-definition-rule) in other
+    // translation units
+    namespace
+    {
+
+        template<class Field>
+        class column_index_rlnc_decoder
+            : public // Payload API
+                     payload_recoder<recoding_stack,
+                     payload_decoder<
+                     // Codec Header API
+                     systematic_decoder<
+                     symbol_id_decoder<
+                     // Symbol ID API
+                     plain_symbol_id_reader<
+                     // Decoder API
+                     aligned_coefficients_decoder<
+                     column_index_decoder<
+                     forward_linear_block_decoder<
+                     symbol_decoding_status_counter<
+                     symbol_decoding_status_tracker<
+                     // Coefficient Storage API
+                     coefficient_value_access<
+                     coefficient_storage<
+                     coefficient_info<
+                     // Storage API
+                     deep_symbol_storage<
+                     storage_bytes_used<
+                     storage_block_info<
+                     // Finite Field API
+                     finite_field_math<typename fifi::default_field<Field>::type,
+                     finite_field_info<Field,
+                     // Factory API
+                     final_coder_factory_pool<
+                     // Final type
+                     column_index_rlnc_decoder<Field>
+                         > > > > > > > > > > > > > > > > > > >
+        { };
+
+        template<class Field>
+        class backward_column_index_rlnc_decoder
+            : public // Payload API
+                     payload_decoder<
+                     // Codec Header API
+                     systematic_decoder<
+                     symbol_id_decoder<
+                     // Symbol ID API
+                     plain_symbol_id_reader<
+                     // Decoder API
+                     aligned_coefficients_decoder<
+                     column_index_decoder<
+                     backward_linear_block_decoder<
+                     symbol_decoding_status_counter<
+                     symbol_decoding_status_tracker<
+                     // Coefficient Storage API
+                     coefficient_value_access<
+                     coefficient_storage<
+                     coefficient_info<
+                     // Storage API
+                     deep_symbol_storage<
+                     storage_bytes_used<
+                     storage_block_info<
+                     // Finite Field API
+                     finite_field_math<typename fifi::default_field<Field>::type,
+                     finite_field_info<Field,
+                     // Factory API
+                     final_coder_factory_pool<
+                     // Final type
+                     backward_column_index_rlnc_decoder<Field>
+                         > > > > > > > > > > > > > > > > > >
+        { };
+
+    }
+}
+
+/// Checks that every non-zero coefficient of the stored coded symbols
+/// is present in the column index while decoding a sparse code
+template<class Field>
+inline void test_column_index(uint32_t symbols, uint32_t symbol_size)
+{
+    typedef kodo::shallow_sparse_full_rlnc_encoder<Field> encoder_type;
+    typedef kodo::column_index_rlnc_decoder<Field> decoder_type;
+
+    typename encoder_type::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+
+    typename decoder_type::factory decoder_factory(symbols, symbol_size);
+    auto decoder = decoder_factory.build();
+
+    std::vector<uint8_t> payload(encoder->payload_size());
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+
+    encoder->set_symbols(sak::storage(data_in));
+    encoder->set_density(0.2);
+    kodo::set_systematic_off(encoder);
+
+    while(!decoder->is_complete())
+    {
+        encoder->encode(&payload[0]);
+        decoder->decode(&payload[0]);
+
+        if(decoder->is_complete())
+            break;
+
+        for(uint32_t i = 0; i < symbols; ++i)
+        {
+            if(!decoder->is_symbol_seen(i))
+                continue;
+
+            auto vector_i = decoder->coefficient_vector_values(i);
+
+            for(uint32_t j = 0; j < symbols; ++j)
+            {
+                if(!decoder->coefficient_value(vector_i, j))
+                    continue;
+
+                EXPECT_TRUE(decoder->column_index(j).test(i));
+            }
+        }
+    }
+
+    std::vector<uint8_t> data_out(decoder->block_size(), '\0');
+    decoder->copy_symbols(sak::storage(data_out));
+
+    EXPECT_TRUE(std::equal(data_out.begin(),
+                           data_out.end(),
+                           data_in.begin()));
+}
+
+/// Tests the basic API functionality this mean basic encoding
+/// and decoding
+TEST(TestColumnIndexDecoder, test_basic_api)
+{
+    test_basic_api<kodo::full_rlnc_encoder,
+        kodo::column_index_rlnc_decoder>();
+
+    test_basic_api<kodo::full_rlnc_encoder,
+        kodo::backward_column_index_rlnc_decoder>();
+}
+
+/// Tests that an encoder producing systematic packets is handled
+/// correctly in the decoder.
+TEST(TestColumnIndexDecoder, test_systematic)
+{
+    test_systematic<kodo::full_rlnc_encoder,
+        kodo::column_index_rlnc_decoder>();
+}
+
+/// Tests whether mixed un-coded and coded packets are correctly handled
+/// in the decoder.
+TEST(TestColumnIndexDecoder, test_mix_uncoded)
+{
+    test_mix_uncoded<kodo::full_rlnc_encoder,
+        kodo::column_index_rlnc_decoder>();
+}
+
+/// Tests the recoding
+TEST(TestColumnIndexDecoder, test_recoders_api)
+{
+    test_recoders<kodo::full_rlnc_encoder,
+        kodo::column_index_rlnc_decoder>();
+}
+
+/// Tests that the decoder can be reused
+TEST(TestColumnIndexDecoder, test_reuse_api)
+{
+    test_reuse<kodo::full_rlnc_encoder,
+        kodo::column_index_rlnc_decoder>();
+
+    test_reuse_incomplete<kodo::full_rlnc_encoder,
+        kodo::column_index_rlnc_decoder>();
+}
+
+/// Tests that the column index covers all non-zero coefficients
+TEST(TestColumnIndexDecoder, test_column_index)
+{
+    test_column_index<fifi::binary>(64, 32);
+    test_column_index<fifi::binary8>(64, 32);
+    test_column_index<fifi::binary16>(64, 32);
+}
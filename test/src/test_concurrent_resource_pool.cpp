@@ -0,0 +1,192 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_concurrent_resource_pool.cpp Unit tests for the
+///       kodo::concurrent_resource_pool
+
+#include <cstdint>
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <boost/make_shared.hpp>
+
+#include <kodo/concurrent_resource_pool.hpp>
+
+namespace
+{
+    /// Resource counting how often it is in use at the same time
+    struct dummy_resource
+    {
+        dummy_resource()
+            : m_users(0)
+        { }
+
+        std::atomic<uint32_t> m_users;
+    };
+
+    boost::shared_ptr<dummy_resource> make_resource()
+    {
+        return boost::make_shared<dummy_resource>();
+    }
+}
+
+TEST(TestConcurrentResourcePool, recycle)
+{
+    kodo::concurrent_resource_pool<dummy_resource> pool(make_resource);
+
+    EXPECT_EQ(0U, pool.total_resources());
+
+    dummy_resource *first = 0;
+
+    {
+        auto a = pool.allocate();
+        auto b = pool.allocate();
+
+        EXPECT_NE(a.get(), b.get());
+        EXPECT_EQ(2U, pool.total_resources());
+        EXPECT_EQ(2U, pool.used_resources());
+        EXPECT_EQ(0U, pool.unused_resources());
+
+        first = a.get();
+    }
+
+    EXPECT_EQ(2U, pool.total_resources());
+    EXPECT_EQ(0U, pool.used_resources());
+    EXPECT_EQ(2U, pool.unused_resources());
+
+    // Resources are reused before new ones are created
+    auto c = pool.allocate();
+    auto d = pool.allocate();
+
+    EXPECT_EQ(2U, pool.total_resources());
+    EXPECT_TRUE(c.get() == first || d.get() == first);
+}
+
+TEST(TestConcurrentResourcePool, free_unused)
+{
+    kodo::concurrent_resource_pool<dummy_resource> pool(make_resource);
+
+    {
+        // Release more resources than a thread caches, so some end up
+        // in the global free list
+        std::vector<boost::shared_ptr<dummy_resource> > resources;
+
+        for(uint32_t i = 0; i < 100; ++i)
+            resources.push_back(pool.allocate());
+    }
+
+    EXPECT_EQ(100U, pool.total_resources());
+    EXPECT_EQ(100U, pool.unused_resources());
+
+    pool.free_unused();
+
+    EXPECT_TRUE(pool.total_resources() < 100U);
+    EXPECT_EQ(pool.total_resources(), pool.unused_resources());
+
+    // Freed resources are created again on demand
+    std::vector<boost::shared_ptr<dummy_resource> > resources;
+
+    for(uint32_t i = 0; i < 100; ++i)
+        resources.push_back(pool.allocate());
+
+    EXPECT_EQ(100U, pool.total_resources());
+    EXPECT_EQ(100U, pool.used_resources());
+}
+
+TEST(TestConcurrentResourcePool, outlives_pool)
+{
+    boost::shared_ptr<dummy_resource> resource;
+
+    {
+        kodo::concurrent_resource_pool<dummy_resource> pool(make_resource);
+        resource = pool.allocate();
+    }
+
+    // The resource is still valid and is destroyed when released
+    EXPECT_EQ(0U, resource->m_users.load());
+    resource.reset();
+}
+
+TEST(TestConcurrentResourcePool, many_threads)
+{
+    kodo::concurrent_resource_pool<dummy_resource> pool(make_resource);
+
+    const uint32_t threads = 4;
+    const uint32_t iterations = 2000;
+
+    std::atomic<bool> shared(false);
+    std::vector<std::thread> workers;
+
+    // Resources are passed between the threads, so they are released
+    // by other threads than the one allocating them
+    std::vector<boost::shared_ptr<dummy_resource> > handoff(threads);
+    std::vector<std::atomic<bool> > handoff_full(threads);
+
+    for(auto& full : handoff_full)
+        full = false;
+
+    for(uint32_t t = 0; t < threads; ++t)
+    {
+        workers.push_back(std::thread([&, t]()
+        {
+            std::vector<boost::shared_ptr<dummy_resource> > held;
+
+            for(uint32_t i = 0; i < iterations; ++i)
+            {
+                auto resource = pool.allocate();
+
+                // No other thread may use the resource at the same time
+                if(++resource->m_users != 1)
+                    shared = true;
+
+                held.push_back(resource);
+
+                if(held.size() > 8)
+                {
+                    for(auto& r : held)
+                        --r->m_users;
+
+                    held.clear();
+                }
+
+                uint32_t next = (t + 1) % threads;
+
+                if(!handoff_full[next])
+                {
+                    auto r = pool.allocate();
+
+                    if(++r->m_users != 1)
+                        shared = true;
+
+                    --r->m_users;
+                    handoff[next] = r;
+                    handoff_full[next] = true;
+                }
+
+                if(handoff_full[t])
+                {
+                    handoff[t].reset();
+                    handoff_full[t] = false;
+                }
+            }
+
+            for(auto& r : held)
+                --r->m_users;
+        }));
+    }
+
+    for(auto& worker : workers)
+        worker.join();
+
+    handoff.clear();
+
+    EXPECT_FALSE(shared.load());
+    EXPECT_EQ(0U, pool.used_resources());
+    EXPECT_EQ(pool.total_resources(), pool.unused_resources());
+}
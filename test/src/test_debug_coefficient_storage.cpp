@@ -12,6 +12,7 @@
 #include <gtest/gtest.h>
 #include <fifi/binary.hpp>
 #include <fifi/binary8.hpp>
+#include <kodo/coder_arena.hpp>
 #include <kodo/coefficient_info.hpp>
 #include <kodo/coefficient_storage.hpp>
 #include <kodo/coefficient_value_access.hpp>
@@ -55,6 +56,13 @@ namespace kodo
                 (void)the_factory;
             }
 
+            template<class Factory>
+            void layout(Factory& the_factory, coder_arena& arena)
+            {
+                (void) the_factory;
+                (void) arena;
+            }
+
             template<class Factory>
             void construct(Factory& the_factory)
             {
@@ -85,6 +93,10 @@ TEST(TestDebugCoefficientStorage, api)
         stack::factory f(symbols, symbols_size);
 
         stack debug;
+        kodo::coder_arena_storage arena;
+        arena.allocate([&](kodo::coder_arena& a)
+            { debug.layout(f, a); });
+
         debug.construct(f);
         debug.initialize(f);
 
@@ -108,6 +120,10 @@ TEST(TestDebugCoefficientStorage, api)
         stack::factory f(symbols, symbols_size);
 
         stack debug;
+        kodo::coder_arena_storage arena;
+        arena.allocate([&](kodo::coder_arena& a)
+            { debug.layout(f, a); });
+
         debug.construct(f);
         debug.initialize(f);
 
@@ -0,0 +1,141 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_fast_uniform_generator.cpp Unit tests for the
+///       kodo::fast_uniform_generator
+
+#include "kodo_unit_test/coefficient_generator_helper.hpp"
+
+#include <kodo/fast_uniform_generator.hpp>
+#include <kodo/pivot_aware_generator.hpp>
+#include <kodo/xoshiro256_star_star.hpp>
+
+namespace kodo
+{
+
+    // Put dummy layers and tests classes in an anonymous namespace
+    // to avoid violations of ODF (one-definition-rule) in other
+    // translation units
+    namespace
+    {
+
+        // Fast uniform generator
+        template<class Field>
+        class fast_uniform_generator_stack :
+            public fast_uniform_generator<
+                   pivot_aware_generator<
+                   fake_codec_layer<
+                   coefficient_info<
+                   fake_symbol_storage<
+                   storage_block_info<
+                   finite_field_info<Field,
+                   final_coder_factory<
+                   fast_uniform_generator_stack<Field>
+                   > > > > > > > >
+        { };
+
+        template<class Field>
+        class fast_uniform_generator_stack_pool :
+            public fast_uniform_generator<
+                   pivot_aware_generator<
+                   fake_codec_layer<
+                   coefficient_info<
+                   fake_symbol_storage<
+                   storage_block_info<
+                   finite_field_info<Field,
+                   final_coder_factory_pool<
+                   fast_uniform_generator_stack_pool<Field>
+                   > > > > > > > >
+        { };
+    }
+}
+
+/// Run the tests typical coefficients stack
+TEST(TestCoefficientGenerator, test_fast_uniform_generator_stack)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    // API tests:
+    run_test<
+        kodo::fast_uniform_generator_stack,
+        api_generate>(symbols, symbol_size);
+
+    run_test<
+        kodo::fast_uniform_generator_stack_pool,
+        api_generate>(symbols, symbol_size);
+}
+
+/// Tests that a seed gives the same coefficients on every host, the
+/// expected bytes are the first xoshiro256** outputs for the seed
+/// written least significant byte first
+TEST(TestCoefficientGenerator, test_fast_uniform_generator_seed)
+{
+    typedef kodo::fast_uniform_generator_stack<fifi::binary8> stack_type;
+
+    // 11 coefficients cover a full 8 byte word and a partial one
+    stack_type::factory factory(11, 16);
+    auto generator = factory.build();
+
+    ASSERT_EQ(11U, generator->coefficient_vector_size());
+
+    uint8_t expected[] = { 0x16, 0xc7, 0x2e, 0x0c, 0x2e, 0x0b, 0x78,
+                           0x15, 0x7e, 0x3a, 0x11 };
+
+    std::vector<uint8_t> coefficients(generator->coefficient_vector_size());
+
+    generator->seed(42);
+    generator->generate(&coefficients[0]);
+
+    EXPECT_TRUE(std::equal(coefficients.begin(), coefficients.end(),
+                           expected));
+}
+
+/// Tests that the generator is deterministic and that different seeds
+/// give different sequences
+TEST(TestCoefficientGenerator, test_xoshiro256_star_star)
+{
+    kodo::xoshiro256_star_star a(0);
+    kodo::xoshiro256_star_star b(0);
+    kodo::xoshiro256_star_star c(1);
+
+    uint32_t equal = 0;
+
+    for(uint32_t i = 0; i < 1000; ++i)
+    {
+        uint64_t value = a();
+
+        EXPECT_EQ(value, b());
+
+        if(value == c())
+            ++equal;
+    }
+
+    EXPECT_EQ(0U, equal);
+
+    // Seeding resets the sequence
+    a.seed(1);
+    c.seed(1);
+
+    EXPECT_EQ(c(), a());
+
+    // Every bit should be set in roughly half of the values
+    std::vector<uint32_t> ones(64, 0);
+    uint32_t samples = 10000;
+
+    for(uint32_t i = 0; i < samples; ++i)
+    {
+        uint64_t value = a();
+
+        for(uint32_t bit = 0; bit < 64; ++bit)
+            ones[bit] += (value >> bit) & 1;
+    }
+
+    for(uint32_t bit = 0; bit < 64; ++bit)
+    {
+        EXPECT_GT(ones[bit], samples * 45 / 100);
+        EXPECT_LT(ones[bit], samples * 55 / 100);
+    }
+}
@@ -0,0 +1,101 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_file_decoder.cpp Unit tests for the kodo::file_decoder
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <kodo/file_decoder.hpp>
+#include <kodo/storage_encoder.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+#include <kodo/rlnc/shallow_full_rlnc_decoder.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+/// Decodes an object into a file and checks the file content
+template<class Field>
+inline void test_file_decoder(uint32_t max_symbols,
+                              uint32_t max_symbol_size,
+                              uint32_t object_size)
+{
+    typedef kodo::full_rlnc_encoder<Field> encoder_type;
+    typedef kodo::shallow_full_rlnc_decoder<Field> decoder_type;
+
+    typedef kodo::storage_encoder<encoder_type> storage_encoder_type;
+    typedef kodo::file_decoder<decoder_type> file_decoder_type;
+
+    std::string filename = "file-decoder-file";
+
+    std::vector<uint8_t> data_in = random_vector(object_size);
+
+    {
+        typename storage_encoder_type::factory encoder_factory(
+            max_symbols, max_symbol_size);
+
+        storage_encoder_type storage_encoder(
+            encoder_factory, sak::storage(data_in));
+
+        typename file_decoder_type::factory decoder_factory(
+            max_symbols, max_symbol_size);
+
+        file_decoder_type file_decoder(
+            decoder_factory, filename, object_size);
+
+        EXPECT_EQ(object_size, file_decoder.object_size());
+        EXPECT_EQ(storage_encoder.encoders(), file_decoder.decoders());
+
+        for(uint32_t i = 0; i < storage_encoder.encoders(); ++i)
+        {
+            auto encoder = storage_encoder.build(i);
+            auto decoder = file_decoder.build(i);
+
+            EXPECT_EQ(encoder->symbols(), decoder->symbols());
+            EXPECT_EQ(encoder->symbol_size(), decoder->symbol_size());
+            EXPECT_EQ(encoder->bytes_used(), decoder->bytes_used());
+
+            std::vector<uint8_t> payload(encoder->payload_size());
+
+            while(!decoder->is_complete())
+            {
+                encoder->encode(&payload[0]);
+                decoder->decode(&payload[0]);
+            }
+
+            file_decoder.release(i);
+        }
+    }
+
+    // The file is truncated to the object size once the file decoder
+    // is destroyed
+    std::ifstream file(filename, std::ios::binary);
+    ASSERT_TRUE(file.is_open());
+
+    std::vector<uint8_t> data_out(
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+
+    file.close();
+
+    EXPECT_EQ(data_in, data_out);
+
+    std::remove(filename.c_str());
+}
+
+TEST(TestFileDecoder, decode_file)
+{
+    // The blocks fill the file exactly
+    test_file_decoder<fifi::binary>(10, 100, 5000);
+    test_file_decoder<fifi::binary8>(10, 100, 5000);
+
+    // The last block is only partially filled
+    test_file_decoder<fifi::binary8>(10, 100, 5555);
+    test_file_decoder<fifi::binary16>(16, 1400, 100001);
+}
@@ -0,0 +1,129 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_final_coder_factory_pool.cpp Unit tests for the
+///       kodo::final_coder_factory_pool
+
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <kodo/rlnc/full_vector_codes.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+TEST(TestFinalCoderFactoryPool, build_with_size)
+{
+    typedef kodo::full_rlnc_encoder<fifi::binary8> encoder_type;
+
+    encoder_type::factory factory(32, 1600);
+
+    auto encoder = factory.build(10, 100);
+
+    EXPECT_EQ(10U, encoder->symbols());
+    EXPECT_EQ(100U, encoder->symbol_size());
+
+    // The factory itself is not changed
+    EXPECT_EQ(32U, factory.symbols());
+    EXPECT_EQ(1600U, factory.symbol_size());
+
+    encoder = factory.build();
+
+    EXPECT_EQ(32U, encoder->symbols());
+    EXPECT_EQ(1600U, encoder->symbol_size());
+
+    EXPECT_EQ(2U, factory.pool().total_resources());
+    EXPECT_EQ(1U, factory.pool().used_resources());
+}
+
+/// Builds, uses and releases coders from one factory pair on many
+/// threads at once
+template<class Field>
+inline void test_concurrent_build(uint32_t threads, uint32_t iterations)
+{
+    typedef kodo::full_rlnc_encoder<Field> encoder_type;
+    typedef kodo::full_rlnc_decoder<Field> decoder_type;
+
+    uint32_t max_symbols = 32;
+    uint32_t max_symbol_size = 256;
+
+    typename encoder_type::factory encoder_factory(
+        max_symbols, max_symbol_size);
+
+    typename decoder_type::factory decoder_factory(
+        max_symbols, max_symbol_size);
+
+    std::atomic<uint32_t> failures(0);
+    std::vector<std::thread> workers;
+
+    for(uint32_t t = 0; t < threads; ++t)
+    {
+        workers.push_back(std::thread([&, t]()
+        {
+            for(uint32_t i = 0; i < iterations; ++i)
+            {
+                uint32_t symbols = 1 + (t * 7 + i * 3) % max_symbols;
+                uint32_t symbol_size = 16 * (1 + (t + i) % 16);
+
+                auto encoder = encoder_factory.build(symbols, symbol_size);
+                auto decoder = decoder_factory.build(symbols, symbol_size);
+
+                if(encoder->symbols() != symbols ||
+                   decoder->symbols() != symbols ||
+                   encoder->symbol_size() != symbol_size ||
+                   decoder->symbol_size() != symbol_size)
+                {
+                    ++failures;
+                    continue;
+                }
+
+                std::vector<uint8_t> data_in =
+                    random_vector(encoder->block_size());
+
+                encoder->set_symbols(sak::storage(data_in));
+
+                std::vector<uint8_t> payload(encoder->payload_size());
+
+                while(!decoder->is_complete())
+                {
+                    encoder->encode(&payload[0]);
+                    decoder->decode(&payload[0]);
+                }
+
+                // The recoding stack must forward to its own decoder
+                std::vector<uint8_t> recoded(decoder->payload_size());
+                decoder->recode(&recoded[0]);
+
+                std::vector<uint8_t> data_out(decoder->block_size());
+                decoder->copy_symbols(sak::storage(data_out));
+
+                if(data_in != data_out)
+                    ++failures;
+            }
+        }));
+    }
+
+    for(auto& worker : workers)
+        worker.join();
+
+    EXPECT_EQ(0U, failures.load());
+
+    EXPECT_EQ(0U, encoder_factory.pool().used_resources());
+    EXPECT_EQ(0U, decoder_factory.pool().used_resources());
+
+    // The coders have been recycled rather than created per build
+    EXPECT_TRUE(encoder_factory.pool().total_resources() <
+                threads * iterations);
+}
+
+TEST(TestFinalCoderFactoryPool, concurrent_build)
+{
+    test_concurrent_build<fifi::binary>(4, 50);
+    test_concurrent_build<fifi::binary8>(4, 50);
+    test_concurrent_build<fifi::binary16>(3, 30);
+}
@@ -11,6 +11,7 @@
 #include <gtest/gtest.h>
 
 #include <fifi/binary.hpp>
+#include <fifi/binary8.hpp>
 
 #include <kodo/operations_counter.hpp>
 #include <kodo/finite_field_counter.hpp>
@@ -107,6 +108,36 @@ namespace kodo
                 (void) symbol_length;
             }
 
+            /// @copydoc layer::multiply_add_many(value_type*,
+            ///              const value_type* const*, const value_type*,
+            ///              uint32_t, uint32_t)
+            void multiply_add_many(value_type *symbol_dest,
+                                   const value_type* const* symbols_src,
+                                   const value_type *coefficients,
+                                   uint32_t count, uint32_t symbol_length)
+            {
+                (void) symbol_dest;
+                (void) symbols_src;
+                (void) coefficients;
+                (void) count;
+                (void) symbol_length;
+            }
+
+            /// @copydoc layer::multiply_subtract_many(value_type*,
+            ///              const value_type* const*, const value_type*,
+            ///              uint32_t, uint32_t)
+            void multiply_subtract_many(value_type *symbol_dest,
+                                        const value_type* const* symbols_src,
+                                        const value_type *coefficients,
+                                        uint32_t count, uint32_t symbol_length)
+            {
+                (void) symbol_dest;
+                (void) symbols_src;
+                (void) coefficients;
+                (void) count;
+                (void) symbol_length;
+            }
+
             /// @copydoc layer::invert(value_type)
             value_type invert(value_type value)
             {
@@ -191,5 +222,35 @@ TEST(TestFiniteFieldCounter, invoke_counters)
     test_values(counter, 0U);
 }
 
+/// Run the tests for the multi source operations, which should count
+/// every source as a single operation
+TEST(TestFiniteFieldCounter, invoke_many_counters)
+{
+    {
+        kodo::counter_test_stack<fifi::binary> stack;
+
+        stack.multiply_add_many(0, 0, 0, 3, 0);
+        stack.multiply_subtract_many(0, 0, 0, 4, 0);
+
+        auto counter = stack.get_operations_counter();
+
+        EXPECT_EQ(3U, counter.m_add);
+        EXPECT_EQ(4U, counter.m_subtract);
+        EXPECT_EQ(0U, counter.m_multiply_add);
+        EXPECT_EQ(0U, counter.m_multiply_subtract);
+    }
 
+    {
+        kodo::counter_test_stack<fifi::binary8> stack;
+
+        stack.multiply_add_many(0, 0, 0, 3, 0);
+        stack.multiply_subtract_many(0, 0, 0, 4, 0);
+
+        auto counter = stack.get_operations_counter();
 
+        EXPECT_EQ(0U, counter.m_add);
+        EXPECT_EQ(0U, counter.m_subtract);
+        EXPECT_EQ(3U, counter.m_multiply_add);
+        EXPECT_EQ(4U, counter.m_multiply_subtract);
+    }
+}
@@ -0,0 +1,121 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_finite_field_math.cpp Unit tests for the
+///       kodo::finite_field_math layer
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <fifi/default_field.hpp>
+#include <fifi/is_binary.hpp>
+
+#include <kodo/final_coder_factory.hpp>
+#include <kodo/finite_field_info.hpp>
+#include <kodo/finite_field_math.hpp>
+#include <kodo/storage_block_info.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+namespace kodo
+{
+
+    // Put dummy layers and tests classes in an anonymous namespace
+    // to avoid violations of ODF (one-definition-rule) in other
+    // translation units
+    namespace
+    {
+
+        template<class Field>
+        class math_stack
+            : public storage_block_info<
+                     finite_field_math<typename fifi::default_field<Field>::type,
+                     finite_field_info<Field,
+                     final_coder_factory<
+                     math_stack<Field>
+                         > > > >
+        { };
+
+    }
+}
+
+/// Checks that the multi source operations give the same result as
+/// performing the single source operations one after the other
+template<class Field>
+inline void test_many(uint32_t sources, uint32_t symbol_size)
+{
+    typedef kodo::math_stack<Field> stack_type;
+    typedef typename stack_type::value_type value_type;
+
+    typename stack_type::factory factory(sources, symbol_size);
+    auto stack = factory.build();
+
+    uint32_t length = fifi::size_to_length<Field>(symbol_size);
+
+    std::vector<std::vector<uint8_t> > data;
+    std::vector<const value_type*> symbols;
+    std::vector<value_type> coefficients;
+
+    for(uint32_t i = 0; i < sources; ++i)
+    {
+        data.push_back(random_vector(symbol_size));
+    }
+
+    for(uint32_t i = 0; i < sources; ++i)
+    {
+        symbols.push_back(reinterpret_cast<const value_type*>(&data[i][0]));
+
+        // The binary field only has one non-zero coefficient
+        value_type coefficient = fifi::is_binary<Field>::value ?
+            1 : static_cast<value_type>(1 + (rand() % 200));
+
+        coefficients.push_back(coefficient);
+    }
+
+    std::vector<uint8_t> expected = random_vector(symbol_size);
+    std::vector<uint8_t> result = expected;
+
+    value_type *expected_values =
+        reinterpret_cast<value_type*>(&expected[0]);
+
+    value_type *result_values =
+        reinterpret_cast<value_type*>(&result[0]);
+
+    for(uint32_t i = 0; i < sources; ++i)
+    {
+        stack->multiply_add(expected_values, symbols[i],
+                            coefficients[i], length);
+    }
+
+    stack->multiply_add_many(result_values, &symbols[0],
+                             &coefficients[0], sources, length);
+
+    EXPECT_EQ(expected, result);
+
+    for(uint32_t i = 0; i < sources; ++i)
+    {
+        stack->multiply_subtract(expected_values, symbols[i],
+                                 coefficients[i], length);
+    }
+
+    stack->multiply_subtract_many(result_values, &symbols[0],
+                                  &coefficients[0], sources, length);
+
+    EXPECT_EQ(expected, result);
+}
+
+/// Tests the multiply_add_many() and multiply_subtract_many() functions
+TEST(TestFiniteFieldMath, test_many)
+{
+    // Symbols spanning a partial tile and several tiles
+    test_many<fifi::binary8>(1, 100);
+    test_many<fifi::binary8>(5, 5000);
+    test_many<fifi::binary16>(5, 5000);
+
+    // The coefficients are ignored for the binary field
+    test_many<fifi::binary>(8, 5000);
+}
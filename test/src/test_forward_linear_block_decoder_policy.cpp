@@ -7,6 +7,9 @@
 ///       for the forward_linear_block_decoder_policy
 
 #include <cstdint>
+#include <vector>
+
+#include <boost/optional.hpp>
 #include <gtest/gtest.h>
 
 #include <kodo/forward_linear_block_decoder_policy.hpp>
@@ -53,5 +56,55 @@ TEST(TestForwardLinearBlockDecoderPolicy, test_functions)
     }
 }
 
+namespace
+{
+    /// Dummy coder searching the coefficients one element at a time
+    struct dummy_search_coder
+    {
+        boost::optional<uint32_t> first_nonzero_coefficient(
+            const uint8_t* coefficients, uint32_t first, uint32_t last) const
+        {
+            for(uint32_t i = first; i <= last; ++i)
+                if(coefficients[i]) return boost::optional<uint32_t>(i);
+
+            return boost::none;
+        }
+
+        boost::optional<uint32_t> last_nonzero_coefficient(
+            const uint8_t* coefficients, uint32_t first, uint32_t last) const
+        {
+            for(uint32_t i = last + 1; i --> first;)
+                if(coefficients[i]) return boost::optional<uint32_t>(i);
+
+            return boost::none;
+        }
+    };
+}
+
+/// Tests that the policy skips the zero coefficients
+TEST(TestForwardLinearBlockDecoderPolicy, test_skip_zero_coefficients)
+{
+    {
+        std::vector<uint8_t> coefficients = {0, 5, 0, 0, 7, 0, 0, 0};
+        dummy_search_coder coder;
+
+        kodo::forward_linear_block_decoder_policy policy(0, 7);
+
+        policy.skip_zero_coefficients(coder, &coefficients[0]);
+        EXPECT_EQ(policy.at_end(), false);
+        EXPECT_EQ(policy.index(), 1U);
+
+        // The policy should not move from a non-zero coefficient
+        policy.skip_zero_coefficients(coder, &coefficients[0]);
+        EXPECT_EQ(policy.index(), 1U);
 
+        policy.advance();
+        policy.skip_zero_coefficients(coder, &coefficients[0]);
+        EXPECT_EQ(policy.at_end(), false);
+        EXPECT_EQ(policy.index(), 4U);
 
+        policy.advance();
+        policy.skip_zero_coefficients(coder, &coefficients[0]);
+        EXPECT_EQ(policy.at_end(), true);
+    }
+}
@@ -0,0 +1,234 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_fused_copy_decoder.cpp Unit tests for the
+///       kodo::fused_copy_decoder
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <fifi/default_field.hpp>
+
+#include <kodo/fused_copy_decoder.hpp>
+#include <kodo/payload_decoder.hpp>
+#include <kodo/systematic_decoder.hpp>
+#include <kodo/symbol_id_decoder.hpp>
+#include <kodo/plain_symbol_id_reader.hpp>
+#include <kodo/aligned_coefficients_decoder.hpp>
+#include <kodo/backward_linear_block_decoder.hpp>
+#include <kodo/coefficient_storage.hpp>
+#include <kodo/coefficient_info.hpp>
+#include <kodo/finite_field_math.hpp>
+#include <kodo/finite_field_info.hpp>
+#include <kodo/deep_symbol_storage.hpp>
+#include <kodo/storage_bytes_used.hpp>
+#include <kodo/storage_block_info.hpp>
+#include <kodo/final_coder_factory_pool.hpp>
+#include <kodo/coefficient_value_access.hpp>
+#include <kodo/symbol_decoding_status_tracker.hpp>
+#include <kodo/symbol_decoding_status_counter.hpp>
+#include <kodo/set_systematic_off.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+namespace kodo
+{
+
+    // Put dummy layers and tests classes in an anonymous namespace
+    // to avoid violations of ODF (one-definition-rule) in other
+    // translation units
+    namespace
+    {
+
+        /// Decoder using the backward direction policy, which checks
+        /// that the layer does not depend on the search direction
+        template<class Field>
+        class fused_copy_backward_decoder
+            : public // Payload API
+                     payload_decoder<
+                     // Codec Header API
+                     systematic_decoder<
+                     symbol_id_decoder<
+                     // Symbol ID API
+                     plain_symbol_id_reader<
+                     // Decoder API
+                     aligned_coefficients_decoder<
+                     fused_copy_decoder<
+                     backward_linear_block_decoder<
+                     symbol_decoding_status_counter<
+                     symbol_decoding_status_tracker<
+                     // Coefficient Storage API
+                     coefficient_value_access<
+                     coefficient_storage<
+                     coefficient_info<
+                     // Storage API
+                     deep_symbol_storage<
+                     storage_bytes_used<
+                     storage_block_info<
+                     // Finite Field API
+                     finite_field_math<typename fifi::default_field<Field>::type,
+                     finite_field_info<Field,
+                     // Factory API
+                     final_coder_factory_pool<
+                     // Final type
+                     fused_copy_backward_decoder<Field>
+                         > > > > > > > > > > > > > > > > > >
+        { };
+
+    }
+}
+
+/// Decodes every payload from a read-only buffer with two decoders and
+/// checks that the payloads are left untouched
+template<class Encoder, class Decoder>
+inline void test_const_payload(uint32_t symbols, uint32_t symbol_size,
+                               bool systematic)
+{
+    typename Encoder::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+
+    typename Decoder::factory decoder_factory(symbols, symbol_size);
+    auto decoder_a = decoder_factory.build();
+    auto decoder_b = decoder_factory.build();
+
+    if(!systematic)
+    {
+        kodo::set_systematic_off(encoder);
+    }
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    encoder->set_symbols(sak::storage(data_in));
+
+    std::vector<uint8_t> payload(encoder->payload_size());
+
+    while(!decoder_a->is_complete())
+    {
+        encoder->encode(&payload[0]);
+
+        std::vector<uint8_t> payload_copy = payload;
+        const uint8_t *const_payload = &payload[0];
+
+        decoder_a->decode(const_payload);
+        EXPECT_EQ(payload_copy, payload);
+
+        // The second decoder sees every symbol twice, so the second
+        // symbol is never innovative
+        uint32_t rank = decoder_b->rank();
+
+        decoder_b->decode(const_payload);
+        decoder_b->decode(const_payload);
+        EXPECT_EQ(payload_copy, payload);
+
+        EXPECT_TRUE(decoder_b->rank() <= rank + 1);
+        EXPECT_EQ(decoder_a->rank(), decoder_b->rank());
+    }
+
+    EXPECT_TRUE(decoder_b->is_complete());
+
+    std::vector<uint8_t> data_out_a(decoder_a->block_size());
+    std::vector<uint8_t> data_out_b(decoder_b->block_size());
+
+    decoder_a->copy_symbols(sak::storage(data_out_a));
+    decoder_b->copy_symbols(sak::storage(data_out_b));
+
+    EXPECT_EQ(data_in, data_out_a);
+    EXPECT_EQ(data_in, data_out_b);
+}
+
+/// Alternates between the const and the mutable decode() functions
+template<class Encoder, class Decoder>
+inline void test_mixed_payload(uint32_t symbols, uint32_t symbol_size)
+{
+    typename Encoder::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+
+    typename Decoder::factory decoder_factory(symbols, symbol_size);
+    auto decoder = decoder_factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    encoder->set_symbols(sak::storage(data_in));
+
+    std::vector<uint8_t> payload(encoder->payload_size());
+
+    // Drop some of the systematic symbols so the uncoded symbols
+    // which follow are swapped with the coded symbols
+    uint32_t count = 0;
+
+    while(!decoder->is_complete())
+    {
+        encoder->encode(&payload[0]);
+
+        ++count;
+
+        if(count % 3 == 0)
+            continue;
+
+        if(count % 2 == 0)
+        {
+            decoder->decode(&payload[0]);
+        }
+        else
+        {
+            const uint8_t *const_payload = &payload[0];
+            decoder->decode(const_payload);
+        }
+
+        if(count == symbols)
+        {
+            // Restart the systematic phase to get uncoded symbols mixed
+            // with the coded ones
+            encoder->initialize(encoder_factory);
+            encoder->set_symbols(sak::storage(data_in));
+        }
+    }
+
+    std::vector<uint8_t> data_out(decoder->block_size());
+    decoder->copy_symbols(sak::storage(data_out));
+
+    EXPECT_EQ(data_in, data_out);
+}
+
+template<class Field>
+inline void test_fused_copy_decoder(uint32_t symbols, uint32_t symbol_size)
+{
+    typedef kodo::full_rlnc_encoder<Field> encoder_type;
+
+    test_const_payload<encoder_type, kodo::full_rlnc_decoder<Field> >(
+        symbols, symbol_size, true);
+
+    test_const_payload<encoder_type, kodo::full_rlnc_decoder<Field> >(
+        symbols, symbol_size, false);
+
+    test_const_payload<encoder_type,
+        kodo::fused_copy_backward_decoder<Field> >(
+            symbols, symbol_size, false);
+
+    test_mixed_payload<encoder_type, kodo::full_rlnc_decoder<Field> >(
+        symbols, symbol_size);
+
+    test_mixed_payload<encoder_type,
+        kodo::fused_copy_backward_decoder<Field> >(
+            symbols, symbol_size);
+}
+
+TEST(TestFusedCopyDecoder, const_payload)
+{
+    test_fused_copy_decoder<fifi::binary>(16, 1600);
+    test_fused_copy_decoder<fifi::binary8>(16, 1600);
+    test_fused_copy_decoder<fifi::binary16>(16, 1600);
+
+    // Symbols spanning several tiles of the fused subtraction
+    test_fused_copy_decoder<fifi::binary8>(8, 10000);
+
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_fused_copy_decoder<fifi::binary>(symbols, symbol_size);
+    test_fused_copy_decoder<fifi::binary8>(symbols, symbol_size);
+    test_fused_copy_decoder<fifi::binary16>(symbols, symbol_size);
+}
@@ -0,0 +1,148 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_grouped_linear_block_encoder.cpp Unit tests for the
+///       kodo::grouped_linear_block_encoder
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <kodo/grouped_linear_block_encoder.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+#include <kodo/set_systematic_on.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+#include "kodo_unit_test/helper_test_reuse_api.hpp"
+#include "kodo_unit_test/helper_test_basic_api.hpp"
+#include "kodo_unit_test/helper_test_systematic_api.hpp"
+
+namespace kodo
+{
+
+    // Put dummy layers and tests classes in an anonymous namespace
+    // to avoid violations of ODF (one-definition-rule) in other
+    // translation units
+    namespace
+    {
+
+        template<class Field>
+        class grouped_rlnc_encoder
+            : public // Payload Codec API
+                     payload_encoder<
+                     // Codec Header API
+                     default_on_systematic_encoder<
+                     symbol_id_encoder<
+                     // Symbol ID API
+                     plain_symbol_id_writer<
+                     // Coefficient Generator API
+                     uniform_generator<
+                     // Encoder API
+                     encode_symbol_tracker<
+                     zero_symbol_encoder<
+                     grouped_linear_block_encoder<
+                     linear_block_encoder<
+                     storage_aware_encoder<
+                     // Coefficient Storage API
+                     coefficient_value_access<
+                     coefficient_info<
+                     // Symbol Storage API
+                     deep_symbol_storage<
+                     storage_bytes_used<
+                     storage_block_info<
+                     // Finite Field API
+                     finite_field_math<typename fifi::default_field<Field>::type,
+                     finite_field_info<Field,
+                     // Factory API
+                     final_coder_factory_pool<
+                     // Final type
+                     grouped_rlnc_encoder<Field>
+                         > > > > > > > > > > > > > > > > > >
+        { };
+
+    }
+}
+
+/// Checks that the grouped encoder produces the same symbols as the
+/// linear_block_encoder
+template<class Field>
+inline void test_grouped_encode(uint32_t symbols, uint32_t symbol_size,
+                                uint32_t distinct)
+{
+    typedef kodo::grouped_rlnc_encoder<Field> grouped_type;
+    typedef kodo::full_rlnc_encoder<Field> encoder_type;
+    typedef typename grouped_type::value_type value_type;
+
+    typename grouped_type::factory grouped_factory(symbols, symbol_size);
+    auto grouped = grouped_factory.build();
+
+    typename encoder_type::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+
+    grouped->set_symbols(sak::storage(data_in));
+    encoder->set_symbols(sak::storage(data_in));
+
+    std::vector<uint8_t> coefficients(encoder->coefficient_vector_size());
+
+    value_type *c = reinterpret_cast<value_type*>(&coefficients[0]);
+
+    // Only use a few distinct coefficients (and zero) so that the
+    // groups contain several symbols
+    for(uint32_t i = 0; i < symbols; ++i)
+    {
+        uint32_t value = rand() % (distinct + 1);
+        encoder->set_coefficient_value(c, i, value);
+    }
+
+    std::vector<uint8_t> expected(symbol_size);
+    std::vector<uint8_t> actual(symbol_size);
+
+    std::vector<uint8_t> coefficients_copy = coefficients;
+    encoder->encode_symbol(&expected[0], &coefficients_copy[0]);
+
+    coefficients_copy = coefficients;
+    grouped->encode_symbol(&actual[0], &coefficients_copy[0]);
+
+    EXPECT_TRUE(expected == actual);
+}
+
+/// Tests the basic API functionality this mean basic encoding
+/// and decoding
+TEST(TestGroupedLinearBlockEncoder, test_basic_api)
+{
+    test_basic_api<kodo::grouped_rlnc_encoder,
+        kodo::full_rlnc_decoder>();
+}
+
+/// Tests that the systematic symbols produced by the encoder are
+/// handled correctly
+TEST(TestGroupedLinearBlockEncoder, test_systematic)
+{
+    test_systematic<kodo::grouped_rlnc_encoder,
+        kodo::full_rlnc_decoder>();
+}
+
+/// Tests that the encoder can be reused
+TEST(TestGroupedLinearBlockEncoder, test_reuse_api)
+{
+    test_reuse<kodo::grouped_rlnc_encoder,
+        kodo::full_rlnc_decoder>();
+}
+
+/// Tests that the encoded symbols are identical to those of the
+/// linear_block_encoder
+TEST(TestGroupedLinearBlockEncoder, test_grouped_encode)
+{
+    test_grouped_encode<fifi::binary>(100, 160, 1);
+    test_grouped_encode<fifi::binary4>(100, 160, 15);
+    test_grouped_encode<fifi::binary8>(100, 160, 4);
+    test_grouped_encode<fifi::binary8>(1000, 160, 255);
+    test_grouped_encode<fifi::binary16>(100, 160, 4);
+    test_grouped_encode<fifi::binary16>(100, 160, 65535);
+    test_grouped_encode<fifi::prime2325>(100, 160, 4);
+}
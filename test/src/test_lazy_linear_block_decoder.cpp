@@ -0,0 +1,227 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_lazy_linear_block_decoder.cpp Unit tests for the
+///       kodo::lazy_linear_block_decoder
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <kodo/lazy_linear_block_decoder.hpp>
+#include <kodo/backward_linear_block_decoder.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+#include <kodo/rlnc/full_lazy_rlnc_decoder.hpp>
+#include <kodo/set_systematic_on.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+#include "kodo_unit_test/helper_test_reuse_api.hpp"
+#include "kodo_unit_test/helper_test_basic_api.hpp"
+#include "kodo_unit_test/helper_test_initialize_api.hpp"
+#include "kodo_unit_test/helper_test_systematic_api.hpp"
+#include "kodo_unit_test/helper_test_mix_uncoded_api.hpp"
+
+namespace kodo
+{
+
+    // Put dummy layers and tests classes in an anonymous namespace
+    // to avoid violations of ODF (one-definition-rule) in other
+    // translation units
+    namespace
+    {
+
+        /// Lazy decoder using the backward linear block decoder
+        template<class Field>
+        class backward_lazy_rlnc_decoder
+            : public // Payload API
+                     payload_decoder<
+                     // Codec Header API
+                     systematic_decoder<
+                     symbol_id_decoder<
+                     // Symbol ID API
+                     plain_symbol_id_reader<
+                     // Decoder API
+                     aligned_coefficients_decoder<
+                     lazy_linear_block_decoder<
+                     backward_linear_block_decoder<
+                     symbol_decoding_status_counter<
+                     symbol_decoding_status_tracker<
+                     // Coefficient Storage API
+                     coefficient_value_access<
+                     coefficient_storage<
+                     coefficient_info<
+                     // Storage API
+                     deep_symbol_storage<
+                     storage_bytes_used<
+                     storage_block_info<
+                     // Finite Field API
+                     finite_field_math<typename fifi::default_field<Field>::type,
+                     finite_field_info<Field,
+                     // Factory API
+                     final_coder_factory_pool<
+                     // Final type
+                     backward_lazy_rlnc_decoder<Field>
+                         > > > > > > > > > > > > > > > > > >
+        { };
+
+    }
+}
+
+/// Mixes coded and uncoded symbols, where the uncoded symbols may
+/// arrive after a coded symbol has been stored in the same position
+template<class Encoder, class Decoder>
+inline void test_lazy_swap(uint32_t symbols, uint32_t symbol_size)
+{
+    typename Encoder::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+
+    typename Decoder::factory decoder_factory(symbols, symbol_size);
+    auto decoder = decoder_factory.build();
+
+    std::vector<uint8_t> payload(encoder->payload_size());
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+
+    encoder->set_symbols(sak::storage(data_in));
+    kodo::set_systematic_off(encoder);
+
+    while(!decoder->is_complete())
+    {
+        uint32_t rank = decoder->rank();
+
+        if((rand() % 2) == 0)
+        {
+            encoder->encode(&payload[0]);
+            decoder->decode(&payload[0]);
+        }
+        else
+        {
+            uint32_t symbol_index = rand() % encoder->symbols();
+            encoder->copy_symbol(symbol_index, sak::storage(payload));
+            decoder->decode_symbol(&payload[0], symbol_index);
+
+            EXPECT_TRUE(decoder->is_symbol_pivot(symbol_index));
+        }
+
+        EXPECT_TRUE(decoder->rank() >= rank);
+    }
+
+    std::vector<uint8_t> data_out(decoder->block_size(), '\0');
+    decoder->copy_symbols(sak::storage(data_out));
+
+    EXPECT_TRUE(std::equal(data_out.begin(),
+                           data_out.end(),
+                           data_in.begin()));
+}
+
+template<template <class> class Encoder, template <class> class Decoder>
+inline void test_lazy_swap(uint32_t symbols, uint32_t symbol_size)
+{
+    test_lazy_swap<Encoder<fifi::binary>, Decoder<fifi::binary> >(
+        symbols, symbol_size);
+
+    test_lazy_swap<Encoder<fifi::binary8>, Decoder<fifi::binary8> >(
+        symbols, symbol_size);
+
+    test_lazy_swap<Encoder<fifi::binary16>, Decoder<fifi::binary16> >(
+        symbols, symbol_size);
+}
+
+/// Tests the basic API functionality this mean basic encoding
+/// and decoding
+TEST(TestLazyLinearBlockDecoder, test_basic_api)
+{
+    test_basic_api<kodo::full_rlnc_encoder,
+        kodo::full_lazy_rlnc_decoder>();
+
+    test_basic_api<kodo::full_rlnc_encoder,
+        kodo::backward_lazy_rlnc_decoder>();
+
+    // Symbols larger than a single tile of the final transform
+    test_basic_api<kodo::full_rlnc_encoder,
+        kodo::full_lazy_rlnc_decoder>(64, 4000);
+}
+
+/// Tests that the decoder can be initialized and reused
+TEST(TestLazyLinearBlockDecoder, test_initialize)
+{
+    test_initialize<kodo::full_rlnc_encoder,
+        kodo::full_lazy_rlnc_decoder>();
+}
+
+/// Tests that an encoder producing systematic packets is handled
+/// correctly in the decoder.
+TEST(TestLazyLinearBlockDecoder, test_systematic)
+{
+    test_systematic<kodo::full_rlnc_encoder,
+        kodo::full_lazy_rlnc_decoder>();
+}
+
+/// Tests whether mixed un-coded and coded packets are correctly handled
+/// in the decoder.
+TEST(TestLazyLinearBlockDecoder, test_mix_uncoded)
+{
+    test_mix_uncoded<kodo::full_rlnc_encoder,
+        kodo::full_lazy_rlnc_decoder>();
+}
+
+/// Tests that uncoded symbols arriving in a position already occupied
+/// by a coded symbol are handled
+TEST(TestLazyLinearBlockDecoder, test_swap)
+{
+    test_lazy_swap<kodo::full_rlnc_encoder,
+        kodo::full_lazy_rlnc_decoder>(32, 160);
+
+    test_lazy_swap<kodo::full_rlnc_encoder,
+        kodo::backward_lazy_rlnc_decoder>(32, 160);
+}
+
+/// Tests that the decoder can be reused
+TEST(TestLazyLinearBlockDecoder, test_reuse_api)
+{
+    test_reuse<kodo::full_rlnc_encoder,
+        kodo::full_lazy_rlnc_decoder>();
+
+    test_reuse_incomplete<kodo::full_rlnc_encoder,
+        kodo::full_lazy_rlnc_decoder>();
+}
+
+/// Tests that the symbol data is not touched before the decoder is
+/// complete
+TEST(TestLazyLinearBlockDecoder, test_data_untouched)
+{
+    typedef fifi::binary8 field_type;
+
+    uint32_t symbols = 4;
+    uint32_t symbol_size = 64;
+
+    kodo::full_lazy_rlnc_decoder<field_type>::factory
+        factory(symbols, symbol_size);
+
+    auto decoder = factory.build();
+
+    std::vector<uint8_t> symbol = random_vector(symbol_size);
+    std::vector<uint8_t> coefficients(decoder->coefficient_vector_size());
+
+    fifi::set_value<field_type>(&coefficients[0], 1, 3U);
+    fifi::set_value<field_type>(&coefficients[0], 2, 7U);
+
+    decoder->decode_symbol(&symbol[0], &coefficients[0]);
+
+    EXPECT_EQ(1U, decoder->rank());
+    EXPECT_TRUE(decoder->is_symbol_seen(1));
+
+    // The received symbol is stored as is
+    EXPECT_TRUE(std::equal(symbol.begin(), symbol.end(),
+                           decoder->symbol(1)));
+
+    // The coefficients are normalized, and the transform records the
+    // scaling
+    EXPECT_EQ(1U, fifi::get_value<field_type>(
+                  decoder->coefficient_vector_data(1), 1));
+
+    EXPECT_EQ(decoder->invert(3U), fifi::get_value<field_type>(
+                  decoder->transform_vector_data(1), 1));
+}
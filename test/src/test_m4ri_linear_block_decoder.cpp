@@ -0,0 +1,120 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_m4ri_linear_block_decoder.cpp Unit tests for the
+///       kodo::m4ri_linear_block_decoder
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <kodo/m4ri_linear_block_decoder.hpp>
+#include <kodo/rlnc/full_m4ri_rlnc_decoder.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+#include <kodo/rlnc/shallow_full_m4ri_rlnc_decoder.hpp>
+#include <kodo/set_systematic_on.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+#include "kodo_unit_test/helper_test_reuse_api.hpp"
+#include "kodo_unit_test/helper_test_basic_api.hpp"
+#include "kodo_unit_test/helper_test_systematic_api.hpp"
+#include "kodo_unit_test/helper_test_mix_uncoded_api.hpp"
+
+namespace
+{
+    typedef kodo::full_rlnc_encoder<fifi::binary> encoder_type;
+    typedef kodo::full_m4ri_rlnc_decoder<fifi::binary> decoder_type;
+
+    // The generation sizes tested, both below and above the size where
+    // the tables of combinations are used
+    const uint32_t small_symbols = 16;
+    const uint32_t large_symbols = 300;
+}
+
+/// Tests the basic API functionality this mean basic encoding
+/// and decoding
+TEST(TestM4riLinearBlockDecoder, test_basic_api)
+{
+    test_basic_api<encoder_type, decoder_type>(small_symbols, 160);
+    test_basic_api<encoder_type, decoder_type>(large_symbols, 160);
+
+    // The generation size does not need to be a multiple of the group
+    // size
+    test_basic_api<encoder_type, decoder_type>(
+        decoder_type::minimum_symbols + 3, 40);
+}
+
+/// Tests that an encoder producing systematic packets is handled
+/// correctly in the decoder.
+TEST(TestM4riLinearBlockDecoder, test_systematic)
+{
+    test_systematic<encoder_type, decoder_type>(small_symbols, 160);
+    test_systematic<encoder_type, decoder_type>(large_symbols, 160);
+}
+
+/// Tests whether mixed un-coded and coded packets are correctly handled
+/// in the decoder.
+TEST(TestM4riLinearBlockDecoder, test_mix_uncoded)
+{
+    test_mix_uncoded<encoder_type, decoder_type>(small_symbols, 160);
+    test_mix_uncoded<encoder_type, decoder_type>(large_symbols, 160);
+}
+
+/// Tests that the decoder can be reused
+TEST(TestM4riLinearBlockDecoder, test_reuse_api)
+{
+    test_reuse<encoder_type, decoder_type>(small_symbols, 160);
+    test_reuse<encoder_type, decoder_type>(large_symbols, 160);
+
+    test_reuse_incomplete<encoder_type, decoder_type>(large_symbols, 160);
+}
+
+/// Tests the shallow stack
+TEST(TestM4riLinearBlockDecoder, test_shallow_stack)
+{
+    typedef kodo::shallow_full_m4ri_rlnc_decoder<fifi::binary>
+        shallow_decoder_type;
+
+    uint32_t symbols = large_symbols;
+    uint32_t symbol_size = 100;
+
+    encoder_type::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+
+    shallow_decoder_type::factory decoder_factory(symbols, symbol_size);
+    auto decoder = decoder_factory.build();
+
+    std::vector<uint8_t> payload(encoder->payload_size());
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    std::vector<uint8_t> data_out(decoder->block_size(), '\0');
+
+    encoder->set_symbols(sak::storage(data_in));
+    decoder->set_symbols(sak::storage(data_out));
+
+    kodo::set_systematic_off(encoder);
+
+    while(!decoder->is_complete())
+    {
+        encoder->encode(&payload[0]);
+        decoder->decode(&payload[0]);
+    }
+
+    // The coding matrix must be the identity
+    for(uint32_t i = 0; i < symbols; ++i)
+    {
+        auto vector_i = decoder->coefficient_vector_values(i);
+
+        for(uint32_t j = 0; j < symbols; ++j)
+        {
+            EXPECT_EQ(i == j ? 1U : 0U,
+                      decoder->coefficient_value(vector_i, j));
+        }
+    }
+
+    EXPECT_TRUE(std::equal(data_out.begin(),
+                           data_out.end(),
+                           data_in.begin()));
+}
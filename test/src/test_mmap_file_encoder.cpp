@@ -0,0 +1,102 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_mmap_file_encoder.cpp Unit tests for the
+///       kodo::mmap_file_encoder
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <kodo/mmap_file_encoder.hpp>
+#include <kodo/object_decoder.hpp>
+#include <kodo/rfc5052_partitioning_scheme.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+#include <kodo/rlnc/shallow_full_rlnc_encoder.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+/// Encodes a file with the mmap_file_encoder and checks the decoded data
+template<class Field>
+inline void test_mmap_file_encoder(uint32_t max_symbols,
+                                   uint32_t max_symbol_size,
+                                   uint32_t object_size)
+{
+    typedef kodo::shallow_full_rlnc_encoder<Field> encoder_type;
+    typedef kodo::full_rlnc_decoder<Field> decoder_type;
+
+    typedef kodo::mmap_file_encoder<encoder_type> file_encoder_type;
+    typedef kodo::object_decoder<decoder_type> object_decoder_type;
+
+    std::string filename = "mmap-encode-file";
+
+    std::vector<uint8_t> data_in = random_vector(object_size);
+
+    {
+        std::ofstream file(filename, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&data_in[0]), object_size);
+    }
+
+    {
+        typename file_encoder_type::factory encoder_factory(
+            max_symbols, max_symbol_size);
+
+        file_encoder_type file_encoder(encoder_factory, filename);
+
+        typename object_decoder_type::factory decoder_factory(
+            max_symbols, max_symbol_size);
+
+        object_decoder_type object_decoder(decoder_factory, object_size);
+
+        kodo::rfc5052_partitioning_scheme partitioning(
+            max_symbols, max_symbol_size, object_size);
+
+        EXPECT_EQ(object_size, file_encoder.object_size());
+        EXPECT_EQ(object_decoder.decoders(), file_encoder.encoders());
+
+        for(uint32_t i = 0; i < file_encoder.encoders(); ++i)
+        {
+            auto encoder = file_encoder.build(i);
+            auto decoder = object_decoder.build(i);
+
+            EXPECT_EQ(encoder->symbols(), decoder->symbols());
+            EXPECT_EQ(encoder->symbol_size(), decoder->symbol_size());
+            EXPECT_EQ(encoder->bytes_used(), decoder->bytes_used());
+
+            std::vector<uint8_t> payload(encoder->payload_size());
+
+            while(!decoder->is_complete())
+            {
+                encoder->encode(&payload[0]);
+                decoder->decode(&payload[0]);
+            }
+
+            std::vector<uint8_t> data_out(decoder->block_size());
+            decoder->copy_symbols(sak::storage(data_out));
+
+            uint32_t offset = partitioning.byte_offset(i);
+
+            EXPECT_TRUE(std::equal(data_out.begin(),
+                                   data_out.begin() + decoder->bytes_used(),
+                                   data_in.begin() + offset));
+        }
+    }
+
+    std::remove(filename.c_str());
+}
+
+TEST(TestMmapFileEncoder, encode_file)
+{
+    // The blocks fill the file exactly
+    test_mmap_file_encoder<fifi::binary>(10, 100, 5000);
+    test_mmap_file_encoder<fifi::binary8>(10, 100, 5000);
+
+    // The last block is only partially filled
+    test_mmap_file_encoder<fifi::binary8>(10, 100, 5555);
+    test_mmap_file_encoder<fifi::binary16>(16, 1400, 100001);
+}
@@ -0,0 +1,310 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_non_innovative_filter_decoder.cpp Unit tests for the
+///       kodo::non_innovative_filter_decoder
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <kodo/non_innovative_filter_decoder.hpp>
+#include <kodo/backward_linear_block_decoder.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+#include <kodo/set_systematic_on.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+#include "kodo_unit_test/helper_test_reuse_api.hpp"
+#include "kodo_unit_test/helper_test_recoding_api.hpp"
+#include "kodo_unit_test/helper_test_basic_api.hpp"
+#include "kodo_unit_test/helper_test_systematic_api.hpp"
+#include "kodo_unit_test/helper_test_mix_uncoded_api.hpp"
+
+namespace kodo
+{
+
+    // Put dummy layers and tests classes in an anonymous namespace
+    // to avoid violations of ODF (one-definition-rule) in other
+    // translation units
+    namespace
+    {
+
+        template<class Field>
+        class filter_rlnc_decoder
+            : public // Payload API
+                     payload_recoder<recoding_stack,
+                     payload_decoder<
+                     // Codec Header API
+                     systematic_decoder<
+                     symbol_id_decoder<
+                     // Symbol ID API
+                     plain_symbol_id_reader<
+                     // Decoder API
+                     aligned_coefficients_decoder<
+                     non_innovative_filter_decoder<
+                     forward_linear_block_decoder<
+                     symbol_decoding_status_counter<
+                     symbol_decoding_status_tracker<
+                     // Coefficient Storage API
+                     coefficient_value_access<
+                     coefficient_storage<
+                     coefficient_info<
+                     // Storage API
+                     deep_symbol_storage<
+                     storage_bytes_used<
+                     storage_block_info<
+                     // Finite Field API
+                     finite_field_math<typename fifi::default_field<Field>::type,
+                     finite_field_info<Field,
+                     // Factory API
+                     final_coder_factory_pool<
+                     // Final type
+                     filter_rlnc_decoder<Field>
+                         > > > > > > > > > > > > > > > > > > >
+        { };
+
+        template<class Field>
+        class filter_delayed_rlnc_decoder
+            : public // Payload API
+                     payload_decoder<
+                     // Codec Header API
+                     systematic_decoder<
+                     symbol_id_decoder<
+                     // Symbol ID API
+                     plain_symbol_id_reader<
+                     // Decoder API
+                     aligned_coefficients_decoder<
+                     non_innovative_filter_decoder<
+                     linear_block_decoder_delayed<
+                     forward_linear_block_decoder<
+                     symbol_decoding_status_counter<
+                     symbol_decoding_status_tracker<
+                     // Coefficient Storage API
+                     coefficient_value_access<
+                     coefficient_storage<
+                     coefficient_info<
+                     // Storage API
+                     deep_symbol_storage<
+                     storage_bytes_used<
+                     storage_block_info<
+                     // Finite Field API
+                     finite_field_math<typename fifi::default_field<Field>::type,
+                     finite_field_info<Field,
+                     // Factory API
+                     final_coder_factory_pool<
+                     // Final type
+                     filter_delayed_rlnc_decoder<Field>
+                         > > > > > > > > > > > > > > > > > > >
+        { };
+
+        template<class Field>
+        class filter_backward_rlnc_decoder
+            : public // Payload API
+                     payload_decoder<
+                     // Codec Header API
+                     systematic_decoder<
+                     symbol_id_decoder<
+                     // Symbol ID API
+                     plain_symbol_id_reader<
+                     // Decoder API
+                     aligned_coefficients_decoder<
+                     non_innovative_filter_decoder<
+                     backward_linear_block_decoder<
+                     symbol_decoding_status_counter<
+                     symbol_decoding_status_tracker<
+                     // Coefficient Storage API
+                     coefficient_value_access<
+                     coefficient_storage<
+                     coefficient_info<
+                     // Storage API
+                     deep_symbol_storage<
+                     storage_bytes_used<
+                     storage_block_info<
+                     // Finite Field API
+                     finite_field_math<typename fifi::default_field<Field>::type,
+                     finite_field_info<Field,
+                     // Factory API
+                     final_coder_factory_pool<
+                     // Final type
+                     filter_backward_rlnc_decoder<Field>
+                         > > > > > > > > > > > > > > > > > >
+        { };
+
+    }
+}
+
+/// Checks that symbols which are linear combinations of the symbols
+/// already received are dropped without modifying the symbol data
+template<template <class> class Decoder, class Field>
+inline void test_drop_non_innovative(uint32_t symbols, uint32_t symbol_size)
+{
+    typedef Decoder<Field> decoder_type;
+    typedef typename decoder_type::value_type value_type;
+
+    typename decoder_type::factory decoder_factory(symbols, symbol_size);
+    auto decoder = decoder_factory.build();
+
+    uint32_t vector_size = decoder->coefficient_vector_size();
+
+    // A unit vector at the first position and the sum of the first
+    // two unit vectors
+    std::vector<uint8_t> first(vector_size, 0);
+    std::vector<uint8_t> sum(vector_size, 0);
+
+    value_type *first_values = reinterpret_cast<value_type*>(&first[0]);
+    value_type *sum_values = reinterpret_cast<value_type*>(&sum[0]);
+
+    decoder->set_coefficient_value(first_values, 0, 1U);
+    decoder->set_coefficient_value(sum_values, 0, 1U);
+    decoder->set_coefficient_value(sum_values, 1, 1U);
+
+    std::vector<uint8_t> data = random_vector(symbol_size);
+    std::vector<uint8_t> coefficients = first;
+
+    decoder->decode_symbol(&data[0], &coefficients[0]);
+    EXPECT_EQ(1U, decoder->rank());
+    EXPECT_EQ(0U, decoder->non_innovative_symbols());
+
+    // The same vector again is not innovative
+    data = random_vector(symbol_size);
+    std::vector<uint8_t> data_copy = data;
+    coefficients = first;
+
+    decoder->decode_symbol(&data[0], &coefficients[0]);
+    EXPECT_EQ(1U, decoder->rank());
+    EXPECT_EQ(1U, decoder->non_innovative_symbols());
+    EXPECT_EQ(data_copy, data);
+
+    // The sum is innovative
+    coefficients = sum;
+    decoder->decode_symbol(&data[0], &coefficients[0]);
+    EXPECT_EQ(2U, decoder->rank());
+    EXPECT_EQ(1U, decoder->non_innovative_symbols());
+
+    // The sum is now not innovative
+    data = random_vector(symbol_size);
+    data_copy = data;
+    coefficients = sum;
+
+    decoder->decode_symbol(&data[0], &coefficients[0]);
+    EXPECT_EQ(2U, decoder->rank());
+    EXPECT_EQ(2U, decoder->non_innovative_symbols());
+    EXPECT_EQ(data_copy, data);
+
+    // The counter is reset when the decoder is reused
+    decoder->initialize(decoder_factory);
+    EXPECT_EQ(0U, decoder->non_innovative_symbols());
+}
+
+/// Checks that every symbol received is either innovative or counted
+template<template <class> class Decoder, class Field>
+inline void test_count_non_innovative(uint32_t symbols, uint32_t symbol_size)
+{
+    typedef kodo::full_rlnc_encoder<Field> encoder_type;
+    typedef Decoder<Field> decoder_type;
+
+    typename encoder_type::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+
+    typename decoder_type::factory decoder_factory(symbols, symbol_size);
+    auto decoder = decoder_factory.build();
+
+    std::vector<uint8_t> payload(encoder->payload_size());
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+
+    encoder->set_symbols(sak::storage(data_in));
+    kodo::set_systematic_off(encoder);
+
+    uint32_t received = 0;
+
+    while(!decoder->is_complete())
+    {
+        encoder->encode(&payload[0]);
+        decoder->decode(&payload[0]);
+        ++received;
+
+        EXPECT_EQ(received,
+                  decoder->rank() + decoder->non_innovative_symbols());
+    }
+
+    std::vector<uint8_t> data_out(decoder->block_size(), '\0');
+    decoder->copy_symbols(sak::storage(data_out));
+
+    EXPECT_EQ(data_in, data_out);
+}
+
+/// Tests the basic API functionality this mean basic encoding
+/// and decoding
+TEST(TestNonInnovativeFilterDecoder, test_basic_api)
+{
+    test_basic_api<kodo::full_rlnc_encoder,
+        kodo::filter_rlnc_decoder>();
+
+    test_basic_api<kodo::full_rlnc_encoder,
+        kodo::filter_delayed_rlnc_decoder>();
+
+    test_basic_api<kodo::full_rlnc_encoder,
+        kodo::filter_backward_rlnc_decoder>();
+}
+
+/// Tests that an encoder producing systematic packets is handled
+/// correctly in the decoder.
+TEST(TestNonInnovativeFilterDecoder, test_systematic)
+{
+    test_systematic<kodo::full_rlnc_encoder,
+        kodo::filter_rlnc_decoder>();
+}
+
+/// Tests whether mixed un-coded and coded packets are correctly handled
+/// in the decoder.
+TEST(TestNonInnovativeFilterDecoder, test_mix_uncoded)
+{
+    test_mix_uncoded<kodo::full_rlnc_encoder,
+        kodo::filter_rlnc_decoder>();
+
+    test_mix_uncoded<kodo::full_rlnc_encoder,
+        kodo::filter_delayed_rlnc_decoder>();
+}
+
+/// Tests the recoding
+TEST(TestNonInnovativeFilterDecoder, test_recoders_api)
+{
+    test_recoders<kodo::full_rlnc_encoder,
+        kodo::filter_rlnc_decoder>();
+}
+
+/// Tests that the decoder can be reused
+TEST(TestNonInnovativeFilterDecoder, test_reuse_api)
+{
+    test_reuse<kodo::full_rlnc_encoder,
+        kodo::filter_rlnc_decoder>();
+
+    test_reuse_incomplete<kodo::full_rlnc_encoder,
+        kodo::filter_rlnc_decoder>();
+}
+
+/// Tests that non-innovative symbols are dropped and counted
+TEST(TestNonInnovativeFilterDecoder, test_non_innovative)
+{
+    test_drop_non_innovative<kodo::filter_rlnc_decoder, fifi::binary>(
+        16, 100);
+    test_drop_non_innovative<kodo::filter_rlnc_decoder, fifi::binary8>(
+        16, 100);
+    test_drop_non_innovative<kodo::filter_delayed_rlnc_decoder,
+        fifi::binary16>(16, 100);
+    test_drop_non_innovative<kodo::filter_backward_rlnc_decoder,
+        fifi::binary8>(16, 100);
+
+    // The binary field produces many non-innovative symbols
+    test_count_non_innovative<kodo::filter_rlnc_decoder, fifi::binary>(
+        32, 100);
+    test_count_non_innovative<kodo::filter_delayed_rlnc_decoder,
+        fifi::binary>(32, 100);
+    test_count_non_innovative<kodo::filter_backward_rlnc_decoder,
+        fifi::binary>(32, 100);
+    test_count_non_innovative<kodo::filter_rlnc_decoder, fifi::binary8>(
+        32, 100);
+}
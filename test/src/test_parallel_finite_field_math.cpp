@@ -0,0 +1,125 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_parallel_finite_field_math.cpp Unit tests for the
+///       kodo::parallel_finite_field_math layer
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <kodo/parallel_finite_field_math.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+#include "kodo_unit_test/helper_test_basic_api.hpp"
+
+namespace kodo
+{
+
+    // Put dummy layers and tests classes in an anonymous namespace
+    // to avoid violations of ODF (one-definition-rule) in other
+    // translation units
+    namespace
+    {
+
+        template<class Field>
+        class parallel_rlnc_encoder
+            : public // Payload Codec API
+                     payload_encoder<
+                     // Codec Header API
+                     default_on_systematic_encoder<
+                     symbol_id_encoder<
+                     // Symbol ID API
+                     plain_symbol_id_writer<
+                     // Coefficient Generator API
+                     uniform_generator<
+                     // Codec API
+                     encode_symbol_tracker<
+                     zero_symbol_encoder<
+                     linear_block_encoder<
+                     storage_aware_encoder<
+                     // Coefficient Storage API
+                     coefficient_value_access<
+                     coefficient_info<
+                     // Symbol Storage API
+                     deep_symbol_storage<
+                     storage_bytes_used<
+                     storage_block_info<
+                     // Finite Field API
+                     parallel_finite_field_math<
+                     finite_field_math<typename fifi::default_field<Field>::type,
+                     finite_field_info<Field,
+                     // Factory API
+                     final_coder_factory_pool<
+                     // Final type
+                     parallel_rlnc_encoder<Field>
+                         > > > > > > > > > > > > > > > > > >
+        { };
+
+        template<class Field>
+        class parallel_rlnc_decoder
+            : public // Payload API
+                     payload_recoder<recoding_stack,
+                     payload_decoder<
+                     // Codec Header API
+                     systematic_decoder<
+                     symbol_id_decoder<
+                     // Symbol ID API
+                     plain_symbol_id_reader<
+                     // Decoder API
+                     aligned_coefficients_decoder<
+                     forward_linear_block_decoder<
+                     symbol_decoding_status_counter<
+                     symbol_decoding_status_tracker<
+                     // Coefficient Storage API
+                     coefficient_value_access<
+                     coefficient_storage<
+                     coefficient_info<
+                     // Storage API
+                     deep_symbol_storage<
+                     storage_bytes_used<
+                     storage_block_info<
+                     // Finite Field API
+                     parallel_finite_field_math<
+                     finite_field_math<typename fifi::default_field<Field>::type,
+                     finite_field_info<Field,
+                     // Factory API
+                     final_coder_factory_pool<
+                     // Final type
+                     parallel_rlnc_decoder<Field>
+                         > > > > > > > > > > > > > > > > > > >
+        { };
+
+    }
+}
+
+/// Tests encoding and decoding with symbols spanning several stripes
+/// as well as symbols processed without the thread pool
+TEST(TestParallelFiniteFieldMath, test_basic_api)
+{
+    uint32_t stripe_size =
+        kodo::parallel_rlnc_encoder<fifi::binary8>::stripe_size;
+
+    test_basic_api<kodo::parallel_rlnc_encoder,
+        kodo::parallel_rlnc_decoder>(8, 5 * stripe_size + 100);
+
+    test_basic_api<kodo::parallel_rlnc_encoder,
+        kodo::parallel_rlnc_decoder>(8, 100);
+}
+
+/// Tests that the number of worker threads can be changed
+TEST(TestParallelFiniteFieldMath, test_worker_threads)
+{
+    typedef kodo::parallel_rlnc_decoder<fifi::binary8> decoder_type;
+
+    decoder_type::factory factory(8, 1000);
+
+    factory.set_worker_threads(3);
+    EXPECT_EQ(3U, factory.worker_threads());
+
+    factory.set_worker_threads(0);
+    EXPECT_EQ(0U, factory.worker_threads());
+}
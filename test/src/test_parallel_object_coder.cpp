@@ -0,0 +1,122 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_parallel_object_coder.cpp Unit tests for the
+///       kodo::parallel_object_encoder and kodo::parallel_object_decoder
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <kodo/parallel_object_encoder.hpp>
+#include <kodo/parallel_object_decoder.hpp>
+#include <kodo/storage_reader.hpp>
+#include <kodo/object_encoder.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+/// Encodes and decodes an object with a number of workers on both sides
+template<class Field>
+inline void test_parallel_object_coder(uint32_t max_symbols,
+                                       uint32_t max_symbol_size,
+                                       uint32_t object_size,
+                                       uint32_t threads,
+                                       uint32_t window_size = 4)
+{
+    typedef kodo::full_rlnc_encoder<Field> encoder_type;
+    typedef kodo::full_rlnc_decoder<Field> decoder_type;
+
+    typedef kodo::storage_reader<encoder_type> reader_type;
+
+    typedef kodo::parallel_object_encoder<reader_type, encoder_type>
+        object_encoder_type;
+
+    typedef kodo::parallel_object_decoder<decoder_type>
+        object_decoder_type;
+
+    std::vector<uint8_t> data_in = random_vector(object_size);
+
+    object_encoder_type object_encoder(max_symbols, max_symbol_size,
+        reader_type(sak::storage(data_in)), threads,
+        object_encoder_type::default_queue_size, window_size);
+
+    object_decoder_type object_decoder(max_symbols, max_symbol_size,
+        object_size, threads);
+
+    EXPECT_EQ(object_size, object_encoder.object_size());
+    EXPECT_EQ(object_size, object_decoder.object_size());
+    EXPECT_EQ(object_encoder.encoders(), object_decoder.decoders());
+    EXPECT_EQ(object_encoder.max_payload_size(),
+              object_decoder.max_payload_size());
+    EXPECT_TRUE(object_encoder.threads() <= threads);
+    EXPECT_TRUE(object_decoder.threads() <= threads);
+
+    std::vector<uint8_t> payload(object_encoder.max_payload_size());
+
+    while(!object_decoder.is_complete())
+    {
+        uint32_t encoder_id = 0;
+        uint32_t payload_size =
+            object_encoder.encode(encoder_id, &payload[0]);
+
+        ASSERT_TRUE(payload_size > 0);
+        ASSERT_TRUE(encoder_id < object_encoder.encoders());
+
+        object_decoder.decode(encoder_id, &payload[0], payload_size);
+
+        // Let the encoder move on to the following blocks
+        if(object_decoder.is_complete(encoder_id))
+            object_encoder.finish(encoder_id);
+    }
+
+    object_decoder.wait();
+
+    EXPECT_EQ(object_decoder.decoders(), object_decoder.blocks_completed());
+
+    std::vector<uint8_t> data_out(object_size);
+    object_decoder.copy_symbols(sak::storage(data_out));
+
+    EXPECT_EQ(data_in, data_out);
+
+    // Once all blocks are finished the remaining payloads are drained
+    for(uint32_t i = 0; i < object_encoder.encoders(); ++i)
+    {
+        object_encoder.finish(i);
+    }
+
+    EXPECT_TRUE(object_encoder.is_finished());
+
+    uint32_t encoder_id = 0;
+    while(object_encoder.encode(encoder_id, &payload[0]) > 0)
+    { }
+}
+
+TEST(TestParallelObjectCoder, single_worker)
+{
+    test_parallel_object_coder<fifi::binary8>(16, 100, 10000, 1);
+}
+
+TEST(TestParallelObjectCoder, many_workers)
+{
+    test_parallel_object_coder<fifi::binary>(16, 100, 10000, 4);
+    test_parallel_object_coder<fifi::binary8>(16, 100, 10000, 4);
+    test_parallel_object_coder<fifi::binary16>(16, 100, 10001, 3);
+
+    // Hundreds of blocks
+    test_parallel_object_coder<fifi::binary8>(8, 64, 200000, 4);
+
+    // More workers than blocks
+    test_parallel_object_coder<fifi::binary8>(16, 100, 2000, 8);
+}
+
+TEST(TestParallelObjectCoder, window)
+{
+    // Every worker only holds a single block at a time, the following
+    // blocks are only encoded once the decoded ones are finished
+    test_parallel_object_coder<fifi::binary8>(16, 100, 50000, 2, 1);
+    test_parallel_object_coder<fifi::binary8>(8, 64, 200000, 4, 2);
+}
@@ -0,0 +1,152 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_prefetch_object_encoder.cpp Unit tests for the
+///       kodo::prefetch_object_encoder
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <kodo/prefetch_object_encoder.hpp>
+#include <kodo/prefetch_file_encoder.hpp>
+#include <kodo/storage_reader.hpp>
+#include <kodo/object_decoder.hpp>
+#include <kodo/rfc5052_partitioning_scheme.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+/// Decodes the block of an encoder and checks the data against the
+/// expected part of the object
+template<class Encoder, class ObjectDecoder>
+inline void check_block(Encoder &encoder, ObjectDecoder &object_decoder,
+    const kodo::rfc5052_partitioning_scheme &partitioning,
+    uint32_t block, const std::vector<uint8_t> &data_in)
+{
+    auto decoder = object_decoder.build(block);
+
+    EXPECT_EQ(encoder->symbols(), decoder->symbols());
+    EXPECT_EQ(encoder->symbol_size(), decoder->symbol_size());
+    EXPECT_EQ(encoder->bytes_used(), decoder->bytes_used());
+
+    std::vector<uint8_t> payload(encoder->payload_size());
+
+    while(!decoder->is_complete())
+    {
+        encoder->encode(&payload[0]);
+        decoder->decode(&payload[0]);
+    }
+
+    std::vector<uint8_t> data_out(decoder->block_size());
+    decoder->copy_symbols(sak::storage(data_out));
+
+    uint32_t offset = partitioning.byte_offset(block);
+
+    EXPECT_TRUE(std::equal(data_out.begin(),
+                           data_out.begin() + decoder->bytes_used(),
+                           data_in.begin() + offset));
+}
+
+/// Builds the encoders in order and out of order from a memory buffer
+TEST(TestPrefetchObjectEncoder, storage_reader)
+{
+    typedef kodo::full_rlnc_encoder<fifi::binary8> encoder_type;
+    typedef kodo::full_rlnc_decoder<fifi::binary8> decoder_type;
+
+    typedef kodo::prefetch_object_encoder<
+        kodo::storage_reader<encoder_type>, encoder_type>
+        prefetch_encoder_type;
+
+    typedef kodo::object_decoder<decoder_type> object_decoder_type;
+
+    uint32_t max_symbols = 16;
+    uint32_t max_symbol_size = 64;
+    uint32_t object_size = 10000;
+
+    std::vector<uint8_t> data_in = random_vector(object_size);
+
+    encoder_type::factory encoder_factory(max_symbols, max_symbol_size);
+    decoder_type::factory decoder_factory(max_symbols, max_symbol_size);
+
+    prefetch_encoder_type object_encoder(encoder_factory,
+        kodo::storage_reader<encoder_type>(sak::storage(data_in)));
+
+    object_decoder_type object_decoder(decoder_factory, object_size);
+
+    kodo::rfc5052_partitioning_scheme partitioning(
+        max_symbols, max_symbol_size, object_size);
+
+    EXPECT_EQ(object_decoder.decoders(), object_encoder.encoders());
+    EXPECT_EQ(object_size, object_encoder.object_size());
+    ASSERT_TRUE(object_encoder.encoders() > 3);
+
+    for(uint32_t i = 0; i < object_encoder.encoders(); ++i)
+    {
+        auto encoder = object_encoder.build(i);
+        check_block(encoder, object_decoder, partitioning, i, data_in);
+    }
+
+    // Requesting other blocks than the prefetched one
+    uint32_t order[] = { 2, 0, 0, 3, 1 };
+
+    for(uint32_t block : order)
+    {
+        auto encoder = object_encoder.build(block);
+        check_block(encoder, object_decoder, partitioning, block,
+                    data_in);
+    }
+}
+
+/// Encodes a file consisting of several blocks
+TEST(TestPrefetchObjectEncoder, file_reader)
+{
+    typedef kodo::full_rlnc_encoder<fifi::binary> encoder_type;
+    typedef kodo::full_rlnc_decoder<fifi::binary> decoder_type;
+
+    typedef kodo::prefetch_file_encoder<encoder_type> file_encoder_type;
+    typedef kodo::object_decoder<decoder_type> object_decoder_type;
+
+    std::string filename = "prefetch-encode-file";
+
+    uint32_t object_size = 5000;
+    std::vector<uint8_t> data_in = random_vector(object_size);
+
+    {
+        std::ofstream file(filename, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&data_in[0]), object_size);
+    }
+
+    uint32_t max_symbols = 10;
+    uint32_t max_symbol_size = 100;
+
+    {
+        file_encoder_type::factory encoder_factory(
+            max_symbols, max_symbol_size);
+
+        file_encoder_type file_encoder(encoder_factory, filename);
+
+        object_decoder_type::factory decoder_factory(
+            max_symbols, max_symbol_size);
+
+        object_decoder_type object_decoder(decoder_factory, object_size);
+
+        kodo::rfc5052_partitioning_scheme partitioning(
+            max_symbols, max_symbol_size, object_size);
+
+        EXPECT_EQ(object_decoder.decoders(), file_encoder.encoders());
+
+        for(uint32_t i = 0; i < file_encoder.encoders(); ++i)
+        {
+            auto encoder = file_encoder.build(i);
+            check_block(encoder, object_decoder, partitioning, i, data_in);
+        }
+    }
+
+    std::remove(filename.c_str());
+}
@@ -71,8 +71,17 @@ namespace kodo
             };
 
             template<class Factory>
-            void initialize(Factory& /*the_factory*/)
-            { }
+            void initialize(Factory& the_factory)
+            {
+                m_main_stack_pointer = the_factory.proxy_stack();
+            }
+
+            const main_stack* proxy_stack() const
+            {
+                return m_main_stack_pointer;
+            }
+
+            const main_stack* m_main_stack_pointer;
 
         };
 
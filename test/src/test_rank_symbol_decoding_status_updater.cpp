@@ -10,6 +10,7 @@
 #include <gtest/gtest.h>
 
 #include <kodo/rank_symbol_decoding_status_updater.hpp>
+#include <kodo/coder_arena.hpp>
 #include <kodo/symbol_decoding_status_tracker.hpp>
 #include <kodo/symbol_decoding_status_counter.hpp>
 
@@ -29,6 +30,13 @@ namespace kodo
         {
             typedef uint32_t rank_type;
 
+            template<class Factory>
+            void layout(Factory& the_factory, coder_arena& arena)
+            {
+                (void) the_factory;
+                (void) arena;
+            }
+
             template<class Factory>
             void construct(Factory& the_factory)
             {
@@ -113,6 +121,10 @@ TEST(TestRankSymbolDecodingStatusUpdator, api)
 
     std::vector<uint8_t> payload(10);
 
+    kodo::coder_arena_storage arena;
+    arena.allocate([&](kodo::coder_arena& a)
+        { stack.layout(factory, a); });
+
     stack.construct(factory);
     stack.initialize(factory);
     EXPECT_EQ(stack.symbols(), factory.symbols());
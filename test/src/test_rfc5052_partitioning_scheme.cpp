@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <ctime>
 #include <algorithm>
+#include <limits>
 
 #include <gtest/gtest.h>
 
@@ -86,3 +87,35 @@ TEST(TestRfc5052PartitioningScheme, partition_size)
     }
 }
 
+
+TEST(TestRfc5052PartitioningScheme, partition_large_object)
+{
+    // Objects larger than 4 GiB must be covered by the blocks without
+    // the offsets wrapping around
+    uint32_t max_symbols = 64;
+    uint32_t max_symbol_size = 1400;
+    uint64_t object_size = (uint64_t(100) << 30) + 12345;
+
+    kodo::rfc5052_partitioning_scheme partitioning(
+        max_symbols, max_symbol_size, object_size);
+
+    EXPECT_EQ(object_size, partitioning.object_size());
+    EXPECT_TRUE(partitioning.total_block_size() >= object_size);
+
+    uint64_t offset = 0;
+
+    for(uint32_t i = 0; i < partitioning.blocks(); ++i)
+    {
+        ASSERT_EQ(offset, partitioning.byte_offset(i));
+        ASSERT_TRUE(partitioning.bytes_used(i) <=
+                    partitioning.block_size(i));
+
+        offset += partitioning.bytes_used(i);
+    }
+
+    EXPECT_EQ(object_size, offset);
+
+    uint32_t last_block = partitioning.blocks() - 1;
+    EXPECT_TRUE(partitioning.byte_offset(last_block) >
+                std::numeric_limits<uint32_t>::max());
+}
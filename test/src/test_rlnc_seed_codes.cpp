@@ -24,6 +24,9 @@
 TEST(TestSeedCodes, test_basic_api)
 {
     test_basic_api<kodo::seed_rlnc_encoder,kodo::seed_rlnc_decoder>();
+
+    test_basic_api<kodo::fast_seed_rlnc_encoder,
+        kodo::fast_seed_rlnc_decoder>();
 }
 
 /// Test that the encoders and decoders initialize() function can be used
@@ -32,6 +35,9 @@ TEST(TestSeedCodes, test_basic_api)
 TEST(TestSeedCodes, test_initialize_api)
 {
     test_initialize<kodo::seed_rlnc_encoder,kodo::seed_rlnc_decoder>();
+
+    test_initialize<kodo::fast_seed_rlnc_encoder,
+        kodo::fast_seed_rlnc_decoder>();
 }
 
 /// Tests that an encoder producing systematic packets is handled
@@ -39,6 +45,9 @@ TEST(TestSeedCodes, test_initialize_api)
 TEST(TestSeedCodes, test_systematic_api)
 {
     test_systematic<kodo::seed_rlnc_encoder,kodo::seed_rlnc_decoder>();
+
+    test_systematic<kodo::fast_seed_rlnc_encoder,
+        kodo::fast_seed_rlnc_decoder>();
 }
 
 /// Tests whether mixed un-coded and coded packets are correctly handled
@@ -46,6 +55,9 @@ TEST(TestSeedCodes, test_systematic_api)
 TEST(TestSeedCodes, mix_uncoded_api)
 {
     test_mix_uncoded<kodo::seed_rlnc_encoder, kodo::seed_rlnc_decoder>();
+
+    test_mix_uncoded<kodo::fast_seed_rlnc_encoder,
+        kodo::fast_seed_rlnc_decoder>();
 }
 
 /// Tests that we can progressively set on symbol at-a-time on
@@ -53,6 +65,9 @@ TEST(TestSeedCodes, mix_uncoded_api)
 TEST(TestSeedCodes, test_reuse_api)
 {
     test_reuse<kodo::seed_rlnc_encoder, kodo::seed_rlnc_decoder>();
+
+    test_reuse<kodo::fast_seed_rlnc_encoder,
+        kodo::fast_seed_rlnc_decoder>();
 }
 
 /// Tests that we can progressively set on symbol at-a-time on
@@ -60,6 +75,9 @@ TEST(TestSeedCodes, test_reuse_api)
 TEST(TestSeedcodes, test_reuse_incomplete_api)
 {
     test_reuse_incomplete<kodo::seed_rlnc_encoder, kodo::seed_rlnc_decoder>();
+
+    test_reuse_incomplete<kodo::fast_seed_rlnc_encoder,
+        kodo::fast_seed_rlnc_decoder>();
 }
 
 
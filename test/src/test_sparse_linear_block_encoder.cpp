@@ -0,0 +1,215 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_sparse_linear_block_encoder.cpp Unit tests for the
+///       kodo::sparse_linear_block_encoder
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <kodo/sparse_linear_block_encoder.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+#include <kodo/rlnc/shallow_sparse_full_rlnc_encoder.hpp>
+#include <kodo/set_systematic_off.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+/// Checks that the list of non-zero coefficients matches the generated
+/// vector and that the listed symbols are combined in the same way as
+/// by the linear_block_encoder
+template<class Field>
+inline void test_sparse_encode(uint32_t symbols, uint32_t symbol_size,
+                               double density)
+{
+    typedef kodo::shallow_sparse_full_rlnc_encoder<Field> encoder_type;
+    typedef typename encoder_type::value_type value_type;
+
+    typename encoder_type::factory factory(symbols, symbol_size);
+    auto encoder = factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    encoder->set_symbols(sak::storage(data_in));
+    encoder->set_density(density);
+
+    std::vector<uint8_t> coefficients(encoder->coefficient_vector_size());
+    std::vector<uint32_t> indices(symbols);
+    std::vector<value_type> values(symbols);
+
+    for(uint32_t n = 0; n < 10; ++n)
+    {
+        uint32_t nonzero = encoder->generate_nonzero(
+            &coefficients[0], &indices[0], &values[0]);
+
+        const value_type *c =
+            reinterpret_cast<const value_type*>(&coefficients[0]);
+
+        uint32_t count = 0;
+
+        for(uint32_t i = 0; i < symbols; ++i)
+        {
+            value_type value = encoder->coefficient_value(c, i);
+
+            if(!value)
+                continue;
+
+            ASSERT_TRUE(count < nonzero);
+            EXPECT_EQ(i, indices[count]);
+            EXPECT_EQ(value, values[count]);
+            ++count;
+        }
+
+        EXPECT_EQ(count, nonzero);
+
+        // The vector is also encoded by the linear_block_encoder
+        std::vector<uint8_t> expected(symbol_size);
+        encoder->encode_symbol(&expected[0], &coefficients[0]);
+
+        // The destination is overwritten, so it may contain junk
+        std::vector<uint8_t> actual = random_vector(symbol_size);
+        encoder->encode_nonzero(&actual[0], &indices[0], &values[0],
+                                nonzero);
+
+        EXPECT_TRUE(expected == actual);
+    }
+}
+
+/// Checks that the symbols encoded through the payload API are the
+/// combinations described by the coefficient vector in their header
+template<class Field>
+inline void test_sparse_payload(uint32_t symbols, uint32_t symbol_size,
+                                double density)
+{
+    typedef kodo::shallow_sparse_full_rlnc_encoder<Field> encoder_type;
+
+    typename encoder_type::factory factory(symbols, symbol_size);
+    auto encoder = factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    encoder->set_symbols(sak::storage(data_in));
+    encoder->set_density(density);
+    kodo::set_systematic_off(encoder);
+
+    std::vector<uint8_t> payload(encoder->payload_size());
+
+    for(uint32_t n = 0; n < 10; ++n)
+    {
+        encoder->encode(&payload[0]);
+
+        // The payload holds the symbol data followed by the header,
+        // in which the coefficient vector follows the systematic flag
+        uint8_t *coefficients = &payload[encoder->symbol_size() +
+            sizeof(typename encoder_type::flag_type)];
+
+        std::vector<uint8_t> expected(encoder->symbol_size());
+        encoder->encode_symbol(&expected[0], coefficients);
+
+        std::vector<uint8_t> symbol(
+            payload.begin(), payload.begin() + encoder->symbol_size());
+
+        EXPECT_TRUE(expected == symbol);
+    }
+}
+
+/// Checks that the symbols encoded through the payload API are counted
+/// by the encode_symbol_tracker
+template<class Field>
+inline void test_sparse_count(uint32_t symbols, uint32_t symbol_size,
+                              double density)
+{
+    typedef kodo::shallow_sparse_full_rlnc_encoder<Field> encoder_type;
+
+    typename encoder_type::factory factory(symbols, symbol_size);
+    auto encoder = factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    encoder->set_symbols(sak::storage(data_in));
+    encoder->set_density(density);
+    kodo::set_systematic_off(encoder);
+
+    std::vector<uint8_t> payload(encoder->payload_size());
+
+    EXPECT_EQ(0U, encoder->encode_symbol_count());
+
+    for(uint32_t n = 1; n <= 10; ++n)
+    {
+        encoder->encode(&payload[0]);
+        EXPECT_EQ(n, encoder->encode_symbol_count());
+    }
+}
+
+/// Encodes and decodes a block using the sparse encoder
+template<class Field>
+inline void test_sparse_decode(uint32_t symbols, uint32_t symbol_size,
+                               double density)
+{
+    typedef kodo::shallow_sparse_full_rlnc_encoder<Field> encoder_type;
+    typedef kodo::full_rlnc_decoder<Field> decoder_type;
+
+    typename encoder_type::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+
+    typename decoder_type::factory decoder_factory(symbols, symbol_size);
+    auto decoder = decoder_factory.build();
+
+    std::vector<uint8_t> payload(encoder->payload_size());
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+
+    encoder->set_symbols(sak::storage(data_in));
+    encoder->set_density(density);
+    kodo::set_systematic_off(encoder);
+
+    while(!decoder->is_complete())
+    {
+        encoder->encode(&payload[0]);
+        decoder->decode(&payload[0]);
+    }
+
+    std::vector<uint8_t> data_out(decoder->block_size(), '\0');
+    decoder->copy_symbols(sak::storage(data_out));
+
+    EXPECT_TRUE(std::equal(data_out.begin(),
+                           data_out.end(),
+                           data_in.begin()));
+}
+
+/// Tests that the non-zero coefficients are used directly
+TEST(TestSparseLinearBlockEncoder, test_sparse_encode)
+{
+    test_sparse_encode<fifi::binary>(100, 160, 0.1);
+    test_sparse_encode<fifi::binary8>(100, 160, 0.1);
+    test_sparse_encode<fifi::binary16>(100, 160, 0.1);
+
+    test_sparse_encode<fifi::binary8>(1000, 160, 0.02);
+    test_sparse_encode<fifi::binary8>(10, 160, 1.0);
+}
+
+/// Tests that the payload API encodes from the non-zero coefficients
+TEST(TestSparseLinearBlockEncoder, test_sparse_payload)
+{
+    test_sparse_payload<fifi::binary>(100, 160, 0.1);
+    test_sparse_payload<fifi::binary8>(100, 160, 0.1);
+    test_sparse_payload<fifi::binary16>(100, 160, 0.1);
+}
+
+/// Tests that the sparse encoder counts the encoded symbols
+TEST(TestSparseLinearBlockEncoder, test_sparse_count)
+{
+    test_sparse_count<fifi::binary>(100, 160, 0.1);
+    test_sparse_count<fifi::binary8>(100, 160, 0.1);
+}
+
+/// Tests encoding and decoding with the sparse encoder
+TEST(TestSparseLinearBlockEncoder, test_sparse_decode)
+{
+    test_sparse_decode<fifi::binary>(32, 160, 0.3);
+    test_sparse_decode<fifi::binary8>(32, 160, 0.2);
+    test_sparse_decode<fifi::binary16>(32, 160, 0.2);
+
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_sparse_decode<fifi::binary8>(symbols, symbol_size, 0.5);
+}
@@ -0,0 +1,92 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_stripe_thread_pool.cpp Unit tests for the
+///       kodo::stripe_thread_pool
+
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <kodo/stripe_thread_pool.hpp>
+
+/// Checks that every stripe is executed exactly once per run
+inline void test_stripe_thread_pool(uint32_t threads)
+{
+    kodo::stripe_thread_pool pool(threads);
+    EXPECT_EQ(threads, pool.threads());
+
+    for(uint32_t stripes = 0; stripes < 50; stripes += 7)
+    {
+        std::vector<std::atomic<uint32_t> > executed(stripes);
+
+        for(auto& e : executed)
+            e = 0;
+
+        pool.run(stripes, [&](uint32_t stripe, uint32_t thread)
+            {
+                ASSERT_LT(stripe, stripes);
+                ASSERT_LE(thread, threads);
+                ++executed[stripe];
+            });
+
+        for(auto& e : executed)
+            EXPECT_EQ(1U, e.load());
+    }
+}
+
+TEST(TestStripeThreadPool, run)
+{
+    test_stripe_thread_pool(0);
+    test_stripe_thread_pool(1);
+    test_stripe_thread_pool(4);
+}
+
+/// Checks that runs from several threads on one pool all complete,
+/// also when the pool is busy with the run of another thread
+TEST(TestStripeThreadPool, concurrent_runs)
+{
+    kodo::stripe_thread_pool pool(2);
+
+    const uint32_t stripes = 16;
+    const uint32_t runs = 200;
+
+    std::vector<std::thread> users;
+    std::vector<uint32_t> incomplete(4, 0);
+
+    for(uint32_t i = 0; i < incomplete.size(); ++i)
+    {
+        users.push_back(std::thread([&, i]
+            {
+                for(uint32_t run = 0; run < runs; ++run)
+                {
+                    std::vector<std::atomic<uint32_t> > executed(stripes);
+
+                    for(auto& e : executed)
+                        e = 0;
+
+                    pool.run(stripes, [&](uint32_t stripe, uint32_t)
+                        {
+                            ++executed[stripe];
+                        });
+
+                    for(auto& e : executed)
+                    {
+                        if(e.load() != 1)
+                            ++incomplete[i];
+                    }
+                }
+            }));
+    }
+
+    for(auto& user : users)
+        user.join();
+
+    for(auto i : incomplete)
+        EXPECT_EQ(0U, i);
+}
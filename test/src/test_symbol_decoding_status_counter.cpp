@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <gtest/gtest.h>
 
+#include <kodo/coder_arena.hpp>
 #include <kodo/symbol_decoding_status_tracker.hpp>
 #include <kodo/symbol_decoding_status_counter.hpp>
 
@@ -31,6 +32,13 @@ namespace kodo
                 return m_symbols;
             }
 
+            template<class Factory>
+            void layout(Factory& the_factory, coder_arena& arena)
+            {
+                (void) the_factory;
+                (void) arena;
+            }
+
             template<class Factory>
             void construct(Factory &the_factory)
             {
@@ -90,6 +98,10 @@ TEST(TestSymbolDecodingStatusCounter, api)
     kodo::dummy_factory factory;
     factory.m_symbols = 10;
 
+    kodo::coder_arena_storage arena;
+    arena.allocate([&](kodo::coder_arena& a)
+        { stack.layout(factory, a); });
+
     stack.construct(factory);
     stack.initialize(factory);
 
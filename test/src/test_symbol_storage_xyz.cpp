@@ -839,6 +839,50 @@ namespace
 
     };
 
+    /// Tests:
+    ///   - layer::set_symbols_in_place()
+    ///   - layer::copy_symbols(const sak::mutable_storage&)
+    template<class Coder>
+    struct api_set_symbols_in_place
+    {
+
+        typedef typename Coder::factory factory_type;
+        typedef typename Coder::pointer pointer_type;
+
+        api_set_symbols_in_place(uint32_t max_symbols,
+                                 uint32_t max_symbol_size)
+            : m_factory(max_symbols, max_symbol_size)
+        { }
+
+        void run()
+        {
+            // Build with the max_symbols and max_symbol_size
+            pointer_type coder = m_factory.build();
+
+            auto vector_in = random_vector(coder->block_size());
+            auto vector_out = random_vector(coder->block_size());
+
+            sak::mutable_storage storage_out = sak::storage(vector_out);
+
+            sak::mutable_storage symbols = coder->set_symbols_in_place();
+            EXPECT_EQ(coder->block_size(), symbols.m_size);
+
+            // Write the data in place
+            sak::copy_storage(symbols, sak::storage(vector_in));
+
+            coder->copy_symbols(storage_out);
+
+            EXPECT_TRUE(sak::equal(sak::storage(vector_in),
+                                   sak::storage(vector_out)));
+        }
+
+    private:
+
+        // The factory
+        factory_type m_factory;
+
+    };
+
     /// Tests:
     ///   - layer::factory_max_symbols()
     template<class Coder>
@@ -1349,6 +1393,7 @@ namespace
         void run()
         {
             swap_symbols();
+            set_symbols_in_place();
         }
 
         /// Using:
@@ -1393,6 +1438,47 @@ namespace
                 EXPECT_FALSE(coder->is_symbol_initialized(i));
                 EXPECT_TRUE(coder->is_symbol_available(i));
             }
+        }
+
+        /// Using:
+        ///   - layer::set_symbols_in_place()
+        void set_symbols_in_place()
+        {
+            pointer_type coder = m_factory.build();
+
+            EXPECT_EQ(coder->symbols_available(), coder->symbols());
+            EXPECT_EQ(coder->symbols_initialized(), 0U);
+
+            EXPECT_TRUE(coder->is_symbols_available());
+            EXPECT_FALSE(coder->is_symbols_initialized());
+
+            coder->set_symbols_in_place();
+
+            EXPECT_EQ(coder->symbols_available(), coder->symbols());
+            EXPECT_EQ(coder->symbols_initialized(), coder->symbols());
+
+            EXPECT_TRUE(coder->is_symbols_available());
+            EXPECT_TRUE(coder->is_symbols_initialized());
+
+            for(uint32_t i = 0; i < coder->symbols(); ++i)
+            {
+                EXPECT_TRUE(coder->is_symbol_available(i));
+                EXPECT_TRUE(coder->is_symbol_initialized(i));
+            }
+
+            coder = m_factory.build();
+
+            EXPECT_EQ(coder->symbols_initialized(), 0U);
+            EXPECT_EQ(coder->symbols_available(), coder->symbols());
+
+            EXPECT_FALSE(coder->is_symbols_initialized());
+            EXPECT_TRUE(coder->is_symbols_available());
+
+            for(uint32_t i = 0; i < coder->symbols(); ++i)
+            {
+                EXPECT_FALSE(coder->is_symbol_initialized(i));
+                EXPECT_TRUE(coder->is_symbol_available(i));
+            }
 
 
         }
@@ -1583,6 +1669,8 @@ void run_deep_stack_tests()
         symbols, symbol_size);
     run_test<Stack, api_swap_symbols_data>(
         symbols, symbol_size);
+    run_test<Stack, api_set_symbols_in_place>(
+        symbols, symbol_size);
     run_test<Stack, api_factory_max_symbols>(
         symbols, symbol_size);
     run_test<Stack, api_factory_max_symbol_size>(
@@ -0,0 +1,118 @@
+// Copyright Steinwurf ApS 2011-2014.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_zero_copy_encoder.cpp Unit tests for the
+///       kodo::zero_copy_encoder
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <kodo/zero_copy_encoder.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+#include <kodo/rlnc/full_zero_copy_rlnc_encoder.hpp>
+#include <kodo/rlnc/shallow_full_zero_copy_rlnc_encoder.hpp>
+
+#include "kodo_unit_test/basic_api_test_helper.hpp"
+
+/// Encodes the data with encode_iovec() and checks that the uncoded
+/// symbols are referenced in the encoder storage
+template<class Encoder, class Decoder>
+inline void test_encode_iovec(uint32_t symbols, uint32_t symbol_size)
+{
+    typename Encoder::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+
+    typename Decoder::factory decoder_factory(symbols, symbol_size);
+    auto decoder = decoder_factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    encoder->set_symbols(sak::storage(data_in));
+
+    std::vector<uint8_t> header(encoder->header_size());
+    std::vector<uint8_t> payload(encoder->payload_size());
+
+    uint32_t systematic = 0;
+
+    while(!decoder->is_complete())
+    {
+        bool uncoded = encoder->in_systematic_phase();
+
+        const uint8_t *symbol_data = 0;
+        uint32_t bytes_used =
+            encoder->encode_iovec(&header[0], &symbol_data);
+
+        ASSERT_TRUE(symbol_data != 0);
+        EXPECT_TRUE(bytes_used <= encoder->header_size());
+
+        if(uncoded)
+        {
+            const Encoder& const_encoder = *encoder;
+            EXPECT_EQ(const_encoder.symbol(systematic), symbol_data);
+            ++systematic;
+        }
+        else
+        {
+            EXPECT_EQ(encoder->zero_copy_buffer(), symbol_data);
+        }
+
+        // Gather the two parts in the layout used by encode()
+        std::copy_n(symbol_data, encoder->symbol_size(), &payload[0]);
+        std::copy_n(&header[0], bytes_used,
+                    &payload[encoder->symbol_size()]);
+
+        decoder->decode(&payload[0]);
+    }
+
+    EXPECT_EQ(symbols, systematic);
+
+    std::vector<uint8_t> data_out(decoder->block_size(), '\0');
+    decoder->copy_symbols(sak::storage(data_out));
+
+    EXPECT_TRUE(data_in == data_out);
+
+    // The ordinary encode still copies into the payload
+    std::vector<uint8_t> other(encoder->payload_size());
+    encoder->encode(&other[0]);
+    EXPECT_EQ(&other[0], encoder->encoded_symbol());
+}
+
+/// Tests encoding with encode_iovec()
+TEST(TestZeroCopyEncoder, test_encode_iovec)
+{
+    test_encode_iovec<kodo::full_zero_copy_rlnc_encoder<fifi::binary>,
+        kodo::full_rlnc_decoder<fifi::binary> >(32, 160);
+
+    test_encode_iovec<kodo::full_zero_copy_rlnc_encoder<fifi::binary8>,
+        kodo::full_rlnc_decoder<fifi::binary8> >(32, 160);
+
+    test_encode_iovec<kodo::shallow_full_zero_copy_rlnc_encoder<fifi::binary16>,
+        kodo::full_rlnc_decoder<fifi::binary16> >(32, 160);
+
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_encode_iovec<kodo::full_zero_copy_rlnc_encoder<fifi::binary8>,
+        kodo::full_rlnc_decoder<fifi::binary8> >(symbols, symbol_size);
+}
+
+/// Tests that only the zero copy stacks reserve the buffer for the
+/// coded symbols
+TEST(TestZeroCopyEncoder, test_memory_footprint)
+{
+    uint32_t symbols = 32;
+    uint32_t symbol_size = 1600;
+
+    kodo::full_rlnc_encoder<fifi::binary8>::factory
+        encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+
+    kodo::full_zero_copy_rlnc_encoder<fifi::binary8>::factory
+        zero_copy_factory(symbols, symbol_size);
+    auto zero_copy = zero_copy_factory.build();
+
+    EXPECT_GE(zero_copy->memory_footprint(),
+              encoder->memory_footprint() + symbol_size);
+}